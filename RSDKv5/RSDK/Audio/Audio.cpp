@@ -1,5 +1,8 @@
 #include "RSDK/Core/RetroEngine.hpp"
 #include <mutex>
+#if !RETRO_USE_ORIGINAL_CODE
+#include <chrono>
+#endif
 
 using namespace RSDK;
 
@@ -16,7 +19,27 @@ stb_vorbis *vorbisInfo = NULL;
 stb_vorbis_alloc vorbisAlloc;
 
 SFXInfo RSDK::sfxList[SFX_COUNT];
-ChannelInfo RSDK::channels[CHANNEL_COUNT];
+ChannelInfo RSDK::channels[VOICE_COUNT];
+#if !RETRO_USE_ORIGINAL_CODE
+NameMap RSDK::sfxNameMap;
+
+// Decoded sfx stay in DATASET_SFX after the slot that loaded them is cleared, as long as the unused ones fit in SFX_CACHE_BUDGET,
+// so sfx shared between stages (or reloaded by the same stage) skip the file read & decode entirely
+// Each entry holds its own storage handle to the buffer (see CopyStorage), which keeps it alive through garbage collection
+// & gets it updated by defragmentation just like the slot's
+#define SFX_CACHE_COUNT  (0x100)
+#define SFX_CACHE_BUDGET (8 * 1024 * 1024) // in bytes
+
+struct SFXCacheEntry {
+    RETRO_HASH_MD5(hash);
+    float *buffer;
+    size_t length;
+    uint32 lastUsed;
+};
+
+static SFXCacheEntry sfxCache[SFX_CACHE_COUNT];
+static uint32 sfxCacheTick = 0;
+#endif
 
 char streamFilePath[0x40];
 uint8 *streamBuffer    = NULL;
@@ -32,6 +55,17 @@ float linearInterpolationLookup[LINEAR_INTERPOLATION_LOOKUP_LENGTH];
 // Serialize stream loads so only one worker touches the storage/vorbis state at a time.
 static std::mutex gStreamLoadLock;
 
+#if !RETRO_USE_ORIGINAL_CODE
+float resampleKernels[RESAMPLE_KERNEL_COUNT][RESAMPLE_PHASES][RESAMPLE_TAPS];
+int32 streamFrequency = AUDIO_FREQUENCY;
+
+int32 openedPeriod        = 0;
+int32 fallbackPeriod      = 0;
+int32 periodLimit         = AUDIO_PERIOD_MAX;
+int64 underrunWindowStart = 0;
+int32 windowUnderrunCount = 0;
+#endif
+
 #if RETRO_AUDIODEVICE_XAUDIO
 #include "XAudio/XAudioDevice.cpp"
 #elif RETRO_AUDIODEVICE_SDL2
@@ -47,6 +81,12 @@ static std::mutex gStreamLoadLock;
 uint8 AudioDeviceBase::initializedAudioChannels = false;
 uint8 AudioDeviceBase::audioState               = 0;
 uint8 AudioDeviceBase::audioFocus               = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+int32 AudioDeviceBase::outputFrequency = AUDIO_FREQUENCY;
+
+AudioDeviceStats AudioDeviceBase::stats;
+std::atomic<int32> AudioDeviceBase::targetPeriod{ AUDIO_PERIOD_DEFAULT };
+#endif
 
 void AudioDeviceBase::Release()
 {
@@ -57,14 +97,476 @@ void AudioDeviceBase::Release()
 #endif
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Picks which sfx channels get mixed this callback, ranked by priority x audibility
+// Voices that are already mixed get a little bonus so two similar voices don't keep swapping places, ties go to whichever has the
+// most left to play, same as PlaySfx preferring to replace the voice closest to finishing
+static void SelectMixedVoices()
+{
+    int32 voices[VOICE_COUNT];
+    float scores[VOICE_COUNT];
+    int32 voiceCount = 0;
+
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
+        ChannelInfo *channel = &channels[c];
+        if (channel->state != CHANNEL_SFX)
+            continue;
+
+        float audibility = channel->volume * (1.0f - 0.5f * fabsf(channel->pan));
+        float score      = (channel->priority + 1) * audibility;
+        if (channel->mixed != CHANNEL_MIX_VIRTUAL)
+            score *= 1.25f;
+
+        // insertion sort, there's only ever a handful of voices
+        int32 v = voiceCount++;
+        for (; v > 0; --v) {
+            ChannelInfo *other = &channels[voices[v - 1]];
+            if (scores[v - 1] > score
+                || (scores[v - 1] == score && other->sampleLength - other->bufferPos >= channel->sampleLength - channel->bufferPos))
+                break;
+
+            voices[v] = voices[v - 1];
+            scores[v] = scores[v - 1];
+        }
+        voices[v] = c;
+        scores[v] = score;
+    }
+
+    for (int32 v = 0; v < voiceCount; ++v) {
+        ChannelInfo *channel = &channels[voices[v]];
+        if (v < engine.mixedVoiceLimit) {
+            channel->mixed = CHANNEL_MIX_MIXED;
+        }
+        else {
+            // a voice that's never been heard can go virtual straight away, there's nothing to fade out
+            if (channel->mixed == CHANNEL_MIX_STARTED)
+                channel->mixGain = 0.0f;
+            channel->mixed = CHANNEL_MIX_VIRTUAL;
+        }
+    }
+}
+
+// Wraps or stops a voice that's played past its end, returns false if it stopped
+static bool32 WrapSfxChannel(ChannelInfo *channel)
+{
+    if (channel->bufferPos < (int32)channel->sampleLength)
+        return true;
+
+    if (channel->loop == (uint32)-1 || channel->loop >= channel->sampleLength) {
+        channel->state   = CHANNEL_IDLE;
+        channel->soundID = -1;
+        return false;
+    }
+
+    // same as subtracting the loop length until it's back in range
+    channel->bufferPos = channel->loop + (int32)((channel->bufferPos - channel->loop) % (channel->sampleLength - channel->loop));
+    return true;
+}
+
+// the largest step (in 16.16) each kernel is used for, anything past the last one uses it too
+static const int32 resampleKernelSteps[RESAMPLE_KERNEL_COUNT] = { TO_FIXED(1), TO_FIXED(5) / 4, TO_FIXED(3) / 2, TO_FIXED(2), TO_FIXED(3), TO_FIXED(4) };
+
+// Builds the sinc kernels, one row of taps per fractional position
+// A step above 1 (pitched up or downsampled) moves the source's nyquist under the output's, so each kernel's cutoff sits a little under
+// the nyquist of the largest step it's used for, that way nothing aliases & the window has room to roll off
+static void InitResampler()
+{
+    for (int32 k = 0; k < RESAMPLE_KERNEL_COUNT; ++k) {
+        float cutoff = 0.9f * TO_FIXED(1) / resampleKernelSteps[k];
+
+        for (int32 p = 0; p < RESAMPLE_PHASES; ++p) {
+            float *kernel = resampleKernels[k][p];
+            float frac    = p / (float)RESAMPLE_PHASES;
+            float sum     = 0.0f;
+
+            for (int32 t = 0; t < RESAMPLE_TAPS; ++t) {
+                float x = (t - (RESAMPLE_TAPS / 2 - 1)) - frac;
+                float u = x / (RESAMPLE_TAPS / 2);
+
+                float sinc   = x == 0.0f ? cutoff : sinf(RSDK_PI * cutoff * x) / (RSDK_PI * x);
+                float window = fabsf(u) >= 1.0f ? 0.0f : 0.42f + 0.5f * cosf(RSDK_PI * u) + 0.08f * cosf(2.0f * RSDK_PI * u); // blackman
+
+                kernel[t] = sinc * window;
+                sum += kernel[t];
+            }
+
+            // unity gain at DC for every phase
+            for (int32 t = 0; t < RESAMPLE_TAPS; ++t) kernel[t] /= sum;
+        }
+    }
+}
+
+// Returns which kernel to resample with for a step
+static inline int32 GetResampleKernelID(int32 step)
+{
+    int32 k = 0;
+    while (k < RESAMPLE_KERNEL_COUNT - 1 && step > resampleKernelSteps[k]) ++k;
+
+    return k;
+}
+
+// Returns how far a channel moves through its samples per output frame, in 16.16
+static inline int32 GetChannelStep(ChannelInfo *channel, int32 frequency)
+{
+    if (frequency == AudioDeviceBase::outputFrequency)
+        return channel->speed;
+
+    return (int32)((int64)channel->speed * frequency / AudioDeviceBase::outputFrequency);
+}
+
+// Advances a virtual voice by as many samples as mixing it would have
+static void SkipSfxChannel(ChannelInfo *channel, int32 frames, int32 step)
+{
+    int64 pos          = channel->subSample + (int64)step * frames;
+    channel->bufferPos += (int32)(pos >> 16);
+    channel->subSample = (uint32)(pos & 0xFFFF);
+    WrapSfxChannel(channel);
+}
+
+// Mixes a voice that lines up 1:1 with the output, no interpolation is needed so the inner loop vectorizes
+static void MixSfxChannelUnpitched(ChannelInfo *channel, SAMPLE_FORMAT *stream, int32 frames, float panL, float panR)
+{
+    while (frames > 0) {
+        int32 count = (int32)MIN((size_t)frames, channel->sampleLength - channel->bufferPos);
+
+        SAMPLE_FORMAT *sfxBuffer = &channel->samplePtr[channel->bufferPos];
+        for (int32 i = 0; i < count; ++i) {
+            stream[i * 2 + 0] += sfxBuffer[i] * panL;
+            stream[i * 2 + 1] += sfxBuffer[i] * panR;
+        }
+
+        stream += count * 2;
+        frames -= count;
+        channel->bufferPos += count;
+
+        if (!WrapSfxChannel(channel))
+            break;
+    }
+}
+
+// Runs the sinc kernel over the samples around the play position, taps past the end follow the loop if there is one
+static inline SAMPLE_FORMAT GetResampledSfx(ChannelInfo *channel, int32 kernelID)
+{
+    const float *kernel = resampleKernels[kernelID][channel->subSample >> (16 - RESAMPLE_PHASE_SHIFT)];
+    int32 start         = channel->bufferPos - (RESAMPLE_TAPS / 2 - 1);
+    int32 length        = (int32)channel->sampleLength;
+
+    // 4 separate sums so the taps can be done 4 at a time
+    SAMPLE_FORMAT sums[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    if (start >= 0 && start + RESAMPLE_TAPS <= length) {
+        const SAMPLE_FORMAT *samples = &channel->samplePtr[start];
+        for (int32 t = 0; t < RESAMPLE_TAPS; t += 4) {
+            for (int32 i = 0; i < 4; ++i) sums[i] += samples[t + i] * kernel[t + i];
+        }
+    }
+    else {
+        bool32 loops = channel->loop != (uint32)-1 && channel->loop < channel->sampleLength;
+        for (int32 t = 0; t < RESAMPLE_TAPS; ++t) {
+            int32 pos = start + t;
+            if (pos >= length && loops)
+                pos = channel->loop + (pos - length) % (length - channel->loop);
+
+            if (pos >= 0 && pos < length)
+                sums[t & 3] += channel->samplePtr[pos] * kernel[t];
+        }
+    }
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// Returns whether a step is close enough to 1:1 to be linearly interpolated
+static inline bool32 IsLinearStep(int32 step) { return step >= RESAMPLE_LINEAR_MIN && step <= RESAMPLE_LINEAR_MAX; }
+
+// Interpolates between the sample at the play position & the next one, which follows the loop past the end if there is one
+static inline SAMPLE_FORMAT GetLinearSfx(ChannelInfo *channel)
+{
+    int32 length       = (int32)channel->sampleLength;
+    SAMPLE_FORMAT cur  = channel->samplePtr[channel->bufferPos];
+    SAMPLE_FORMAT next = 0.0f;
+    if (channel->bufferPos + 1 < length)
+        next = channel->samplePtr[channel->bufferPos + 1];
+    else if (channel->loop != (uint32)-1 && channel->loop < channel->sampleLength)
+        next = channel->samplePtr[channel->loop];
+
+    return cur + (next - cur) * (channel->subSample * (1.0f / TO_FIXED(1)));
+}
+
+// Mixes a voice with a near 1:1 step, everything up to the last sample is done in one tight loop & only that one needs GetLinearSfx
+static void MixSfxChannelLinear(ChannelInfo *channel, SAMPLE_FORMAT *stream, int32 frames, float panL, float panR, int32 step)
+{
+    int32 length = (int32)channel->sampleLength;
+
+    while (frames > 0) {
+        int32 pos  = channel->bufferPos;
+        uint32 sub = channel->subSample;
+
+        int32 count = 1;
+        if (pos + 1 < length) {
+            // how many frames can go before the position reaches the last sample
+            count = (int32)MIN((int64)frames, ((((int64)(length - 1 - pos)) << 16) - 1 - sub) / step + 1);
+
+            const SAMPLE_FORMAT *sfxBuffer = channel->samplePtr;
+            for (int32 i = 0; i < count; ++i) {
+                SAMPLE_FORMAT sample = sfxBuffer[pos] + (sfxBuffer[pos + 1] - sfxBuffer[pos]) * (sub * (1.0f / TO_FIXED(1)));
+                stream[i * 2 + 0] += sample * panL;
+                stream[i * 2 + 1] += sample * panR;
+
+                sub += step;
+                pos += sub >> 16;
+                sub &= 0xFFFF;
+            }
+
+            channel->bufferPos = pos;
+            channel->subSample = sub;
+        }
+        else {
+            SAMPLE_FORMAT sample = GetLinearSfx(channel);
+            stream[0] += sample * panL;
+            stream[1] += sample * panR;
+
+            sub += step;
+            channel->bufferPos += sub >> 16;
+            channel->subSample = sub & 0xFFFF;
+        }
+
+        stream += count * 2;
+        frames -= count;
+
+        if (!WrapSfxChannel(channel))
+            break;
+    }
+}
+
+// Mixes a voice that needs resampling or is being swapped in or out (fading it towards its new gain)
+static void MixSfxChannelResampled(ChannelInfo *channel, SAMPLE_FORMAT *stream, int32 frames, float panL, float panR, int32 step)
+{
+    float target   = channel->mixed != CHANNEL_MIX_VIRTUAL ? 1.0f : 0.0f;
+    float gainStep = channel->mixed != CHANNEL_MIX_VIRTUAL ? 1.0f / VOICE_RAMP_LENGTH : -1.0f / VOICE_RAMP_LENGTH;
+    int32 kernelID = GetResampleKernelID(step);
+    bool32 linear  = IsLinearStep(step);
+
+    for (int32 f = 0; f < frames; ++f) {
+        if (channel->mixGain == target) {
+            // done fading, the rest can take the faster paths
+            if (target == 0.0f) {
+                SkipSfxChannel(channel, frames - f, step);
+                return;
+            }
+            else if (step == TO_FIXED(1) && !channel->subSample) {
+                MixSfxChannelUnpitched(channel, stream, frames - f, panL, panR);
+                return;
+            }
+            else if (linear) {
+                MixSfxChannelLinear(channel, stream, frames - f, panL, panR, step);
+                return;
+            }
+        }
+        else {
+            channel->mixGain += gainStep;
+            if (gainStep > 0.0f ? channel->mixGain > target : channel->mixGain < target)
+                channel->mixGain = target;
+        }
+
+        SAMPLE_FORMAT sample;
+        if (step == TO_FIXED(1) && !channel->subSample)
+            sample = channel->samplePtr[channel->bufferPos];
+        else if (linear)
+            sample = GetLinearSfx(channel);
+        else
+            sample = GetResampledSfx(channel, kernelID);
+        sample *= channel->mixGain;
+
+        stream[0] += sample * panL;
+        stream[1] += sample * panR;
+        stream += 2;
+
+        uint32 pos = channel->subSample + step;
+        channel->bufferPos += pos >> 16;
+        channel->subSample = pos & 0xFFFF;
+
+        if (!WrapSfxChannel(channel))
+            break;
+    }
+}
+
+// Mixes (or skips) a voice through whichever path suits it
+static void MixSfxChannel(ChannelInfo *channel, SAMPLE_FORMAT *stream, int32 frames, float panL, float panR)
+{
+    if (!WrapSfxChannel(channel))
+        return;
+
+    int32 step = GetChannelStep(channel, AUDIO_FREQUENCY);
+    // lining back up with the output drops whatever fraction was left over, it's less than a sample
+    if (step == TO_FIXED(1))
+        channel->subSample = 0;
+
+    float gain = channel->mixed == CHANNEL_MIX_VIRTUAL ? 0.0f : 1.0f;
+    if (channel->mixGain == gain && gain == 0.0f)
+        SkipSfxChannel(channel, frames, step);
+    else if (channel->mixGain == gain && step == TO_FIXED(1))
+        MixSfxChannelUnpitched(channel, stream, frames, panL, panR);
+    else if (channel->mixGain == gain && IsLinearStep(step))
+        MixSfxChannelLinear(channel, stream, frames, panL, panR, step);
+    else
+        MixSfxChannelResampled(channel, stream, frames, panL, panR, step);
+}
+
+// Mixes a stream that doesn't line up 1:1 with the output
+// The kernel is centered a few frames behind the play position since the frames after it may not have been decoded yet
+static void MixStreamChannelResampled(ChannelInfo *channel, SAMPLE_FORMAT *stream, SAMPLE_FORMAT *streamEnd, float panL, float panR, int32 step)
+{
+    int32 kernelID = GetResampleKernelID(step);
+
+    while (stream < streamEnd) {
+        const float *kernel = resampleKernels[kernelID][channel->subSample >> (16 - RESAMPLE_PHASE_SHIFT)];
+        int32 start         = (int32)(channel->bufferPos / 2) - (RESAMPLE_TAPS - 1);
+
+        SAMPLE_FORMAT sampleL = 0.0f, sampleR = 0.0f;
+        if (start >= 0) {
+            const SAMPLE_FORMAT *samples = &channel->samplePtr[start * 2];
+            for (int32 t = 0; t < RESAMPLE_TAPS; ++t) {
+                sampleL += samples[t * 2 + 0] * kernel[t];
+                sampleR += samples[t * 2 + 1] * kernel[t];
+            }
+        }
+        else {
+            for (int32 t = 0; t < RESAMPLE_TAPS; ++t) {
+                int32 frame                  = start + t;
+                const SAMPLE_FORMAT *samples = frame >= 0 ? &channel->samplePtr[frame * 2] : &channel->streamHistory[(RESAMPLE_TAPS + frame) * 2];
+
+                sampleL += samples[0] * kernel[t];
+                sampleR += samples[1] * kernel[t];
+            }
+        }
+
+        stream[0] += sampleL * panL;
+        stream[1] += sampleR * panR;
+        stream += 2;
+
+        uint32 pos         = channel->subSample + step;
+        channel->subSample = pos & 0xFFFF;
+        channel->bufferPos += (pos >> 16) * 2;
+
+        if (channel->bufferPos >= (int32)channel->sampleLength) {
+            memcpy(channel->streamHistory, &channel->samplePtr[channel->sampleLength - RESAMPLE_TAPS * 2], sizeof(channel->streamHistory));
+            channel->bufferPos -= (uint32)channel->sampleLength;
+
+            UpdateStreamBuffer(channel);
+        }
+    }
+}
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Returns a timestamp in microseconds
+static inline int64 GetAudioTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AudioDeviceBase::ResetAudioStats(int32 period, int32 latency)
+{
+    openedPeriod = targetPeriod.load(std::memory_order_relaxed);
+
+    stats.period           = period;
+    stats.latency          = (int32)((int64)latency * 1000000 / outputFrequency);
+    stats.budget           = (int32)((int64)period * 1000000 / outputFrequency);
+    stats.callbackTime     = 0;
+    stats.peakCallbackTime = 0;
+    stats.callbackCount    = 0;
+
+    underrunWindowStart = 0;
+    windowUnderrunCount = 0;
+}
+
+void AudioDeviceBase::ReportUnderrun(uint32 count)
+{
+    stats.underrunCount += count;
+
+    int64 now = GetAudioTimestamp();
+    if (now - underrunWindowStart > AUDIO_UNDERRUN_WINDOW) {
+        underrunWindowStart = now;
+        windowUnderrunCount = 0;
+    }
+
+    windowUnderrunCount += count;
+    if (windowUnderrunCount >= AUDIO_UNDERRUN_LIMIT && openedPeriod < periodLimit && targetPeriod.load() == openedPeriod) {
+        // the device picks the new period up on the next FrameInit
+        targetPeriod.store(MIN(openedPeriod * 2, periodLimit));
+        stats.periodGrowCount++;
+
+        windowUnderrunCount = 0;
+    }
+}
+
+bool32 AudioDeviceBase::CheckPeriodChange()
+{
+    // openedPeriod only changes once the device has actually reopened with it (in ResetAudioStats)
+    if (!openedPeriod || targetPeriod.load() == openedPeriod)
+        return false;
+
+    fallbackPeriod = openedPeriod;
+    return true;
+}
+
+void AudioDeviceBase::RevertPeriodChange()
+{
+    PrintLog(PRINT_NORMAL, "Unable to reopen the audio device with a period of %d frames, going back to %d", targetPeriod.load(), fallbackPeriod);
+
+    // anything bigger is just going to fail again
+    periodLimit  = fallbackPeriod;
+    openedPeriod = fallbackPeriod;
+    targetPeriod.store(fallbackPeriod);
+}
+
+void AudioDeviceBase::CopyAudioStats(AudioDeviceStats *dst, AudioDeviceStats *src)
+{
+    dst->period           = src->period.load();
+    dst->latency          = src->latency.load();
+    dst->budget           = src->budget.load();
+    dst->callbackTime     = src->callbackTime.load();
+    dst->peakCallbackTime = src->peakCallbackTime.load();
+    dst->callbackCount    = src->callbackCount.load();
+    dst->underrunCount    = src->underrunCount.load();
+    dst->periodGrowCount  = src->periodGrowCount.load();
+}
+
+// Times a callback, mixing for longer than the device had queued up means it ran dry in the meantime, which counts as an underrun
+// a callback that's only slower than its own frames last just eats into what's queued, anything the device misses on its own end
+// (or a gap in the callbacks, like the device being paused) is left to the devices that can report it
+static void UpdateAudioStats(int32 frames, int64 start)
+{
+    AudioDeviceStats *stats = &AudioDeviceBase::stats;
+
+    int32 time              = (int32)(GetAudioTimestamp() - start);
+    int32 callbackTime      = stats->callbackTime;
+    stats->budget           = (int32)((int64)frames * 1000000 / AudioDeviceBase::outputFrequency);
+    stats->callbackTime     = stats->callbackCount ? callbackTime + (time - callbackTime) / 16 : time;
+    stats->peakCallbackTime = MAX(stats->peakCallbackTime.load(), time);
+    stats->callbackCount++;
+
+    if (stats->latency && time > stats->latency)
+        AudioDeviceBase::ReportUnderrun();
+}
+#endif
+
 void AudioDeviceBase::ProcessAudioMixing(void *stream, int32 length)
 {
+    PROFILE_ZONE(PROFILE_AUDIO);
+#if !RETRO_USE_ORIGINAL_CODE
+    int64 callbackStart = GetAudioTimestamp();
+#endif
+
     SAMPLE_FORMAT *streamF    = (SAMPLE_FORMAT *)stream;
     SAMPLE_FORMAT *streamEndF = ((SAMPLE_FORMAT *)stream) + length;
 
     memset(stream, 0, length * sizeof(SAMPLE_FORMAT));
 
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+#if !RETRO_USE_ORIGINAL_CODE
+    SelectMixedVoices();
+#endif
+
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         ChannelInfo *channel = &channels[c];
 
         switch (channel->state) {
@@ -83,6 +585,13 @@ void AudioDeviceBase::ProcessAudioMixing(void *stream, int32 length)
                 float panL = volL * engine.soundFXVolume;
                 float panR = volR * engine.soundFXVolume;
 
+#if !RETRO_USE_ORIGINAL_CODE
+                if (channel->samplePtr) {
+                    MixSfxChannel(channel, streamF, (int32)(streamEndF - streamF) / 2, panL, panR);
+                    break;
+                }
+
+#endif
                 uint32 speedPercent       = 0;
                 SAMPLE_FORMAT *curStreamF = streamF;
                 while (curStreamF < streamEndF && streamF < streamEndF) {
@@ -135,6 +644,14 @@ void AudioDeviceBase::ProcessAudioMixing(void *stream, int32 length)
                 float panL = volL * engine.streamVolume;
                 float panR = volR * engine.streamVolume;
 
+#if !RETRO_USE_ORIGINAL_CODE
+                int32 step = GetChannelStep(channel, streamFrequency);
+                if (step != TO_FIXED(1)) {
+                    MixStreamChannelResampled(channel, streamF, streamEndF, panL, panR, step);
+                    break;
+                }
+#endif
+
                 uint32 speedPercent       = 0;
                 SAMPLE_FORMAT *curStreamF = streamF;
                 while (curStreamF < streamEndF && streamF < streamEndF) {
@@ -163,11 +680,15 @@ void AudioDeviceBase::ProcessAudioMixing(void *stream, int32 length)
             case CHANNEL_LOADING_STREAM: break;
         }
     }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    UpdateAudioStats(length / AUDIO_CHANNELS, callbackStart);
+#endif
 }
 
 void AudioDeviceBase::InitAudioChannels()
 {
-    for (int32 i = 0; i < CHANNEL_COUNT; ++i) {
+    for (int32 i = 0; i < VOICE_COUNT; ++i) {
         channels[i].soundID = -1;
         channels[i].state   = CHANNEL_IDLE;
     }
@@ -182,6 +703,11 @@ void AudioDeviceBase::InitAudioChannels()
     sfxList[SFX_COUNT - 1].length             = MIX_BUFFER_SIZE;
     AllocateStorage((void **)&sfxList[SFX_COUNT - 1].buffer, MIX_BUFFER_SIZE * sizeof(SAMPLE_FORMAT), DATASET_MUS, false);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    targetPeriod = CLAMP(engine.audioPeriod, AUDIO_PERIOD_MIN, AUDIO_PERIOD_MAX);
+    InitResampler();
+#endif
+
     initializedAudioChannels = true;
 }
 
@@ -240,6 +766,9 @@ void RSDK::LoadStream(ChannelInfo *channel)
 
             vorbisInfo = stb_vorbis_open_memory(streamBuffer, streamBufferSize, NULL, &vorbisAlloc);
             if (vorbisInfo) {
+#if !RETRO_USE_ORIGINAL_CODE
+                streamFrequency = vorbisInfo->sample_rate;
+#endif
                 if (streamStartPos)
                     stb_vorbis_seek(vorbisInfo, streamStartPos);
                 UpdateStreamBuffer(channel);
@@ -295,6 +824,10 @@ int32 RSDK::PlayStream(const char *filename, uint32 slot, uint32 startPos, uint3
     channel->samplePtr    = sfxList[SFX_COUNT - 1].buffer;
     channel->bufferPos    = 0;
     channel->speed        = TO_FIXED(1);
+#if !RETRO_USE_ORIGINAL_CODE
+    channel->subSample = 0;
+    memset(channel->streamHistory, 0, sizeof(channel->streamHistory));
+#endif
 
     sprintf_s(streamFilePath, sizeof(streamFilePath), "Data/Music/%s", filename);
     streamStartPos  = startPos;
@@ -310,6 +843,149 @@ int32 RSDK::PlayStream(const char *filename, uint32 slot, uint32 startPos, uint3
 #define WAV_SIG_HEADER (0x46464952) // RIFF
 #define WAV_SIG_DATA   (0x61746164) // data
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Converts the sample data to F32 format, the same way the per-sample reads did but a chunk at a time
+static void DecodeSfxSamples(FileInfo *info, float *buffer, uint32 length, uint16 sampleBits)
+{
+    uint8 chunk[0x1000];
+    uint32 sampleSize = sampleBits == 8 ? 1 : 2;
+
+    uint32 s = 0;
+    while (s < length) {
+        uint32 count = MIN(length - s, (uint32)sizeof(chunk) / sampleSize);
+        uint32 read  = (uint32)ReadBytes(info, chunk, count * sampleSize) / sampleSize;
+        if (!read)
+            break;
+
+        if (sampleBits == 8) {
+            // 8-bit sample. Convert from U8 to S8, and then from S8 to F32.
+            for (uint32 i = 0; i < read; ++i) *buffer++ = (chunk[i] - 0x80) / (float)0x80;
+        }
+        else {
+            // 16-bit sample. Convert from S16 (little endian) to F32.
+            for (uint32 i = 0; i < read; ++i) {
+                int32 sample = (int16)(chunk[i * 2] | (chunk[i * 2 + 1] << 8));
+                *buffer++    = (sample / (float)0x8000) * 0.75f;
+            }
+        }
+
+        s += read;
+    }
+
+    // anything past the end of the file reads as zeroes, same as the per-sample reads
+    float pad = sampleBits == 8 ? -0x80 / (float)0x80 : 0.0f;
+    for (; s < length; ++s) *buffer++ = pad;
+}
+
+// Returns true if the sfx buffer is still referenced by a loaded sfx
+static bool32 SfxCacheEntryInUse(SFXCacheEntry *entry)
+{
+    for (int32 s = 0; s < SFX_COUNT - 1; ++s) {
+        if (sfxList[s].scope != SCOPE_NONE && sfxList[s].buffer == entry->buffer)
+            return true;
+    }
+
+    return false;
+}
+
+// Drops the cache's handle, the storage itself is freed by the next garbage collection if nothing else uses it
+static void RemoveSfxCacheEntry(SFXCacheEntry *entry)
+{
+    MEM_ZERO(*entry);
+}
+
+// Points the slot at an already decoded copy of the sfx if there is one
+static bool32 LoadCachedSfx(uint8 slot, uint32 *hash, uint8 plays, uint8 scope)
+{
+    for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) {
+        SFXCacheEntry *entry = &sfxCache[e];
+        if (entry->buffer && HASH_MATCH_MD5(entry->hash, hash)) {
+            HASH_COPY_MD5(sfxList[slot].hash, hash);
+            sfxList[slot].scope              = scope;
+            sfxList[slot].maxConcurrentPlays = plays;
+            sfxList[slot].length             = entry->length;
+            CopyStorage((uint32 **)&sfxList[slot].buffer, (uint32 **)&entry->buffer);
+
+            entry->lastUsed = ++sfxCacheTick;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Adds a freshly decoded sfx to the cache, replacing the least recently used entry nothing's using if it's full
+static void AddSfxToCache(uint8 slot)
+{
+    SFXCacheEntry *target = NULL;
+    for (int32 e = 0; e < SFX_CACHE_COUNT && !target; ++e) {
+        if (!sfxCache[e].buffer)
+            target = &sfxCache[e];
+    }
+
+    if (!target) {
+        for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) {
+            SFXCacheEntry *entry = &sfxCache[e];
+            if ((!target || entry->lastUsed < target->lastUsed) && !SfxCacheEntryInUse(entry))
+                target = entry;
+        }
+
+        if (!target)
+            return;
+    }
+
+    HASH_COPY_MD5(target->hash, sfxList[slot].hash);
+    target->length   = sfxList[slot].length;
+    target->lastUsed = ++sfxCacheTick;
+    CopyStorage((uint32 **)&target->buffer, (uint32 **)&sfxList[slot].buffer);
+}
+
+// Evicts the least recently used sfx nothing's using, returns false if there wasn't one
+static bool32 EvictOldestSfxCacheEntry()
+{
+    SFXCacheEntry *oldest = NULL;
+    for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) {
+        SFXCacheEntry *entry = &sfxCache[e];
+        if (entry->buffer && (!oldest || entry->lastUsed < oldest->lastUsed) && !SfxCacheEntryInUse(entry))
+            oldest = entry;
+    }
+
+    if (!oldest)
+        return false;
+
+    RemoveSfxCacheEntry(oldest);
+    return true;
+}
+
+// Evicts the least recently used sfx nothing's using until the rest fit in SFX_CACHE_BUDGET
+static void TrimSfxCache()
+{
+    bool32 inUse[SFX_CACHE_COUNT];
+    size_t unusedSize = 0;
+    for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) {
+        inUse[e] = sfxCache[e].buffer && SfxCacheEntryInUse(&sfxCache[e]);
+        if (sfxCache[e].buffer && !inUse[e])
+            unusedSize += sfxCache[e].length * sizeof(float);
+    }
+
+    while (unusedSize > SFX_CACHE_BUDGET) {
+        int32 oldest = -1;
+        for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) {
+            if (sfxCache[e].buffer && !inUse[e] && (oldest < 0 || sfxCache[e].lastUsed < sfxCache[oldest].lastUsed))
+                oldest = e;
+        }
+
+        unusedSize -= sfxCache[oldest].length * sizeof(float);
+        RemoveSfxCacheEntry(&sfxCache[oldest]);
+    }
+}
+
+void RSDK::ClearSfxCache()
+{
+    for (int32 e = 0; e < SFX_CACHE_COUNT; ++e) RemoveSfxCacheEntry(&sfxCache[e]);
+}
+#endif
+
 void RSDK::LoadSfxToSlot(char *filename, uint8 slot, uint8 plays, uint8 scope)
 {
     FileInfo info;
@@ -321,6 +997,11 @@ void RSDK::LoadSfxToSlot(char *filename, uint8 slot, uint8 plays, uint8 scope)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(filename, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (LoadCachedSfx(slot, hash, plays, scope))
+        return;
+#endif
+
     if (LoadFile(&info, fullFilePath, FMODE_RB)) {
         HASH_COPY_MD5(sfxList[slot].hash, hash);
         sfxList[slot].scope              = scope;
@@ -384,10 +1065,26 @@ void RSDK::LoadSfxToSlot(char *filename, uint8 slot, uint8 plays, uint8 scope)
                     length /= 2;
 
                 AllocateStorage((void **)&sfxList[slot].buffer, sizeof(float) * length, DATASET_SFX, false);
+#if !RETRO_USE_ORIGINAL_CODE
+                // the cache's handles keep its sfx alive through garbage collection, so if it's what filled DATASET_SFX up,
+                // give up the sfx nothing's using (oldest first) until there's room
+                while (!sfxList[slot].buffer && EvictOldestSfxCacheEntry())
+                    AllocateStorage((void **)&sfxList[slot].buffer, sizeof(float) * length, DATASET_SFX, false);
+#endif
                 sfxList[slot].length = length;
 
                 // Convert the sample data to F32 format
                 float *buffer = (float *)sfxList[slot].buffer;
+#if !RETRO_USE_ORIGINAL_CODE
+                if (!buffer) {
+                    PrintLog(PRINT_ERROR, "Not enough sfx storage for sfx: %s", filename);
+                    sfxList[slot].length = 0;
+                }
+                else {
+                    DecodeSfxSamples(&info, buffer, length, sampleBits);
+                    AddSfxToCache(slot);
+                }
+#else
                 if (sampleBits == 8) {
                     // 8-bit sample. Convert from U8 to S8, and then from S8 to F32.
                     for (int32 s = 0; s < length; ++s) {
@@ -408,6 +1105,7 @@ void RSDK::LoadSfxToSlot(char *filename, uint8 slot, uint8 plays, uint8 scope)
                         *buffer++ = (sample / (float)0x8000) * 0.75f;
                     }
                 }
+#endif
             }
 #if !RETRO_USE_ORIGINAL_CODE
             else {
@@ -479,6 +1177,9 @@ int32 RSDK::PlaySfx(uint16 sfx, uint32 loopPoint, uint32 priority)
 
     // as a last resort, run through all channels
     // pick the channel closest to being finished AND with lower priority
+#if !RETRO_USE_ORIGINAL_CODE
+    bool32 stolen = false;
+#endif
     if (slot < 0) {
         uint32 len = 0xFFFFFFFF;
         for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
@@ -487,6 +1188,9 @@ int32 RSDK::PlaySfx(uint16 sfx, uint32 loopPoint, uint32 priority)
                 len  = (uint32)channels[c].sampleLength;
             }
         }
+#if !RETRO_USE_ORIGINAL_CODE
+        stolen = true;
+#endif
     }
 
     if (slot == -1)
@@ -494,6 +1198,19 @@ int32 RSDK::PlaySfx(uint16 sfx, uint32 loopPoint, uint32 priority)
 
     LockAudioDevice();
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // the game loses the sfx's channel either way, but a one-shot can finish playing in a spill voice instead of being cut off
+    // looping ones are still cut off, nothing would ever be able to stop them
+    if (stolen && channels[slot].state == CHANNEL_SFX && channels[slot].loop == (uint32)-1) {
+        for (int32 c = CHANNEL_COUNT; c < VOICE_COUNT; ++c) {
+            if (channels[c].state == CHANNEL_IDLE) {
+                channels[c] = channels[slot];
+                break;
+            }
+        }
+    }
+#endif
+
     channels[slot].state        = CHANNEL_SFX;
     channels[slot].bufferPos    = 0;
     channels[slot].samplePtr    = sfxList[sfx].buffer;
@@ -508,6 +1225,11 @@ int32 RSDK::PlaySfx(uint16 sfx, uint32 loopPoint, uint32 priority)
         channels[slot].loop = loopPoint - 1;
     channels[slot].priority  = priority;
     channels[slot].playIndex = sfxList[sfx].playCount++;
+#if !RETRO_USE_ORIGINAL_CODE
+    channels[slot].mixGain   = 1.0f;
+    channels[slot].mixed     = CHANNEL_MIX_STARTED;
+    channels[slot].subSample = 0;
+#endif
 
     UnlockAudioDevice();
 
@@ -563,7 +1285,7 @@ void RSDK::ClearStageSfx()
 {
     LockAudioDevice();
 
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         if (channels[c].state == CHANNEL_SFX || channels[c].state == (CHANNEL_SFX | CHANNEL_PAUSED)) {
             channels[c].soundID = -1;
             channels[c].state   = CHANNEL_IDLE;
@@ -578,6 +1300,11 @@ void RSDK::ClearStageSfx()
         }
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // whatever's left over stays decoded for the next stage, within budget
+    TrimSfxCache();
+#endif
+
     UnlockAudioDevice();
 }
 
@@ -586,7 +1313,7 @@ void RSDK::ClearGlobalSfx()
 {
     LockAudioDevice();
 
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         if (channels[c].state == CHANNEL_SFX || channels[c].state == (CHANNEL_SFX | CHANNEL_PAUSED)) {
             channels[c].soundID = -1;
             channels[c].state   = CHANNEL_IDLE;
@@ -602,6 +1329,11 @@ void RSDK::ClearGlobalSfx()
         }
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // the mods being reloaded may replace any of the files
+    ClearSfxCache();
+#endif
+
     UnlockAudioDevice();
 }
 #endif
@@ -1,11 +1,26 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include <atomic>
+#endif
+
 namespace RSDK
 {
 
 #define SFX_COUNT     (0x100)
 #define CHANNEL_COUNT (0x10)
+#if RETRO_USE_ORIGINAL_CODE
+#define VOICE_COUNT (CHANNEL_COUNT)
+#else
+// channels holds CHANNEL_COUNT channels the games can see, followed by spill voices only the engine uses
+// when PlaySfx has to cut off a one-shot sfx to free up a channel, the sfx is moved into a spill voice & plays out there instead
+// every voice is virtual, only the engine.mixedVoiceLimit most audible sfx voices actually get mixed
+// the rest keep their play position & are swapped back in once they're audible enough (see ProcessAudioMixing)
+#define VOICE_COUNT         (0x40)
+#define MIXED_VOICE_DEFAULT (0x20)
+#define VOICE_RAMP_LENGTH   (0x80) // in frames, how long a voice takes to fade in or out when it's swapped
+#endif
 
 #define MIX_BUFFER_SIZE (0x800)
 #define SAMPLE_FORMAT   float
@@ -13,6 +28,28 @@ namespace RSDK
 #define AUDIO_FREQUENCY (44100)
 #define AUDIO_CHANNELS  (2)
 
+#if !RETRO_USE_ORIGINAL_CODE
+// the mixer runs at whatever rate the device asks for (AudioDeviceBase::outputFrequency), any channel that doesn't line up with it
+// 1:1 (a pitched sfx, or anything when the device isn't at AUDIO_FREQUENCY) is resampled with a windowed sinc
+#define RESAMPLE_TAPS        (8)
+#define RESAMPLE_PHASE_SHIFT (8)
+#define RESAMPLE_PHASES      (1 << RESAMPLE_PHASE_SHIFT)
+#define RESAMPLE_KERNEL_COUNT (6) // picked by how fast the channel moves through its samples, see InitResampler
+// sfx stepping through their samples at close to 1:1 are linearly interpolated like the original mixer did instead, it's a fraction of
+// the cost & the aliasing it lets through is only noticeable once the step is a good way off
+#define RESAMPLE_LINEAR_MIN (TO_FIXED(3) / 4)
+#define RESAMPLE_LINEAR_MAX (TO_FIXED(3) / 2)
+
+// devices are opened with the smallest period (in frames) that's been stable so far, starting at engine.audioPeriod
+// AUDIO_UNDERRUN_LIMIT underruns (reported by the device, or a callback that mixed for longer than the device had queued up) within
+// AUDIO_UNDERRUN_WINDOW double the period (the device is reopened with it on the next frame) until AUDIO_PERIOD_MAX
+#define AUDIO_PERIOD_DEFAULT  (0x100)
+#define AUDIO_PERIOD_MIN      (0x40)
+#define AUDIO_PERIOD_MAX      (0x1000)
+#define AUDIO_UNDERRUN_LIMIT  (3)
+#define AUDIO_UNDERRUN_WINDOW (2000000) // in microseconds
+#endif
+
 struct SFXInfo {
     RETRO_HASH_MD5(hash);
     float *buffer;
@@ -34,12 +71,39 @@ struct ChannelInfo {
     int16 soundID;
     uint8 priority;
     uint8 state;
+#if !RETRO_USE_ORIGINAL_CODE
+    float mixGain; // ramps to 1 while the voice is mixed & to 0 while it's virtual
+    uint8 mixed;
+    uint32 subSample;   // the fractional part of the play position while resampling, in 16.16
+    float streamHistory[RESAMPLE_TAPS * 2]; // the last stream frames of the previous buffer, for resampling across the refill
+#endif
 };
 
+#if !RETRO_USE_ORIGINAL_CODE
+enum ChannelMixStates { CHANNEL_MIX_VIRTUAL, CHANNEL_MIX_MIXED, CHANNEL_MIX_STARTED };
+#endif
+
 enum ChannelStates { CHANNEL_IDLE, CHANNEL_SFX, CHANNEL_STREAM, CHANNEL_LOADING_STREAM, CHANNEL_PAUSED = 0x40 };
 
+#if !RETRO_USE_ORIGINAL_CODE
+// written from the audio thread & read from the main one, so every field is atomic
+struct AudioDeviceStats {
+    std::atomic<int32> period;           // frames per callback
+    std::atomic<int32> latency;          // how far ahead of the speakers the device buffers, in microseconds
+    std::atomic<int32> budget;           // how long the last callback's frames last, in microseconds
+    std::atomic<int32> callbackTime;     // a running average of how long mixing takes, in microseconds
+    std::atomic<int32> peakCallbackTime; // the longest mix since the device was opened, in microseconds
+    std::atomic<uint32> callbackCount;
+    std::atomic<uint32> underrunCount;   // since the device was first opened
+    std::atomic<uint32> periodGrowCount; // how many times the period's been doubled
+};
+#endif
+
 extern SFXInfo sfxList[SFX_COUNT];
-extern ChannelInfo channels[CHANNEL_COUNT];
+extern ChannelInfo channels[VOICE_COUNT];
+#if !RETRO_USE_ORIGINAL_CODE
+extern NameMap sfxNameMap;
+#endif
 
 class AudioDeviceBase
 {
@@ -56,6 +120,25 @@ public:
     static uint8 initializedAudioChannels;
     static uint8 audioState;
     static uint8 audioFocus;
+#if !RETRO_USE_ORIGINAL_CODE
+    // set by the device once it's open, in Hz
+    static int32 outputFrequency;
+
+    static AudioDeviceStats stats;
+    // the period devices should open with, in frames
+    static std::atomic<int32> targetPeriod;
+
+    // called by devices once they've been (re)opened with targetPeriod, period & latency are what they actually got, in frames
+    static void ResetAudioStats(int32 period, int32 latency);
+    // for devices that report underruns themselves, on top of the ones caught by timing the callbacks
+    static void ReportUnderrun(uint32 count = 1);
+    // returns true while targetPeriod differs from what the device was opened with, polled from FrameInit
+    static bool32 CheckPeriodChange();
+    // called by devices that couldn't reopen with targetPeriod, puts it back to the period they had before so they can reopen with that
+    static void RevertPeriodChange();
+    // the atomics can't just be assigned, so this copies them over one at a time
+    static void CopyAudioStats(AudioDeviceStats *dst, AudioDeviceStats *src);
+#endif
 
 protected:
     static void InitAudioChannels();
@@ -90,9 +173,19 @@ inline uint16 GetSfx(const char *sfxName)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(sfxName, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&sfxNameMap, hash);
+    if (slot >= 0 && HASH_MATCH_MD5(sfxList[slot].hash, hash))
+        return slot;
+#endif
+
     for (int32 s = 0; s < SFX_COUNT; ++s) {
-        if (HASH_MATCH_MD5(sfxList[s].hash, hash))
+        if (HASH_MATCH_MD5(sfxList[s].hash, hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&sfxNameMap, hash, s);
+#endif
             return s;
+        }
     }
 
     return -1;
@@ -104,7 +197,7 @@ inline void StopSfx(uint16 sfx)
     LockAudioDevice();
 #endif
 
-    for (int32 i = 0; i < CHANNEL_COUNT; ++i) {
+    for (int32 i = 0; i < VOICE_COUNT; ++i) {
         if (channels[i].soundID == sfx) {
             MEM_ZERO(channels[i]);
             channels[i].soundID = -1;
@@ -124,7 +217,7 @@ inline void StopAllSfx()
     LockAudioDevice();
 #endif
 
-    for (int32 i = 0; i < CHANNEL_COUNT; ++i) {
+    for (int32 i = 0; i < VOICE_COUNT; ++i) {
         if (channels[i].state == CHANNEL_SFX) {
             MEM_ZERO(channels[i]);
             channels[i].soundID = -1;
@@ -140,9 +233,10 @@ inline void StopAllSfx()
 
 void SetChannelAttributes(uint8 channel, float volume, float panning, float speed);
 
+// these three take spill voices too so the engine can stop or pause everything through them, games only ever get IDs below CHANNEL_COUNT
 inline void StopChannel(uint32 channel)
 {
-    if (channel < CHANNEL_COUNT) {
+    if (channel < VOICE_COUNT) {
         if (channels[channel].state != CHANNEL_LOADING_STREAM)
             channels[channel].state = CHANNEL_IDLE;
     }
@@ -150,7 +244,7 @@ inline void StopChannel(uint32 channel)
 
 inline void PauseChannel(uint32 channel)
 {
-    if (channel < CHANNEL_COUNT) {
+    if (channel < VOICE_COUNT) {
         if (channels[channel].state != CHANNEL_LOADING_STREAM)
             channels[channel].state |= CHANNEL_PAUSED;
     }
@@ -158,7 +252,7 @@ inline void PauseChannel(uint32 channel)
 
 inline void ResumeChannel(uint32 channel)
 {
-    if (channel < CHANNEL_COUNT) {
+    if (channel < VOICE_COUNT) {
         if (channels[channel].state != CHANNEL_LOADING_STREAM)
             channels[channel].state &= ~CHANNEL_PAUSED;
     }
@@ -166,17 +260,17 @@ inline void ResumeChannel(uint32 channel)
 
 inline void PauseSound()
 {
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) PauseChannel(c);
+    for (int32 c = 0; c < VOICE_COUNT; ++c) PauseChannel(c);
 }
 
 inline void ResumeSound()
 {
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) ResumeChannel(c);
+    for (int32 c = 0; c < VOICE_COUNT; ++c) ResumeChannel(c);
 }
 
 inline bool32 SfxPlaying(uint16 sfx)
 {
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         if (channels[c].state == CHANNEL_SFX && channels[c].soundID == sfx)
             return true;
     }
@@ -198,6 +292,10 @@ void ClearStageSfx();
 #if RETRO_USE_MOD_LOADER
 void ClearGlobalSfx();
 #endif
+#if !RETRO_USE_ORIGINAL_CODE
+// drops every decoded sfx kept around for reuse, needed whenever the sfx files or DATASET_SFX itself are reset
+void ClearSfxCache();
+#endif
 
 #if RETRO_REV0U
 #include "Legacy/AudioLegacy.hpp"
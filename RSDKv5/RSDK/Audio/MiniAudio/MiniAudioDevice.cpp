@@ -14,8 +14,13 @@ bool32 AudioDevice::Init()
     ma_device_config config = ma_device_config_init(ma_device_type_playback);
     config.playback.format   = ma_format_f32;   // Set to ma_format_unknown to use the device's native format.
     config.playback.channels = 2;               // Set to 0 to use the device's native channel count.
+#if !RETRO_USE_ORIGINAL_CODE
+    config.periodSizeInFrames = targetPeriod;
+    config.sampleRate        = 0;               // the device's native rate, the mixer resamples to it
+#else
     config.periodSizeInFrames = MIX_BUFFER_SIZE;
     config.sampleRate        = AUDIO_FREQUENCY;           // Set to 0 to use the device's native sample rate.
+#endif
     config.dataCallback      = AudioCallback;   // This function will be called when miniaudio needs more data.
 
     ma_result result = ma_device_init(NULL, &config, &device);
@@ -24,6 +29,11 @@ bool32 AudioDevice::Init()
         return false;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    outputFrequency = device.sampleRate;
+    ResetAudioStats(device.playback.internalPeriodSizeInFrames, device.playback.internalPeriodSizeInFrames * device.playback.internalPeriods);
+#endif
+
     result = ma_device_start(&device);
     if (result != MA_SUCCESS) {
         PrintLog(PRINT_NORMAL, "[MA] Starting device failed: %d", result);
@@ -38,6 +48,22 @@ void AudioDevice::Release()
     ma_device_uninit(&device);
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void AudioDevice::FrameInit()
+{
+    if (CheckPeriodChange()) {
+        PrintLog(PRINT_NORMAL, "[MA] Underruns, reopening the device with a period of %d frames", targetPeriod.load());
+
+        ma_device_uninit(&device);
+        if (!Init()) {
+            RevertPeriodChange();
+            ma_device_uninit(&device); // in case it was only starting it that failed
+            Init();
+        }
+    }
+}
+#endif
+
 void AudioDevice::InitAudioChannels() { AudioDeviceBase::InitAudioChannels(); }
 
 void RSDK::AudioDevice::AudioCallback(ma_device* device, void *output, const void *input, ma_uint32 frameCount)
@@ -49,10 +49,33 @@ void *AudioDevice::LoadStreamASync(void *channel)
 }
 
 // ---- Stream management ----
+#if !RETRO_USE_ORIGINAL_CODE
+static int32_t sLastXRunCount = 0;
+
+// Oboe can resize a stream's buffer without reopening it, so targetPeriod sets the buffer size (in whole bursts) here
+static bool32 ApplyBufferSize(oboe::AudioStream *stream)
+{
+    int32_t burst = stream->getFramesPerBurst();
+    if (burst <= 0)
+        return false;
+
+    int32_t size = MAX(burst * 2, (AudioDeviceBase::targetPeriod.load() + burst - 1) / burst * burst);
+    auto result  = stream->setBufferSizeInFrames(size);
+    if (!result)
+        return false;
+
+    AudioDeviceBase::ResetAudioStats(burst, result.value());
+    return true;
+}
+#endif
+
 static void ConfigureBuilderCommon(oboe::AudioStreamBuilder& b)
 {
     b.setDirection(oboe::Direction::Output);
+    // left unset the stream opens at the device's native rate (which the low latency path wants), the mixer resamples to it
+#if RETRO_USE_ORIGINAL_CODE
     b.setSampleRate(AUDIO_FREQUENCY);
+#endif
     b.setChannelCount(AUDIO_CHANNELS);
     b.setFormat(oboe::AudioFormat::Float);
     b.setPerformanceMode(oboe::PerformanceMode::LowLatency);
@@ -75,10 +98,19 @@ bool AudioDevice::createStream()
         return false;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    outputFrequency = stream->getSampleRate();
+#endif
+
     // Slightly enlarge buffer to reduce initial underruns.
     int32_t burst = stream->getFramesPerBurst();
     if (burst > 0) {
+#if !RETRO_USE_ORIGINAL_CODE
+        ApplyBufferSize(stream);
+        sLastXRunCount = 0;
+#else
         stream->setBufferSizeInFrames(burst * 2);
+#endif
         sWarmupsRemaining.store(3, std::memory_order_relaxed); // prime with 2-3 silent callbacks
     } else {
         sWarmupsRemaining.store(2, std::memory_order_relaxed);
@@ -140,6 +172,15 @@ void AudioDevice::FrameInit()
 
     // (No call to AudioDeviceBase::FrameInit() here)
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (stream && CheckPeriodChange()) {
+        PrintLog(PRINT_NORMAL, "Oboe: underruns, growing the buffer to %d frames", targetPeriod.load());
+        // the buffer keeps its old size if it couldn't be resized
+        if (!ApplyBufferSize(stream))
+            RevertPeriodChange();
+    }
+#endif
+
     if (status != oboe::Result::OK) {
         stream->requestStop();
         stream->close();
@@ -217,6 +258,14 @@ oboe::DataCallbackResult AudioDevice::onAudioReady(oboe::AudioStream *s, void *d
         return oboe::DataCallbackResult::Continue;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    auto xRuns = s->getXRunCount();
+    if (xRuns && xRuns.value() > sLastXRunCount) {
+        ReportUnderrun(xRuns.value() - sLastXRunCount);
+        sLastXRunCount = xRuns.value();
+    }
+#endif
+
     LockAudioDevice();
     AudioDevice::ProcessAudioMixing(data, numFrames * AUDIO_CHANNELS);
     UnlockAudioDevice();
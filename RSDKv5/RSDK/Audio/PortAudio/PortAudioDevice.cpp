@@ -14,11 +14,23 @@ bool32 AudioDevice::Init()
         PrintLog(PRINT_NORMAL, "[PA] Initialization failed: %s", Pa_GetErrorText(result));
         return false;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    // open at the output's default rate so the host API doesn't have to convert it, the mixer resamples to it instead
+    const PaDeviceInfo *deviceInfo = Pa_GetDeviceInfo(Pa_GetDefaultOutputDevice());
+    outputFrequency                = deviceInfo && deviceInfo->defaultSampleRate > 0 ? (int32)deviceInfo->defaultSampleRate : AUDIO_FREQUENCY;
+
+    result = Pa_OpenDefaultStream(&stream, 0, AUDIO_CHANNELS, paFloat32, outputFrequency, targetPeriod, AudioCallback, nullptr);
+#else
     result = Pa_OpenDefaultStream(&stream, 0, AUDIO_CHANNELS, paFloat32, AUDIO_FREQUENCY, MIX_BUFFER_SIZE, AudioCallback, nullptr);
+#endif
     if (result != paNoError) {
         PrintLog(PRINT_NORMAL, "[PA] Opening stream failed: %s", Pa_GetErrorText(result));
         return false;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    const PaStreamInfo *streamInfo = Pa_GetStreamInfo(stream);
+    ResetAudioStats(targetPeriod, streamInfo ? (int32)(streamInfo->outputLatency * outputFrequency) : targetPeriod * 2);
+#endif
     result = Pa_StartStream(stream);
     if (result != paNoError) {
         PrintLog(PRINT_NORMAL, "[PA] Starting stream failed: %s", Pa_GetErrorText(result));
@@ -27,6 +39,32 @@ bool32 AudioDevice::Init()
     return true;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void AudioDevice::FrameInit()
+{
+    if (CheckPeriodChange()) {
+        PrintLog(PRINT_NORMAL, "[PA] Underruns, reopening the stream with a period of %d frames", targetPeriod.load());
+
+        Pa_StopStream(stream);
+        Pa_CloseStream(stream);
+        Pa_Terminate(); // Init() initializes it again
+
+        stream = NULL;
+        if (!Init()) {
+            RevertPeriodChange();
+
+            // Init() bails out at whichever step failed, leaving everything before it open
+            if (stream) {
+                Pa_CloseStream(stream);
+                stream = NULL;
+            }
+            Pa_Terminate();
+            Init();
+        }
+    }
+}
+#endif
+
 void AudioDevice::Release()
 {
     Pa_StopStream(stream);
@@ -40,9 +78,15 @@ int RSDK::AudioDevice::AudioCallback(const void *input, void *output, unsigned l
 {
     (void)input;
     (void)timeInfo;
-    (void)statusFlags;
     (void)userData;
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (statusFlags & paOutputUnderflow)
+        ReportUnderrun();
+#else
+    (void)statusFlags;
+#endif
+
     AudioDevice::ProcessAudioMixing(output, frameCount * AUDIO_CHANNELS);
     return 0;
 }
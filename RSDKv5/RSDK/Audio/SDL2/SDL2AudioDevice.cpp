@@ -15,12 +15,24 @@ bool32 AudioDevice::Init()
     SDL_AudioSpec want;
     want.freq     = AUDIO_FREQUENCY;
     want.format   = AUDIO_F32SYS;
+#if !RETRO_USE_ORIGINAL_CODE
+    want.samples  = targetPeriod;
+#else
     want.samples  = MIX_BUFFER_SIZE / AUDIO_CHANNELS;
+#endif
     want.channels = AUDIO_CHANNELS;
     want.callback = AudioCallback;
 
     audioState = false;
+#if !RETRO_USE_ORIGINAL_CODE
+    // take whatever rate the device runs at natively, the mixer resamples to it rather than SDL doing it a second time
+    if ((device = SDL_OpenAudioDevice(nullptr, 0, &want, &deviceSpec, SDL_AUDIO_ALLOW_SAMPLES_CHANGE | SDL_AUDIO_ALLOW_FREQUENCY_CHANGE)) > 0) {
+        outputFrequency = deviceSpec.freq;
+        // SDL keeps one period queued while the next is mixed
+        ResetAudioStats(deviceSpec.samples, deviceSpec.samples * 2);
+#else
     if ((device = SDL_OpenAudioDevice(nullptr, 0, &want, &deviceSpec, SDL_AUDIO_ALLOW_SAMPLES_CHANGE)) > 0) {
+#endif
         SDL_PauseAudioDevice(device, SDL_FALSE);
         audioState = true;
     }
@@ -44,6 +56,25 @@ void AudioDevice::Release()
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void AudioDevice::FrameInit()
+{
+    if (CheckPeriodChange()) {
+        PrintLog(PRINT_NORMAL, "Audio underruns, reopening the device with a period of %d frames", targetPeriod.load());
+
+        SDL_CloseAudioDevice(device);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO); // Init() takes it again
+        Init();
+
+        if (!audioState) {
+            RevertPeriodChange();
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            Init();
+        }
+    }
+}
+#endif
+
 void AudioDevice::InitAudioChannels()
 {
     AudioDeviceBase::InitAudioChannels();
@@ -11,7 +11,11 @@ public:
     static bool32 Init();
     static void Release();
 
+#if !RETRO_USE_ORIGINAL_CODE
+    static void FrameInit();
+#else
     static void FrameInit() {}
+#endif
 
     inline static void HandleStreamLoad(ChannelInfo *channel, bool32 async)
     {
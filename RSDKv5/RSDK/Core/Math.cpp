@@ -134,3 +134,85 @@ uint8 RSDK::ArcTanLookup(int32 X, int32 Y)
     else
         return arcTan256LookupTable[(x << 8) + y];
 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+static inline void SinCosBatch(int32 *sines, int32 *cosines, const int32 *angles, int32 count, const int32 *sinTable, const int32 *cosTable,
+                               int32 mask)
+{
+    for (int32 i = 0; i < count; ++i) {
+        int32 angle = angles[i] & mask;
+        sines[i]    = sinTable[angle];
+        cosines[i]  = cosTable[angle];
+    }
+}
+
+void RSDK::SinCos1024Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count)
+{
+    SinCosBatch(sines, cosines, angles, count, sin1024LookupTable, cos1024LookupTable, 0x3FF);
+}
+void RSDK::SinCos512Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count)
+{
+    SinCosBatch(sines, cosines, angles, count, sin512LookupTable, cos512LookupTable, 0x1FF);
+}
+void RSDK::SinCos256Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count)
+{
+    SinCosBatch(sines, cosines, angles, count, sin256LookupTable, cos256LookupTable, 0xFF);
+}
+
+void RSDK::ArcTanBatch(uint8 *angles, const Vector2 *vectors, int32 count)
+{
+    for (int32 i = 0; i < count; ++i) {
+        int32 X = vectors[i].x;
+        int32 Y = vectors[i].y;
+        int32 x = abs(X);
+        int32 y = abs(Y);
+
+        // ArcTanLookup shifts both down 4 bits at a time until the larger one fits in a byte, so work out how many shifts that takes
+        uint32 largest = (uint32)MAX(x, y);
+        int32 shift    = 0;
+        shift += largest >= 0x100 ? 4 : 0;
+        shift += largest >= 0x1000 ? 4 : 0;
+        shift += largest >= 0x10000 ? 4 : 0;
+        shift += largest >= 0x100000 ? 4 : 0;
+        shift += largest >= 0x1000000 ? 4 : 0;
+        shift += largest >= 0x10000000 ? 4 : 0;
+
+        uint8 angle = arcTan256LookupTable[((x >> shift) << 8) + (y >> shift)];
+        if (X <= 0)
+            angles[i] = Y <= 0 ? angle + 0x80 : 0x80 - angle;
+        else
+            angles[i] = Y <= 0 ? -angle : angle;
+    }
+}
+
+void RSDK::RotateVectorsBatch(Vector2 *vectors, int32 count, Vector2 *pivot, int32 angle)
+{
+    int64 sine   = sin512LookupTable[angle & 0x1FF];
+    int64 cosine = cos512LookupTable[angle & 0x1FF];
+
+    for (int32 i = 0; i < count; ++i) {
+        int64 x = vectors[i].x - pivot->x;
+        int64 y = vectors[i].y - pivot->y;
+
+        vectors[i].x = pivot->x + (int32)((x * cosine - y * sine) >> 9);
+        vectors[i].y = pivot->y + (int32)((x * sine + y * cosine) >> 9);
+    }
+}
+
+void RSDK::MultiplyVectorsBatch(Vector2 *vectors, int32 count, int32 multiplier)
+{
+    for (int32 i = 0; i < count; ++i) {
+        vectors[i].x = (int32)(((int64)vectors[i].x * multiplier) >> 16);
+        vectors[i].y = (int32)(((int64)vectors[i].y * multiplier) >> 16);
+    }
+}
+
+void RSDK::DistanceSquaredBatch(int32 *distances, const Vector2 *vectors, int32 count, Vector2 *target)
+{
+    for (int32 i = 0; i < count; ++i) {
+        int32 x      = (vectors[i].x - target->x) >> 16;
+        int32 y      = (vectors[i].y - target->y) >> 16;
+        distances[i] = x * x + y * y;
+    }
+}
+#endif
@@ -112,6 +112,27 @@ inline int32 ACos256(int32 angle)
 // Get Arc Tan value
 uint8 ArcTanLookup(int32 x, int32 y);
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Batched math
+// These give the exact same results as calling the scalar versions one element at a time, but they're plain branchless loops over
+// whole arrays, so the compiler is free to vectorize them & the lookup tables only get pulled into cache once per batch
+// Mods get them through the mod table (ModTable_SinCos1024Batch etc), selftest=math checks them against the scalar versions
+
+void SinCos1024Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count);
+void SinCos512Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count);
+void SinCos256Batch(int32 *sines, int32 *cosines, const int32 *angles, int32 count);
+
+// angles[i] = ArcTanLookup(vectors[i].x, vectors[i].y)
+void ArcTanBatch(uint8 *angles, const Vector2 *vectors, int32 count);
+
+// rotates every vector around the pivot by the same angle (0x200 per turn, clockwise on screen), using the 512 tables
+void RotateVectorsBatch(Vector2 *vectors, int32 count, Vector2 *pivot, int32 angle);
+// scales every vector by a 16.16 fixed point multiplier
+void MultiplyVectorsBatch(Vector2 *vectors, int32 count, int32 multiplier);
+// distances[i] is the squared distance from vectors[i] to the target, in whole pixels
+void DistanceSquaredBatch(int32 *distances, const Vector2 *vectors, int32 count, Vector2 *target);
+#endif
+
 extern uint32 randSeed;
 
 inline void SetRandSeed(int32 key) { randSeed = key; }
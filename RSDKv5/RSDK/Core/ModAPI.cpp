@@ -195,6 +195,19 @@ void RSDK::InitModAPI(bool32 getVersion)
     ADD_MOD_FUNCTION(ModTable_FindRWallPosition, FindRWallPosition);
     ADD_MOD_FUNCTION(ModTable_CopyCollisionMask, CopyCollisionMask);
     ADD_MOD_FUNCTION(ModTable_GetCollisionInfo, GetCollisionInfo);
+
+#if !RETRO_USE_ORIGINAL_CODE
+    ADD_MOD_FUNCTION(ModTable_SetTempEntityPool, SetTempEntityPool);
+
+    // Math
+    ADD_MOD_FUNCTION(ModTable_SinCos1024Batch, SinCos1024Batch);
+    ADD_MOD_FUNCTION(ModTable_SinCos512Batch, SinCos512Batch);
+    ADD_MOD_FUNCTION(ModTable_SinCos256Batch, SinCos256Batch);
+    ADD_MOD_FUNCTION(ModTable_ArcTanBatch, ArcTanBatch);
+    ADD_MOD_FUNCTION(ModTable_RotateVectorsBatch, RotateVectorsBatch);
+    ADD_MOD_FUNCTION(ModTable_MultiplyVectorsBatch, MultiplyVectorsBatch);
+    ADD_MOD_FUNCTION(ModTable_DistanceSquaredBatch, DistanceSquaredBatch);
+#endif
 #endif
 
     superLevels.clear();
@@ -271,6 +284,11 @@ void RSDK::LoadModSettings()
 
 void RSDK::ApplyModChanges()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    // DATASET_SFX gets reset below, taking the cached sfx with it
+    ClearSfxCache();
+#endif
+
 #if RETRO_REV0U
     uint32 category                      = sceneInfo.activeCategory;
     uint32 scene                         = sceneInfo.listPos;
@@ -504,7 +522,7 @@ void RSDK::LoadMods(bool newOnly, bool32 getVersion)
 
         if (AudioDevice::initializedAudioChannels) {
             // Stop all sounds
-            for (int32 c = 0; c < CHANNEL_COUNT; ++c) StopChannel(c);
+            for (int32 c = 0; c < VOICE_COUNT; ++c) StopChannel(c);
 
             // we're about to reload these, so clear anything we already have
             ClearGlobalSfx();
@@ -138,6 +138,16 @@ enum ModFunctionTableIDs {
     ModTable_FindRWallPosition,
     ModTable_CopyCollisionMask,
     ModTable_GetCollisionInfo,
+    ModTable_SetTempEntityPool,
+
+    // Math
+    ModTable_SinCos1024Batch,
+    ModTable_SinCos512Batch,
+    ModTable_SinCos256Batch,
+    ModTable_ArcTanBatch,
+    ModTable_RotateVectorsBatch,
+    ModTable_MultiplyVectorsBatch,
+    ModTable_DistanceSquaredBatch,
 #endif
 
     ModTable_Count
@@ -360,9 +370,22 @@ inline uint16 *GetPaletteBank(uint8 id)
 {
     if (id >= PALETTE_BANK_COUNT)
         return NULL;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    // no way of knowing what the mod does with it (or when), so assume it gets written to from now on
+    FlushDrawCommands();
+    MarkPaletteDirty(id);
+    paletteUntrackedBanks |= 1 << id;
+#endif
     return fullPalette[id];
 }
-inline uint8 *GetActivePaletteBuffer() { return gfxLineBuffer; }
+inline uint8 *GetActivePaletteBuffer()
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+    return gfxLineBuffer;
+}
 inline void GetRGB32To16Buffer(uint16 **rgb32To16_R, uint16 **rgb32To16_G, uint16 **rgb32To16_B)
 {
     if (rgb32To16_R)
@@ -1,5 +1,11 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#endif
+
 using namespace RSDK;
 
 RSDKFileInfo RSDK::dataFileList[DATAFILE_COUNT];
@@ -12,6 +18,16 @@ char RSDK::gameLogicName[0x200];
 
 bool32 RSDK::useDataPack = false;
 
+#if !RETRO_USE_ORIGINAL_CODE
+static PrefetchedFile prefetchedFiles[PREFETCH_FILE_COUNT];
+// only ever changed from the main thread (with prefetchLock held), LoadFile checks it without taking the lock
+static std::atomic<int32> prefetchedFileCount(0);
+
+static std::mutex prefetchLock;
+static std::condition_variable prefetchCond;
+static int32 prefetchedBytes = 0;
+#endif
+
 #if RETRO_REV0U
 void RSDK::DetectEngineVersion()
 {
@@ -232,12 +248,9 @@ bool32 RSDK::OpenDataFile(FileInfo *info, const char *filename)
     return false;
 }
 
-bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
+// Works out where a file is actually read from (mod redirects, user dir, etc), fullFilePath must hold 0x100 chars
+static void ResolveFilePath(FileInfo *info, const char *filename, char *fullFilePath)
 {
-    if (info->file)
-        return false;
-
-    char fullFilePath[0x100];
     strcpy(fullFilePath, filename);
 
 #if RETRO_USE_MOD_LOADER
@@ -284,7 +297,7 @@ bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
     if (addPath) {
         char pathBuf[0x100];
         sprintf_s(pathBuf, sizeof(pathBuf), "%s%s", SKU::userFileDir, fullFilePath);
-        sprintf_s(fullFilePath, sizeof(fullFilePath), "%s", pathBuf);
+        sprintf_s(fullFilePath, 0x100, "%s", pathBuf);
     }
 #else
     (void)addPath;
@@ -296,9 +309,24 @@ bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
     if (!info->externalFile) {
         char pathBuf[0x100];
         sprintf_s(pathBuf, sizeof(pathBuf), "%s%s", SKU::userFileDir, fullFilePath);
-        sprintf_s(fullFilePath, sizeof(fullFilePath), "%s", pathBuf);
+        sprintf_s(fullFilePath, 0x100, "%s", pathBuf);
     }
 #endif
+}
+
+bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
+{
+    if (info->file)
+        return false;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    // serve files staged by the scene prefetcher straight from memory
+    if (fileMode == FMODE_RB && !info->externalFile && LoadPrefetchedFile(info, filename))
+        return true;
+#endif
+
+    char fullFilePath[0x100];
+    ResolveFilePath(info, filename, fullFilePath);
 
     if (!info->externalFile && fileMode == FMODE_RB && useDataPack) {
         return OpenDataFile(info, filename);
@@ -329,6 +357,174 @@ bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
     return true;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+static void OpenPrefetchedBuffer(FileInfo *info, PrefetchedFile *file)
+{
+    info->file            = (FileIO *)file->buffer;
+    info->fileBuffer      = file->buffer;
+    info->fileSize        = file->size;
+    info->readPos         = 0;
+    info->fileOffset      = 0;
+    info->usingFileBuffer = true;
+    info->encrypted       = false; // already decrypted when it was staged
+}
+
+bool32 RSDK::QueuePrefetchFile(const char *filename)
+{
+#if RETRO_USE_MOD_LOADER
+    // LoadPrefetchedFile won't hand anything out while a specific mod is being searched, so don't resolve paths for one either
+    if (modSettings.activeMod != -1)
+        return false;
+#endif
+
+    std::lock_guard<std::mutex> lock(prefetchLock);
+
+    if (prefetchedFileCount >= PREFETCH_FILE_COUNT)
+        return false;
+
+    for (int32 f = 0; f < prefetchedFileCount; ++f) {
+        if (strcmp(prefetchedFiles[f].path, filename) == 0)
+            return false;
+    }
+
+    // mod redirects & the like are resolved here, the worker never touches any of that state
+    FileInfo info;
+    InitFileInfo(&info);
+
+    PrefetchedFile *file = &prefetchedFiles[prefetchedFileCount];
+    sprintf_s(file->path, sizeof(file->path), "%s", filename);
+    ResolveFilePath(&info, filename, file->fullPath);
+    file->dataPack = !info.externalFile && useDataPack;
+    file->buffer   = NULL;
+    file->size     = 0;
+    file->state    = PREFETCH_PENDING;
+    file->used     = false;
+
+    ++prefetchedFileCount;
+    return true;
+}
+
+bool32 RSDK::ReadNextPrefetchFile()
+{
+    PrefetchedFile *file = NULL;
+    {
+        std::lock_guard<std::mutex> lock(prefetchLock);
+
+        for (int32 f = 0; f < prefetchedFileCount; ++f) {
+            if (prefetchedFiles[f].state == PREFETCH_PENDING) {
+                file = &prefetchedFiles[f];
+                break;
+            }
+        }
+    }
+
+    if (!file)
+        return false;
+
+    uint8 *buffer = NULL;
+    int32 size    = 0;
+
+    // same as LoadFile, minus everything that was already worked out when it was queued
+    FileInfo srcInfo;
+    InitFileInfo(&srcInfo);
+    if (file->dataPack) {
+        OpenDataFile(&srcInfo, file->path);
+    }
+    else {
+        srcInfo.file = fOpen(file->fullPath, "rb");
+        if (srcInfo.file) {
+            fSeek(srcInfo.file, 0, SEEK_END);
+            srcInfo.fileSize = (int32)fTell(srcInfo.file);
+            fSeek(srcInfo.file, 0, SEEK_SET);
+        }
+    }
+
+    if (srcInfo.file) {
+        size = srcInfo.fileSize;
+
+        if (size > 0 && prefetchedBytes + size <= PREFETCH_BYTE_LIMIT) {
+            buffer = (uint8 *)malloc(size);
+
+            if (buffer && ReadBytes(&srcInfo, buffer, size) != (size_t)size) {
+                free(buffer);
+                buffer = NULL;
+            }
+        }
+
+        CloseFile(&srcInfo);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(prefetchLock);
+        file->buffer = buffer;
+        file->size   = buffer ? size : 0;
+        file->state  = buffer ? PREFETCH_READY : PREFETCH_FAILED;
+        prefetchedBytes += file->size;
+    }
+    prefetchCond.notify_all();
+
+    return true;
+}
+
+bool32 RSDK::LoadPrefetchedFile(FileInfo *info, const char *filename)
+{
+    // nearly every LoadFile call happens with nothing staged
+    if (!prefetchedFileCount)
+        return false;
+
+#if RETRO_USE_MOD_LOADER
+    // files are staged from the regular search paths, don't hand them out while a specific mod is being searched
+    if (modSettings.activeMod != -1)
+        return false;
+#endif
+
+    std::unique_lock<std::mutex> lock(prefetchLock);
+
+    for (int32 f = 0; f < prefetchedFileCount; ++f) {
+        PrefetchedFile *file = &prefetchedFiles[f];
+
+        if (strcmp(file->path, filename) == 0) {
+            // still in flight, it's always going to be quicker to wait for it than to start over
+            prefetchCond.wait(lock, [file] { return file->state != PREFETCH_PENDING; });
+
+            if (file->state != PREFETCH_READY)
+                return false;
+
+            OpenPrefetchedBuffer(info, file);
+            file->used = true;
+
+            PrintLog(PRINT_NORMAL, "Loaded prefetched file %s", filename);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RSDK::ClearPrefetchedFiles()
+{
+    std::lock_guard<std::mutex> lock(prefetchLock);
+
+    if (prefetchedFileCount) {
+        int32 usedCount = 0;
+        for (int32 f = 0; f < prefetchedFileCount; ++f) {
+            if (prefetchedFiles[f].used)
+                ++usedCount;
+
+            if (prefetchedFiles[f].buffer)
+                free(prefetchedFiles[f].buffer);
+
+            prefetchedFiles[f].buffer = NULL;
+        }
+
+        PrintLog(PRINT_NORMAL, "Prefetch: used %d of %d staged files (%d bytes)", usedCount, prefetchedFileCount.load(), prefetchedBytes);
+    }
+
+    prefetchedFileCount = 0;
+    prefetchedBytes     = 0;
+}
+#endif
+
 void RSDK::GenerateELoadKeys(FileInfo *info, const char *key1, int32 key2)
 {
     // This function splits hashes into bytes by casting their integers to byte arrays,
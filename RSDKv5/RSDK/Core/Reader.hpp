@@ -438,6 +438,37 @@ inline int32 ReadCompressed(FileInfo *info, uint8 **buffer)
     return newSize;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Scene prefetching: files are read (and decrypted) on a worker thread into staging buffers,
+// LoadFile then serves them straight from memory instead of hitting the disk/datapack
+#define PREFETCH_FILE_COUNT (0x80)
+#define PREFETCH_BYTE_LIMIT (16 * 1024 * 1024) // 16MB
+
+enum PrefetchStates {
+    PREFETCH_PENDING,
+    PREFETCH_READY,
+    PREFETCH_FAILED,
+};
+
+struct PrefetchedFile {
+    char path[0x100];     // what LoadFile gets asked for
+    char fullPath[0x100]; // where it's actually read from, resolved when it's queued
+    bool32 dataPack;
+    uint8 *buffer;
+    int32 size;
+    uint8 state;
+    bool32 used;
+};
+
+// only call from the main thread, since that's the only place the mod state can be read safely
+bool32 QueuePrefetchFile(const char *filename);
+// only call from the prefetch worker, reads the next queued file, returns false once there's nothing left to read
+bool32 ReadNextPrefetchFile();
+bool32 LoadPrefetchedFile(FileInfo *info, const char *filename);
+// the prefetch worker must be finished before calling this
+void ClearPrefetchedFiles();
+#endif
+
 inline void ClearDataFiles()
 {
     // Unload file list
@@ -42,6 +42,11 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
     if (InitStorage()) {
         SKU::InitUserCore();
         LoadSettingsINI();
+#if !RETRO_USE_ORIGINAL_CODE
+        // vsync would cap the benchmark to the refresh rate, this doesn't get saved since changedVideoSettings isn't set
+        if (inputReplay.benchmark)
+            videoSettings.vsync = false;
+#endif
 
 #if !RETRO_USE_ORIGINAL_CODE
         // temp fix till i properly figure out what exactly went wrong here
@@ -122,8 +127,13 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
         if (!RenderDevice::isRunning)
             break;
 
+#if !RETRO_USE_ORIGINAL_CODE
+        if ((inputReplay.benchmark && inputReplay.state == INPUTREPLAY_PLAYING) || RenderDevice::CheckFPSCap()) {
+#else
         if (RenderDevice::CheckFPSCap()) {
+#endif
             RenderDevice::UpdateFPSCap();
+            PROFILE_BEGIN_FRAME();
 
             AudioDevice::FrameInit();
 
@@ -145,7 +155,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                     engine.focusState = 1;
 
 #if !RETRO_USE_ORIGINAL_CODE
-                    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+                    for (int32 c = 0; c < VOICE_COUNT; ++c) {
                         engine.focusPausedChannel[c] = false;
                         if (!(channels[c].state & CHANNEL_PAUSED)) {
                             PauseChannel(c);
@@ -161,7 +171,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                 engine.focusState = 0;
 
 #if !RETRO_USE_ORIGINAL_CODE
-                for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+                for (int32 c = 0; c < VOICE_COUNT; ++c) {
                     if (engine.focusPausedChannel[c])
                         ResumeChannel(c);
                     engine.focusPausedChannel[c] = false;
@@ -181,7 +191,8 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                     // common stuff
                     foreachStackPtr = foreachStackList;
 #if !RETRO_USE_ORIGINAL_CODE
-                    debugHitboxCount = 0;
+                    debugHitboxCount  = 0;
+                    paletteDirtyBanks = 0;
 #endif
 
 #if RETRO_USE_MOD_LOADER
@@ -197,7 +208,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                         SaveMods();
                         RefreshModFolders(true);
                         LoadModSettings();
-                        for (int32 c = 0; c < CHANNEL_COUNT; ++c) StopChannel(c);
+                        for (int32 c = 0; c < VOICE_COUNT; ++c) StopChannel(c);
 #if RETRO_REV02
                         forceHardReset = true;
 #endif
@@ -224,6 +235,9 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                         dataStorage[DATASET_STG].usedStorage = 0;
                         dataStorage[DATASET_SFX].entryCount  = 0;
                         dataStorage[DATASET_SFX].usedStorage = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+                        ClearSfxCache();
+#endif
 
                         for (int32 o = 0; o < objectClassCount; ++o) {
                             if (objectClassList[o].staticVars && *objectClassList[o].staticVars)
@@ -265,11 +279,15 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 #endif
 
                     // update device states and other stuff
-                    ProcessInputDevices();
+                    {
+                        PROFILE_ZONE(PROFILE_INPUT);
+                        ProcessInputDevices();
+                    }
 
                     if (engine.devMenu)
                         ProcessDebugCommands();
 
+                    PROFILE_ZONE(PROFILE_ENGINE);
 #if RETRO_REV0U
                     switch (engine.version) {
                         default:
@@ -280,6 +298,10 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 #else
                     ProcessEngine();
 #endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+                    UpdateFrameCapture();
+#endif
                 }
 
 #if RETRO_PLATFORM == RETRO_ANDROID
@@ -319,6 +341,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                         // DrawDevString(buffer, currentScreen->center.x, currentScreen->center.y - 48, 1, 0xF0F0F0);
                     }
 
+                    PROFILE_ZONE(PROFILE_COPYFRAMEBUFFER);
                     RenderDevice::CopyFrameBuffer();
                 }
             }
@@ -326,17 +349,43 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
             if ((engine.focusState & 1) || engine.inFocus == 1)
                 RenderDevice::ProcessDimming();
 
-            RenderDevice::FlipScreen();
+            {
+                PROFILE_ZONE(PROFILE_FLIPSCREEN);
+#if !RETRO_USE_ORIGINAL_CODE
+                BeginInputPresent();
+#endif
+                RenderDevice::FlipScreen();
+#if !RETRO_USE_ORIGINAL_CODE
+                EndInputPresent();
+#endif
+            }
+
+#if !RETRO_USE_ORIGINAL_CODE
+            UpdateInputReplayTiming();
+#endif
         }
     }
 
     // Shutdown
 
+#if !RETRO_USE_ORIGINAL_CODE
+    StopInputReplay();
+    StopFrameCapture();
+#endif
     ReleaseInputDevices();
     AudioDevice::Release();
     RenderDevice::Release(false);
     SaveSettingsINI(false);
     SKU::ReleaseUserCore();
+#if !RETRO_USE_ORIGINAL_CODE
+    ReleaseScenePrefetch();
+    ReleaseDeferredDrawing();
+    ReleaseSnapshots();
+    ReleaseVideo();
+#endif
+#if RETRO_USE_PROFILER
+    ReleaseProfiler();
+#endif
     ReleaseStorage();
 #if RETRO_USE_MOD_LOADER
     UnloadMods();
@@ -362,19 +411,45 @@ void RSDK::ProcessEngine()
             }
             else {
 #if RETRO_USE_MOD_LOADER
-                if (devMenu.modsChanged)
+                if (devMenu.modsChanged) {
+#if !RETRO_USE_ORIGINAL_CODE
+                    // anything staged may have come from the old mod list
+                    ReleaseScenePrefetch();
+#endif
                     RefreshModFolders();
+                }
 #endif
                 LoadSceneFolder();
                 LoadSceneAssets();
                 InitObjects();
 
+#if !RETRO_USE_ORIGINAL_CODE
+                if (selfTests.pending)
+                    RunSelfTests();
+#endif
+
 #if RETRO_REV02
 #if !RETRO_USE_ORIGINAL_CODE
                 AddViewableVariable("Show Hitboxes", &showHitboxes, VIEWVAR_BOOL, false, true);
                 AddViewableVariable("Show Palettes", &engine.showPaletteOverlay, VIEWVAR_BOOL, false, true);
                 AddViewableVariable("Show Obj Range", &engine.showUpdateRanges, VIEWVAR_UINT8, 0, 2);
                 AddViewableVariable("Show Obj Info", &engine.showEntityInfo, VIEWVAR_UINT8, 0, 2);
+                AddViewableVariable("Col Field", &useCollisionField, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Col Bench Rec", &collisionBench.recording, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Col Bench Run", &collisionBench.run, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Deferred Draw", &useDeferredDrawing, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Partial Upload", &usePartialUploads, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Late Input", &inputLatency.lateLatch, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Show Latency", &inputLatency.showOverlay, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Save Snapshot", &snapshots.capture, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Load Snapshot", &snapshots.restore, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Auto Snapshot", &snapshots.everyFrame, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Rewind 1 Sec", &snapshots.rewind, VIEWVAR_BOOL, false, true);
+#endif
+#if RETRO_USE_PROFILER
+                AddViewableVariable("Show Profiler", &profiler.overlayMode, VIEWVAR_UINT8, PROFILER_OVERLAY_NONE, PROFILER_OVERLAY_DETAILED);
+                AddViewableVariable("Capture Profile", &profiler.capture, VIEWVAR_BOOL, false, true);
+                AddViewableVariable("Class Costs", &profiler.trackClasses, VIEWVAR_BOOL, false, true);
 #endif
                 SKU::userCore->StageLoad();
                 for (int32 v = 0; v < DRAWGROUP_COUNT; ++v)
@@ -397,6 +472,11 @@ void RSDK::ProcessEngine()
             ProcessSceneTimer();
             ProcessObjects();
             ProcessParallaxAutoScroll();
+#if !RETRO_USE_ORIGINAL_CODE
+            UpdateScenePrefetch();
+            UpdateCollisionBench();
+            UpdateSnapshots();
+#endif
 
             for (int32 i = 1; i < engine.gameSpeed; ++i) {
                 if (sceneInfo.state != ENGINESTATE_REGULAR)
@@ -463,6 +543,22 @@ void RSDK::ProcessEngine()
             AddViewableVariable("Show Palettes", &engine.showPaletteOverlay, VIEWVAR_BOOL, false, true);
             AddViewableVariable("Show Obj Range", &engine.showUpdateRanges, VIEWVAR_UINT8, 0, 2);
             AddViewableVariable("Show Obj Info", &engine.showEntityInfo, VIEWVAR_UINT8, 0, 2);
+            AddViewableVariable("Col Field", &useCollisionField, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Col Bench Rec", &collisionBench.recording, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Col Bench Run", &collisionBench.run, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Deferred Draw", &useDeferredDrawing, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Partial Upload", &usePartialUploads, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Late Input", &inputLatency.lateLatch, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Show Latency", &inputLatency.showOverlay, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Save Snapshot", &snapshots.capture, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Load Snapshot", &snapshots.restore, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Auto Snapshot", &snapshots.everyFrame, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Rewind 1 Sec", &snapshots.rewind, VIEWVAR_BOOL, false, true);
+#endif
+#if RETRO_USE_PROFILER
+            AddViewableVariable("Show Profiler", &profiler.overlayMode, VIEWVAR_UINT8, PROFILER_OVERLAY_NONE, PROFILER_OVERLAY_DETAILED);
+            AddViewableVariable("Capture Profile", &profiler.capture, VIEWVAR_BOOL, false, true);
+            AddViewableVariable("Class Costs", &profiler.trackClasses, VIEWVAR_BOOL, false, true);
 #endif
             SKU::userCore->StageLoad();
             for (int32 v = 0; v < DRAWGROUP_COUNT; ++v)
@@ -632,6 +728,35 @@ void RSDK::ParseArguments(int32 argc, char *argv[])
         }
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+        find = strstr(argv[a], "record=");
+        if (find)
+            SetupInputReplay(find + 7, INPUTREPLAY_RECORDING, false);
+
+        find = strstr(argv[a], "replay=");
+        if (find)
+            SetupInputReplay(find + 7, INPUTREPLAY_PLAYING, false);
+
+        // plays back a replay uncapped, then prints the frame time percentiles & quits
+        find = strstr(argv[a], "benchmark=");
+        if (find)
+            SetupInputReplay(find + 10, INPUTREPLAY_PLAYING, true);
+
+        // captures every frame (& their hashes) or just the hashes, see FrameCapture.hpp
+        find = strstr(argv[a], "capture=");
+        if (find)
+            SetupFrameCapture(find + 8, FRAMECAPTURE_VIDEO);
+
+        find = strstr(argv[a], "framehashes=");
+        if (find)
+            SetupFrameCapture(find + 12, FRAMECAPTURE_HASHES);
+
+        // runs the built-in tests & benchmarks once the first scene has loaded, see SelfTest.hpp
+        find = strstr(argv[a], "selftest=");
+        if (find)
+            SetupSelfTests(find + 9);
+#endif
+
 #if !RETRO_DISABLE_LOG
         find = strstr(argv[a], "console=true");
         if (find) {
@@ -761,6 +886,9 @@ void RSDK::StartGameObjects()
     sceneInfo.activeCategory = 0;
     sceneInfo.listPos        = 0;
     sceneInfo.state          = ENGINESTATE_LOAD;
+#if !RETRO_USE_ORIGINAL_CODE
+    ClearNameMap(&objectNameMap);
+#endif
     sceneInfo.inEditor       = false;
     sceneInfo.debugMode      = engine.devMenu;
     devMenu.state            = DevMenu_MainMenu;
@@ -253,6 +253,11 @@ enum GameRegions {
 #define RETRO_DISABLE_LOG (0)
 #endif
 
+// Enables the built-in frame profiler (dev menu overlay, class costs & trace capture)
+#ifndef RETRO_USE_PROFILER
+#define RETRO_USE_PROFILER (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
 // ============================
 // PLATFORM INIT
 // ============================
@@ -558,9 +563,13 @@ extern "C" {
 #include "RSDK/Graphics/Scene3D.hpp"
 #include "RSDK/Scene/Scene.hpp"
 #include "RSDK/Scene/Collision.hpp"
+#include "RSDK/Scene/Snapshot.hpp"
 #include "RSDK/Graphics/Sprite.hpp"
 #include "RSDK/Graphics/Video.hpp"
 #include "RSDK/Dev/Debug.hpp"
+#include "RSDK/Dev/Profiler.hpp"
+#include "RSDK/Dev/FrameCapture.hpp"
+#include "RSDK/Dev/SelfTest.hpp"
 #include "RSDK/User/Core/UserCore.hpp"
 #include "RSDK/User/Core/UserAchievements.hpp"
 #include "RSDK/User/Core/UserLeaderboards.hpp"
@@ -607,7 +616,7 @@ struct RetroEngine {
     uint8 focusState = 0;
     uint8 inFocus    = 0;
 #if !RETRO_USE_ORIGINAL_CODE
-    uint8 focusPausedChannel[CHANNEL_COUNT];
+    uint8 focusPausedChannel[VOICE_COUNT];
 #endif
 
     bool32 initialized = false;
@@ -645,6 +654,12 @@ struct RetroEngine {
     bool32 streamsEnabled = true;
     float streamVolume    = 1.0f;
     float soundFXVolume   = 1.0f;
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 mixedVoiceLimit = MIXED_VOICE_DEFAULT;
+    int32 audioPeriod     = AUDIO_PERIOD_DEFAULT; // the period the audio device starts out with, in frames
+
+    int32 tempEntityCount = TEMPENTITY_COUNT; // size of the temp entity region, picked up on the next stage load
+#endif
 };
 
 extern RetroEngine engine;
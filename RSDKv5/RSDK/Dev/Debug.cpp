@@ -1210,6 +1210,27 @@ void RSDK::DevMenu_AudioOptionsMenu()
     DrawDevString("Back", currentScreen->center.x, dy + 16, ALIGN_CENTER, selectionColors[3]);
 
 #if !RETRO_USE_ORIGINAL_CODE
+    AudioDeviceStats *stats = &AudioDevice::stats;
+    char buffer[0x40];
+
+    dy += 48;
+    DrawRectangle(currentScreen->center.x - 128, dy - 8, 0x100, 0x30, 0x80, 0xFF, INK_NONE, true);
+
+    sprintf_s(buffer, sizeof(buffer), "Output: %dHz, %d frames", AudioDevice::outputFrequency, stats->period.load());
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F080);
+
+    dy += 8;
+    sprintf_s(buffer, sizeof(buffer), "Latency: %.1fms, budget %dus", stats->latency.load() / 1000.0f, stats->budget.load());
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F080);
+
+    dy += 8;
+    sprintf_s(buffer, sizeof(buffer), "Mix avg/peak: %d/%dus", stats->callbackTime.load(), stats->peakCallbackTime.load());
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F080);
+
+    dy += 8;
+    sprintf_s(buffer, sizeof(buffer), "Underruns: %u, grown %ux", stats->underrunCount.load(), stats->periodGrowCount.load());
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F080);
+
     int8 cornerButton = CORNERBUTTON_START;
     switch (devMenu.selection) {
         case 0: cornerButton = CORNERBUTTON_LEFTRIGHT; break;
@@ -1566,6 +1587,14 @@ void RSDK::DevMenu_DebugOptionsMenu()
 
     confirm |= controller[CONT_ANY].keyStart.press;
 
+#if RETRO_USE_PROFILER
+    // the class costs page sits between the viewable variables & "Back"
+    const int32 classCostsID = viewableVarCount;
+    const int32 backID       = viewableVarCount + 1;
+#else
+    const int32 backID = viewableVarCount;
+#endif
+
     for (int32 i = 0; i < 8; ++i) {
         if (devMenu.scrollPos + i < viewableVarCount) {
             ViewableVariable *value = &viewableVarList[devMenu.scrollPos + i];
@@ -1679,13 +1708,20 @@ void RSDK::DevMenu_DebugOptionsMenu()
             dy += 8;
         }
         else {
+#if RETRO_USE_PROFILER
+            if (devMenu.scrollPos + i == classCostsID) {
+                DrawDevString("Class Costs", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[i]);
+                dy += 8;
+                continue;
+            }
+#endif
             DrawDevString("Back", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[i]);
         }
     }
 
     if (controller[CONT_ANY].keyUp.press) {
         if (--devMenu.selection < 0)
-            devMenu.selection = viewableVarCount;
+            devMenu.selection = backID;
 
         if (devMenu.selection >= devMenu.scrollPos) {
             if (devMenu.selection > devMenu.scrollPos + 7)
@@ -1699,7 +1735,7 @@ void RSDK::DevMenu_DebugOptionsMenu()
     }
     else if (controller[CONT_ANY].keyUp.down) {
         if (!devMenu.timer && --devMenu.selection < 0)
-            devMenu.selection = viewableVarCount;
+            devMenu.selection = backID;
 
         devMenu.timer = (devMenu.timer + 1) & 7;
 
@@ -1713,7 +1749,7 @@ void RSDK::DevMenu_DebugOptionsMenu()
     }
 
     if (controller[CONT_ANY].keyDown.press) {
-        if (++devMenu.selection > viewableVarCount)
+        if (++devMenu.selection > backID)
             devMenu.selection = 0;
 
         if (devMenu.selection >= devMenu.scrollPos) {
@@ -1727,7 +1763,7 @@ void RSDK::DevMenu_DebugOptionsMenu()
         devMenu.timer = 1;
     }
     else if (controller[CONT_ANY].keyDown.down) {
-        if (!devMenu.timer && ++devMenu.selection >= viewableVarCount)
+        if (!devMenu.timer && ++devMenu.selection >= backID)
             devMenu.selection = 0;
 
         devMenu.timer = (devMenu.timer + 1) & 7;
@@ -1804,6 +1840,15 @@ void RSDK::DevMenu_DebugOptionsMenu()
             }
         }
     }
+#if RETRO_USE_PROFILER
+    else if (devMenu.selection == classCostsID) {
+        if (confirm) {
+            devMenu.state     = DevMenu_ClassCostsMenu;
+            devMenu.selection = 0;
+            devMenu.scrollPos = 0;
+        }
+    }
+#endif
     else {
         if (confirm) {
             devMenu.state     = DevMenu_OptionsMenu;
@@ -1823,6 +1868,123 @@ void RSDK::DevMenu_DebugOptionsMenu()
     }
 #endif
 }
+
+#if RETRO_USE_PROFILER
+void RSDK::DevMenu_ClassCostsMenu()
+{
+    const char *sortNames[] = { "TOTAL", "UPDATE", "LATE UPDATE", "STATIC UPDATE", "DRAW", "CREATE", "CALLS" };
+
+    uint16 sortedIDs[OBJECT_COUNT];
+    int32 count = SortProfilerClasses(sortedIDs, profiler.classSortMode);
+    if (devMenu.selection >= count)
+        devMenu.selection = count ? count - 1 : 0;
+    if (devMenu.scrollPos > devMenu.selection)
+        devMenu.scrollPos = devMenu.selection;
+
+    int32 dy = currentScreen->center.y;
+    DrawRectangle(currentScreen->center.x - 128, dy - 84, 0x100, 0x30, 0x80, 0xFF, INK_NONE, true);
+
+    dy -= 72;
+    DrawDevString("CLASS COSTS", currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
+
+    char buffer[0x40];
+    dy += 12;
+    sprintf_s(buffer, sizeof(buffer), "< SORT: %s >", sortNames[profiler.classSortMode]);
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F080);
+
+    dy += 12;
+    sprintf_s(buffer, sizeof(buffer), "%u FRAMES%s", profiler.classStatFrames, profiler.trackClasses ? "" : " (PAUSED)");
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0x808090);
+
+    dy += 32;
+    DrawRectangle(currentScreen->center.x - 128, dy - 4, 0x100, 0x48, 0x80, 0xFF, INK_NONE, true);
+
+    if (!count) {
+        DrawDevString("No data, enable \"Class Costs\"", currentScreen->center.x, dy + 24, ALIGN_CENTER, 0x808090);
+        DrawDevString("in the debug flags & play a bit", currentScreen->center.x, dy + 32, ALIGN_CENTER, 0x808090);
+    }
+
+    uint32 frames = profiler.classStatFrames ? profiler.classStatFrames : 1;
+    for (int32 i = 0; i < 8 && devMenu.scrollPos + i < count; ++i) {
+        uint16 classID = sortedIDs[devMenu.scrollPos + i];
+        uint32 color   = devMenu.scrollPos + i == devMenu.selection ? 0xF0F0F0 : 0x808090;
+
+        sprintf_s(buffer, sizeof(buffer), "%.16s", objectClassList[classID].name);
+        DrawDevString(buffer, currentScreen->center.x - 120, dy, ALIGN_LEFT, color);
+
+        uint64 value = GetProfilerClassSortValue(classID, profiler.classSortMode);
+        if (profiler.classSortMode == PROFILER_SORT_CALLS)
+            sprintf_s(buffer, sizeof(buffer), "%llu", (unsigned long long)value);
+        else
+            sprintf_s(buffer, sizeof(buffer), "%.3fms/f", value / (frames * 1000000.0));
+        DrawDevString(buffer, currentScreen->center.x + 120, dy, ALIGN_RIGHT, 0xF0F080);
+
+        dy += 8;
+    }
+
+    DrawDevString("CONFIRM: SAVE CSV  X: RESET", currentScreen->center.x, currentScreen->center.y + 52, ALIGN_CENTER, 0x808090);
+
+    DevMenu_HandleTouchControls(CORNERBUTTON_LEFTRIGHT);
+
+    if (controller[CONT_ANY].keyUp.press) {
+        if (--devMenu.selection < 0)
+            devMenu.selection = count ? count - 1 : 0;
+
+        devMenu.timer = 1;
+    }
+    else if (controller[CONT_ANY].keyUp.down) {
+        if (!devMenu.timer && --devMenu.selection < 0)
+            devMenu.selection = count ? count - 1 : 0;
+
+        devMenu.timer = (devMenu.timer + 1) & 7;
+    }
+
+    if (controller[CONT_ANY].keyDown.press) {
+        if (++devMenu.selection >= count)
+            devMenu.selection = 0;
+
+        devMenu.timer = 1;
+    }
+    else if (controller[CONT_ANY].keyDown.down) {
+        if (!devMenu.timer && ++devMenu.selection >= count)
+            devMenu.selection = 0;
+
+        devMenu.timer = (devMenu.timer + 1) & 7;
+    }
+
+    if (devMenu.selection >= devMenu.scrollPos) {
+        if (devMenu.selection > devMenu.scrollPos + 7)
+            devMenu.scrollPos = devMenu.selection - 7;
+    }
+    else {
+        devMenu.scrollPos = devMenu.selection;
+    }
+
+    if (controller[CONT_ANY].keyLeft.press)
+        profiler.classSortMode = (profiler.classSortMode + PROFILER_SORT_COUNT - 1) % PROFILER_SORT_COUNT;
+    else if (controller[CONT_ANY].keyRight.press)
+        profiler.classSortMode = (profiler.classSortMode + 1) % PROFILER_SORT_COUNT;
+
+    bool32 swap    = SKU::userCore->GetConfirmButtonFlip();
+    bool32 confirm = swap ? controller[CONT_ANY].keyB.press : controller[CONT_ANY].keyA.press;
+    confirm |= controller[CONT_ANY].keyStart.press;
+
+    if (confirm)
+        DumpProfilerClassStats();
+
+    if (controller[CONT_ANY].keyX.press) {
+        ResetProfilerClassStats();
+        devMenu.selection = 0;
+        devMenu.scrollPos = 0;
+    }
+
+    if (swap ? controller[CONT_ANY].keyA.press : controller[CONT_ANY].keyB.press) {
+        devMenu.state     = DevMenu_DebugOptionsMenu;
+        devMenu.selection = viewableVarCount;
+        devMenu.scrollPos = devMenu.selection > 7 ? devMenu.selection - 7 : 0;
+    }
+}
+#endif
 #endif
 
 #if RETRO_USE_MOD_LOADER
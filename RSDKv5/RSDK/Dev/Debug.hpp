@@ -133,6 +133,9 @@ void DevMenu_InputOptionsMenu();
 void DevMenu_KeyMappingsMenu();
 #if RETRO_REV02
 void DevMenu_DebugOptionsMenu();
+#if RETRO_USE_PROFILER
+void DevMenu_ClassCostsMenu();
+#endif
 #endif
 #if RETRO_USE_MOD_LOADER
 void DevMenu_ModsMenu();
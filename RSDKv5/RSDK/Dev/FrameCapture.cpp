@@ -0,0 +1,390 @@
+#include "RSDK/Core/RetroEngine.hpp"
+
+#if !RETRO_USE_ORIGINAL_CODE
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace RSDK;
+
+FrameCapture RSDK::frameCapture;
+
+// a frame waiting to be written, every active screen's pixels are stored back to back without any pitch padding
+struct FrameCaptureSlot {
+    uint32 frameID;
+    int32 screenCount;
+    uint16 width[SCREEN_COUNT];
+    uint16 height[SCREEN_COUNT];
+    uint16 *pixels;
+    int32 pixelStorage;
+};
+
+// the writer's copy of the last frame written for each screen, the deltas are taken against it
+struct FrameCapturePrevScreen {
+    uint16 *pixels;
+    uint16 width;
+    uint16 height;
+};
+
+static FrameCaptureSlot captureSlots[FRAMECAPTURE_QUEUE_SIZE];
+static int32 captureReadPos = 0;
+static int32 captureQueued  = 0;
+static bool32 captureQuit   = false;
+static bool32 captureFailed = false;
+static std::thread captureThread;
+static std::mutex captureLock;
+static std::condition_variable captureCond;
+
+// only touched by the writer thread
+static FrameCapturePrevScreen capturePrevScreens[SCREEN_COUNT];
+static uint8 *captureDeltaBuffer  = NULL;
+static uint32 captureDeltaStorage = 0;
+static uint8 *captureOutBuffer    = NULL;
+static uint32 captureOutStorage   = 0;
+
+// 64-bit FNV-1a over the screen's size & pixels
+static uint64 HashCapturedScreen(const uint16 *pixels, int32 width, int32 height)
+{
+    uint64 hash = HASH_INIT_FNV64;
+    hash        = HashStepFNV64(hash, (uint64)width);
+    hash        = HashStepFNV64(hash, (uint64)height);
+
+    return HashWordsFNV64(hash, pixels, width * height);
+}
+
+// Grows a buffer to at least the given size, returns false if it couldn't
+static bool32 ReserveCaptureBuffer(uint8 **buffer, uint32 *storage, uint32 size)
+{
+    if (*storage >= size)
+        return true;
+
+    uint8 *newBuffer = (uint8 *)realloc(*buffer, size);
+    if (!newBuffer)
+        return false;
+
+    *buffer  = newBuffer;
+    *storage = size;
+    return true;
+}
+
+// Encodes & writes one screen of a frame, returns false if the file couldn't be written
+static bool32 WriteCapturedScreen(int32 screenID, const uint16 *pixels, int32 width, int32 height, uint64 hash)
+{
+    FrameCapturePrevScreen *prev = &capturePrevScreens[screenID];
+    int32 count                  = width * height;
+
+    if (prev->width != width || prev->height != height || !prev->pixels) {
+        uint16 *newPixels = (uint16 *)realloc(prev->pixels, count * sizeof(uint16));
+        if (!newPixels)
+            return false;
+
+        prev->pixels = newPixels;
+        prev->width  = width;
+        prev->height = height;
+        memset(prev->pixels, 0, count * sizeof(uint16));
+    }
+
+    uint32 maskSize = ((height + 15) / 16) * sizeof(uint16); // keeps the rows 2 byte aligned
+    uint32 rowSize  = width * sizeof(uint16);
+    if (!ReserveCaptureBuffer(&captureDeltaBuffer, &captureDeltaStorage, maskSize + rowSize * height))
+        return false;
+
+    uint8 *mask = captureDeltaBuffer;
+    uint8 *rows = captureDeltaBuffer + maskSize;
+    memset(mask, 0, maskSize);
+
+    uint32 deltaSize = maskSize;
+    for (int32 y = 0; y < height; ++y) {
+        const uint16 *row = &pixels[y * width];
+        uint16 *prevRow   = &prev->pixels[y * width];
+        if (!memcmp(row, prevRow, rowSize))
+            continue;
+
+        mask[y >> 3] |= 1 << (y & 7);
+
+        uint16 *delta = (uint16 *)&rows[deltaSize - maskSize];
+        for (int32 x = 0; x < width; ++x) delta[x] = row[x] ^ prevRow[x];
+        memcpy(prevRow, row, rowSize);
+
+        deltaSize += rowSize;
+    }
+
+    mz_ulong outSize = mz_compressBound(deltaSize);
+    if (!ReserveCaptureBuffer(&captureOutBuffer, &captureOutStorage, (uint32)outSize))
+        return false;
+
+    if (mz_compress2(captureOutBuffer, &outSize, captureDeltaBuffer, deltaSize, MZ_BEST_SPEED) != MZ_OK)
+        return false;
+
+    FrameCaptureScreen info;
+    info.width    = width;
+    info.height   = height;
+    info.dataSize = (uint32)outSize;
+    info.hash     = hash;
+    if (fWrite(&info, sizeof(info), 1, frameCapture.file) != 1 || fWrite(captureOutBuffer, 1, outSize, frameCapture.file) != outSize)
+        return false;
+
+    frameCapture.rawSize += rowSize * height;
+    frameCapture.compressedSize += sizeof(info) + outSize;
+    return true;
+}
+
+// Hashes & writes a queued frame, runs on the writer thread
+static bool32 WriteCapturedFrame(FrameCaptureSlot *slot)
+{
+    uint64 hashes[SCREEN_COUNT];
+    char line[0x20 + SCREEN_COUNT * 0x12];
+    int32 len = sprintf_s(line, sizeof(line), "%u", slot->frameID);
+
+    const uint16 *pixels = slot->pixels;
+    for (int32 s = 0; s < slot->screenCount; ++s) {
+        hashes[s] = HashCapturedScreen(pixels, slot->width[s], slot->height[s]);
+        len += sprintf_s(&line[len], sizeof(line) - len, " %016llx", (unsigned long long)hashes[s]);
+        pixels += slot->width[s] * slot->height[s];
+    }
+    line[len++] = '\n';
+
+    if (frameCapture.hashFile && fWrite(line, 1, len, frameCapture.hashFile) != (size_t)len)
+        return false;
+
+    if (frameCapture.file) {
+        FrameCaptureFrame frame;
+        frame.frameID     = slot->frameID;
+        frame.screenCount = slot->screenCount;
+        if (fWrite(&frame, sizeof(frame), 1, frameCapture.file) != 1)
+            return false;
+        frameCapture.compressedSize += sizeof(frame);
+
+        pixels = slot->pixels;
+        for (int32 s = 0; s < slot->screenCount; ++s) {
+            if (!WriteCapturedScreen(s, pixels, slot->width[s], slot->height[s], hashes[s]))
+                return false;
+            pixels += slot->width[s] * slot->height[s];
+        }
+    }
+
+    return true;
+}
+
+static void FrameCaptureThread()
+{
+    while (true) {
+        FrameCaptureSlot *slot = NULL;
+        {
+            std::unique_lock<std::mutex> lock(captureLock);
+            captureCond.wait(lock, [] { return captureQuit || captureQueued > 0; });
+            if (!captureQueued)
+                break;
+
+            slot = &captureSlots[captureReadPos];
+        }
+
+        // keep draining the queue after a failure so the main thread never blocks on it, the frames just aren't written
+        if (!captureFailed && !WriteCapturedFrame(slot))
+            captureFailed = true;
+
+        {
+            std::lock_guard<std::mutex> lock(captureLock);
+            captureReadPos = (captureReadPos + 1) % FRAMECAPTURE_QUEUE_SIZE;
+            --captureQueued;
+        }
+        captureCond.notify_all();
+    }
+}
+
+// Opens the files & starts the writer, returns false if capturing isn't possible
+static bool32 StartFrameCapture()
+{
+    char hashPath[0x120];
+    if (frameCapture.mode == FRAMECAPTURE_VIDEO) {
+        frameCapture.file = fOpen(frameCapture.filePath, "wb");
+        if (!frameCapture.file) {
+            PrintLog(PRINT_NORMAL, "[Capture] Unable to open %s", frameCapture.filePath);
+            return false;
+        }
+
+        // frameCount gets filled in by StopFrameCapture
+        FrameCaptureHeader header;
+        header.signature  = FRAMECAPTURE_SIGNATURE;
+        header.version    = FRAMECAPTURE_VERSION;
+        header.reserved   = 0;
+        header.frameCount = 0;
+        fWrite(&header, sizeof(header), 1, frameCapture.file);
+        frameCapture.compressedSize = sizeof(header);
+
+        sprintf_s(hashPath, sizeof(hashPath), "%s.txt", frameCapture.filePath);
+    }
+    else {
+        sprintf_s(hashPath, sizeof(hashPath), "%s", frameCapture.filePath);
+    }
+
+    frameCapture.hashFile = fOpen(hashPath, "wb");
+    if (!frameCapture.hashFile) {
+        PrintLog(PRINT_NORMAL, "[Capture] Unable to open %s", hashPath);
+        if (frameCapture.file)
+            fClose(frameCapture.file);
+        frameCapture.file = NULL;
+        return false;
+    }
+
+    captureReadPos = 0;
+    captureQueued  = 0;
+    captureQuit    = false;
+    captureFailed  = false;
+    captureThread  = std::thread(FrameCaptureThread);
+
+    if (frameCapture.mode == FRAMECAPTURE_VIDEO)
+        PrintLog(PRINT_NORMAL, "[Capture] Capturing frames to %s (hashes in %s)", frameCapture.filePath, hashPath);
+    else
+        PrintLog(PRINT_NORMAL, "[Capture] Writing frame hashes to %s", hashPath);
+
+    return true;
+}
+
+void RSDK::SetupFrameCapture(const char *path, uint8 mode)
+{
+    int32 c = 0;
+    while (path[c] && path[c] != ';' && c < (int32)sizeof(frameCapture.filePath) - 1) {
+        frameCapture.filePath[c] = path[c];
+        ++c;
+    }
+    frameCapture.filePath[c] = 0;
+
+    frameCapture.mode = mode;
+}
+
+void RSDK::UpdateFrameCapture()
+{
+    if (frameCapture.mode == FRAMECAPTURE_NONE)
+        return;
+
+    if (!frameCapture.started) {
+        if (!StartFrameCapture()) {
+            frameCapture.mode = FRAMECAPTURE_NONE;
+            return;
+        }
+        frameCapture.started = true;
+    }
+
+    FrameCaptureSlot *slot = NULL;
+    {
+        std::unique_lock<std::mutex> lock(captureLock);
+        if (captureQueued == FRAMECAPTURE_QUEUE_SIZE) {
+            ++frameCapture.stallCount;
+            captureCond.wait(lock, [] { return captureQueued < FRAMECAPTURE_QUEUE_SIZE; });
+        }
+
+        // the writer never touches a slot that isn't queued, so this one's ours until it's handed over below
+        slot = &captureSlots[(captureReadPos + captureQueued) % FRAMECAPTURE_QUEUE_SIZE];
+    }
+
+    int32 screenCount = CLAMP(videoSettings.screenCount, 1, SCREEN_COUNT);
+    int32 count       = 0;
+    for (int32 s = 0; s < screenCount; ++s) count += screens[s].size.x * screens[s].size.y;
+
+    if (slot->pixelStorage < count) {
+        uint16 *pixels = (uint16 *)realloc(slot->pixels, count * sizeof(uint16));
+        if (!pixels) {
+            PrintLog(PRINT_NORMAL, "[Capture] Out of memory, stopping");
+            StopFrameCapture();
+            return;
+        }
+
+        slot->pixels       = pixels;
+        slot->pixelStorage = count;
+    }
+
+    slot->frameID     = frameCapture.frameCount++;
+    slot->screenCount = screenCount;
+
+    uint16 *pixels = slot->pixels;
+    for (int32 s = 0; s < screenCount; ++s) {
+        ScreenInfo *screen = &screens[s];
+        slot->width[s]     = screen->size.x;
+        slot->height[s]    = screen->size.y;
+
+        for (int32 y = 0; y < screen->size.y; ++y) {
+            memcpy(pixels, &screen->frameBuffer[y * screen->pitch], screen->size.x * sizeof(uint16));
+            pixels += screen->size.x;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(captureLock);
+        ++captureQueued;
+    }
+    captureCond.notify_all();
+}
+
+void RSDK::StopFrameCapture()
+{
+    if (!frameCapture.started) {
+        frameCapture.mode = FRAMECAPTURE_NONE;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(captureLock);
+        captureQuit = true;
+    }
+    captureCond.notify_all();
+    captureThread.join();
+
+    if (captureFailed)
+        PrintLog(PRINT_NORMAL, "[Capture] Failed to write %s, the capture is incomplete", frameCapture.filePath);
+
+    if (frameCapture.file) {
+        FrameCaptureHeader header;
+        header.signature  = FRAMECAPTURE_SIGNATURE;
+        header.version    = FRAMECAPTURE_VERSION;
+        header.reserved   = 0;
+        header.frameCount = frameCapture.frameCount;
+
+        fSeek(frameCapture.file, 0, SEEK_SET);
+        fWrite(&header, sizeof(header), 1, frameCapture.file);
+        fClose(frameCapture.file);
+
+        uint64 rawSize        = frameCapture.rawSize;
+        uint64 compressedSize = frameCapture.compressedSize;
+        PrintLog(PRINT_NORMAL, "[Capture] Captured %d frames to %s, %.2fMB raw -> %.2fMB (%.1f%%), waited on the writer %d times",
+                 frameCapture.frameCount, frameCapture.filePath, rawSize / (1024.0 * 1024.0), compressedSize / (1024.0 * 1024.0),
+                 rawSize ? compressedSize * 100.0 / rawSize : 0.0, (uint32)frameCapture.stallCount);
+    }
+    else {
+        PrintLog(PRINT_NORMAL, "[Capture] Wrote %d frame hashes to %s", frameCapture.frameCount, frameCapture.filePath);
+    }
+    frameCapture.file = NULL;
+
+    if (frameCapture.hashFile)
+        fClose(frameCapture.hashFile);
+    frameCapture.hashFile = NULL;
+
+    for (int32 i = 0; i < FRAMECAPTURE_QUEUE_SIZE; ++i) {
+        if (captureSlots[i].pixels)
+            free(captureSlots[i].pixels);
+        captureSlots[i].pixels       = NULL;
+        captureSlots[i].pixelStorage = 0;
+    }
+
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) {
+        if (capturePrevScreens[s].pixels)
+            free(capturePrevScreens[s].pixels);
+        capturePrevScreens[s].pixels = NULL;
+        capturePrevScreens[s].width  = 0;
+        capturePrevScreens[s].height = 0;
+    }
+
+    if (captureDeltaBuffer)
+        free(captureDeltaBuffer);
+    captureDeltaBuffer  = NULL;
+    captureDeltaStorage = 0;
+
+    if (captureOutBuffer)
+        free(captureOutBuffer);
+    captureOutBuffer  = NULL;
+    captureOutStorage = 0;
+
+    frameCapture.started = false;
+    frameCapture.mode    = FRAMECAPTURE_NONE;
+}
+#endif
@@ -0,0 +1,84 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+// Frame-exact capture of the screens' frame buffers, taken right after ProcessEngine() has drawn them, so no GPU readback is involved
+// capture=<file> writes the frames to <file> & their hashes to <file>.txt, framehashes=<file> only writes the hashes
+// Paired with replay= or benchmark= this gives repeatable baselines to compare renderer changes against: identical hash files mean
+// identical output
+//
+// The main thread only copies each frame into a queue, the hashing, delta encoding, compression & file writes happen on a writer thread
+// (if the writer falls behind the main thread waits for it rather than dropping frames)
+//
+// Video file layout:
+//   FrameCaptureHeader
+//   per frame: FrameCaptureFrame, then per screen: FrameCaptureScreen followed by dataSize bytes of deflate (zlib) data
+// Once inflated, a screen's data is a bitmask of the rows that changed since the previous frame (((height + 15) / 16) * 2 bytes,
+// lowest bit first), followed by each changed row's RGB565 pixels XOR'd with the same row of the previous frame
+// The "previous frame" is all zeroes for a screen's first frame or whenever its size changes
+// Hash lines are "<frame> <hash of screen 0> <hash of screen 1>...", the hashes being 64-bit FNV-1a over the screen size & pixels
+
+#if !RETRO_USE_ORIGINAL_CODE
+#include <atomic>
+#endif
+
+#define FRAMECAPTURE_SIGNATURE  (0x35434652) // "RFC5"
+#define FRAMECAPTURE_VERSION    (1)
+#define FRAMECAPTURE_QUEUE_SIZE (8)
+
+namespace RSDK
+{
+
+#if !RETRO_USE_ORIGINAL_CODE
+enum FrameCaptureModes {
+    FRAMECAPTURE_NONE,
+    FRAMECAPTURE_HASHES,
+    FRAMECAPTURE_VIDEO,
+};
+
+struct FrameCaptureHeader {
+    uint32 signature;
+    uint16 version;
+    uint16 reserved;
+    uint32 frameCount;
+};
+
+struct FrameCaptureFrame {
+    uint32 frameID;
+    uint32 screenCount;
+};
+
+struct FrameCaptureScreen {
+    uint16 width;
+    uint16 height;
+    uint32 dataSize;
+    uint64 hash;
+};
+
+struct FrameCapture {
+    uint8 mode = FRAMECAPTURE_NONE;
+    char filePath[0x100];
+
+    FileIO *file      = NULL;
+    FileIO *hashFile  = NULL;
+    uint32 frameCount = 0;
+    bool32 started    = false;
+
+    // stats
+    std::atomic<uint64> rawSize{ 0 };        // uncompressed frame size, in bytes
+    std::atomic<uint64> compressedSize{ 0 }; // everything written to the video file, in bytes
+    std::atomic<uint32> stallCount{ 0 };     // frames the main thread had to wait for the writer on
+};
+
+extern FrameCapture frameCapture;
+
+// called by ParseArguments, the files are opened once the first frame has been drawn
+void SetupFrameCapture(const char *path, uint8 mode);
+// queues the frame that was just drawn, called once per engine frame
+void UpdateFrameCapture();
+// flushes the queue & finalizes the files
+void StopFrameCapture();
+#endif
+
+} // namespace RSDK
+
+#endif // !FRAMECAPTURE_H
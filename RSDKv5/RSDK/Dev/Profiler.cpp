@@ -0,0 +1,417 @@
+#include "RSDK/Core/RetroEngine.hpp"
+
+using namespace RSDK;
+
+#if RETRO_USE_PROFILER
+ProfilerInfo RSDK::profiler;
+
+const char *profilerZoneNames[] = { "Frame", "Engine", "Input", "Input Wait", "Objects", "Draw Lists", "Copy Frame", "Flip Screen", "Audio" };
+const char *profilerCallbackNames[] = { "update", "lateUpdate", "staticUpdate", "draw", "create" };
+
+uint32 profilerZoneColors[] = { 0xF0F0F0, 0x808080, 0xF0F000, 0x808000, 0x00C0F0, 0x00F000, 0xF08000, 0xF00000, 0xC000F0 };
+
+// Appends an event to the capture buffer, safe to call from the audio thread
+static void AddProfilerEvent(const char *name, const char *category, int64 start, int64 end, uint8 threadID)
+{
+    int32 id = profiler.eventCount.fetch_add(1);
+    if (id < PROFILER_EVENT_COUNT) {
+        ProfilerEvent *event = &profiler.events[id];
+        event->name          = name;
+        event->category      = category;
+        event->start         = start - profiler.captureBase;
+        event->duration      = end - start;
+        event->threadID      = threadID;
+    }
+}
+
+static void StartProfilerCapture()
+{
+    if (!profiler.events)
+        profiler.events = (ProfilerEvent *)malloc(PROFILER_EVENT_COUNT * sizeof(ProfilerEvent));
+
+    if (profiler.events) {
+        profiler.eventCount  = 0;
+        profiler.captureBase = GetProfilerTimestamp();
+        profiler.capturing   = true;
+        PrintLog(PRINT_NORMAL, "[Profiler] Capture started");
+    }
+    else {
+        profiler.capture = false;
+    }
+}
+
+// Writes the capture out in the chrome trace event format (chrome://tracing, perfetto, speedscope, etc)
+static void StopProfilerCapture()
+{
+    // stop appending first, the audio thread could still be pushing events
+    profiler.capturing = false;
+    profiler.capture   = false;
+
+    int32 count = profiler.eventCount.exchange(PROFILER_EVENT_COUNT);
+    if (count > PROFILER_EVENT_COUNT)
+        count = PROFILER_EVENT_COUNT;
+
+    char path[sizeof(SKU::userFileDir) + 0x10];
+    sprintf_s(path, sizeof(path), "%sprofile.json", SKU::userFileDir);
+
+    FileIO *file = fOpen(path, "w");
+    if (file) {
+        char buffer[0x200];
+        int32 len = sprintf_s(buffer, sizeof(buffer), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        fWrite(buffer, 1, len, file);
+
+        len = sprintf_s(buffer, sizeof(buffer),
+                        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}},\n"
+                        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Audio\"}}");
+        fWrite(buffer, 1, len, file);
+
+        for (int32 e = 0; e < count; ++e) {
+            ProfilerEvent *event = &profiler.events[e];
+            len = sprintf_s(buffer, sizeof(buffer), ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                            event->name ? event->name : "?", event->category, event->start / 1000.0, event->duration / 1000.0, event->threadID);
+            fWrite(buffer, 1, len, file);
+        }
+
+        len = sprintf_s(buffer, sizeof(buffer), "\n]}\n");
+        fWrite(buffer, 1, len, file);
+        fClose(file);
+
+        PrintLog(PRINT_NORMAL, "[Profiler] Wrote %d events to %s", count, path);
+    }
+    else {
+        PrintLog(PRINT_NORMAL, "[Profiler] Failed to open %s for writing", path);
+    }
+}
+
+void RSDK::BeginProfilerFrame()
+{
+    int64 now = GetProfilerTimestamp();
+
+    if (profiler.enabled) {
+        // finish off the frame we've been accumulating
+        profiler.zoneTime[PROFILE_FRAME] = now - profiler.frameStart;
+        profiler.zoneTime[PROFILE_AUDIO] = profiler.audioTime.exchange(0);
+
+        ProfilerFrame *frame = &profiler.frames[profiler.frameID % PROFILER_FRAME_COUNT];
+        for (int32 z = 0; z < PROFILE_ZONE_COUNT; ++z) frame->zoneTime[z] = (uint32)(profiler.zoneTime[z] / 1000);
+        for (int32 g = 0; g < DRAWGROUP_COUNT; ++g) frame->drawGroupTime[g] = (uint32)(profiler.drawGroupTime[g] / 1000);
+        memcpy(profiler.lastClassTime, profiler.classTime, sizeof(profiler.classTime));
+        profiler.frameID++;
+
+        if (profiler.trackClasses)
+            profiler.classStatFrames++;
+
+        if (profiler.capturing)
+            AddProfilerEvent(profilerZoneNames[PROFILE_FRAME], "frame", profiler.frameStart, now, 0);
+    }
+
+    if (profiler.capture && !profiler.capturing)
+        StartProfilerCapture();
+    else if (profiler.capturing && (!profiler.capture || profiler.eventCount >= PROFILER_EVENT_COUNT))
+        StopProfilerCapture();
+
+    bool active = profiler.overlayMode != PROFILER_OVERLAY_NONE || profiler.capturing || profiler.trackClasses;
+    if (active && !profiler.enabled) {
+        // throw out whatever the audio thread left behind from before we were enabled
+        profiler.audioTime = 0;
+        memset(profiler.lastClassTime, 0, sizeof(profiler.lastClassTime));
+    }
+
+    memset(profiler.zoneTime, 0, sizeof(profiler.zoneTime));
+    memset(profiler.drawGroupTime, 0, sizeof(profiler.drawGroupTime));
+    memset(profiler.classTime, 0, sizeof(profiler.classTime));
+
+    profiler.enabled    = active;
+    profiler.frameStart = now;
+}
+
+void RSDK::EndProfilerZone(uint8 zone, int64 start)
+{
+    int64 end = GetProfilerTimestamp();
+
+    if (zone == PROFILE_AUDIO)
+        profiler.audioTime += end - start;
+    else
+        profiler.zoneTime[zone] += end - start;
+
+    if (profiler.capturing)
+        AddProfilerEvent(profilerZoneNames[zone], "zone", start, end, zone == PROFILE_AUDIO);
+}
+
+void RSDK::EndProfilerClass(uint16 classID, uint8 callback, int64 start)
+{
+    int64 end = GetProfilerTimestamp();
+
+    profiler.classTime[classID][callback] += end - start;
+
+    if (profiler.trackClasses) {
+        ProfilerClassStats *stats = &profiler.classStats[classID];
+        stats->calls[callback]++;
+        stats->time[callback] += end - start;
+    }
+
+    if (profiler.capturing)
+        AddProfilerEvent(objectClassList[classID].name, profilerCallbackNames[callback], start, end, 0);
+}
+
+void RSDK::EndProfilerDrawGroup(uint8 group, int64 start)
+{
+    int64 end = GetProfilerTimestamp();
+
+    profiler.drawGroupTime[group] += end - start;
+
+    if (profiler.capturing)
+        AddProfilerEvent(drawGroupNames[group], "drawGroup", start, end, 0);
+}
+
+void RSDK::DrawProfilerOverlay()
+{
+    if (profiler.overlayMode == PROFILER_OVERLAY_NONE || !profiler.frameID)
+        return;
+
+    // stacked bars for the (mostly) non-overlapping zones, "Engine" being whatever ProcessEngine spent outside of objects, draw lists & the
+    // input latch's wait
+    const int32 stackZones[] = { PROFILE_INPUT, PROFILE_ENGINE, PROFILE_INPUTWAIT, PROFILE_OBJECTS, PROFILE_DRAWLISTS, PROFILE_COPYFRAMEBUFFER, PROFILE_FLIPSCREEN };
+    const int32 stackCount   = sizeof(stackZones) / sizeof(stackZones[0]);
+
+    const int32 graphFrames = 0x80;
+    const int32 graphW      = graphFrames * 2;
+    const int32 graphH      = 64;
+    const int32 graphX      = 8;
+    const int32 graphY      = currentScreen->size.y - graphH - 8;
+    const uint32 graphRange = 33333; // 2 frames @ 60hz covers the full height
+
+    uint32 frameTarget = 1000000 / (videoSettings.refreshRate ? videoSettings.refreshRate : 60);
+
+    DrawRectangle(graphX, graphY, graphW, graphH, 0x000000, 0x80, INK_ALPHA, true);
+
+    int32 frameCount = profiler.frameID < graphFrames ? profiler.frameID : graphFrames;
+    for (int32 f = 0; f < frameCount; ++f) {
+        ProfilerFrame *frame = &profiler.frames[(profiler.frameID - frameCount + f) % PROFILER_FRAME_COUNT];
+        int32 x              = graphX + ((graphFrames - frameCount + f) << 1);
+
+        int32 y = graphY + graphH;
+        for (int32 z = 0; z < stackCount; ++z) {
+            uint32 time = frame->zoneTime[stackZones[z]];
+            if (stackZones[z] == PROFILE_ENGINE) {
+                uint32 inner = frame->zoneTime[PROFILE_INPUTWAIT] + frame->zoneTime[PROFILE_OBJECTS] + frame->zoneTime[PROFILE_DRAWLISTS];
+                time         = time > inner ? time - inner : 0;
+            }
+
+            int32 h = (int32)(time * graphH / graphRange);
+            if (h > y - graphY)
+                h = y - graphY;
+
+            if (h > 0) {
+                y -= h;
+                DrawRectangle(x, y, 2, h, profilerZoneColors[stackZones[z]], 0xFF, INK_NONE, true);
+            }
+        }
+
+        // the total frame time as a single dot, spikes past the top get pinned to it
+        int32 total = (int32)(frame->zoneTime[PROFILE_FRAME] * graphH / graphRange);
+        DrawRectangle(x, graphY + graphH - (total < graphH ? total : graphH), 2, 1, 0xF0F0F0, 0xFF, INK_NONE, true);
+    }
+
+    int32 targetY = graphY + graphH - (int32)(frameTarget * graphH / graphRange);
+    if (targetY > graphY)
+        DrawRectangle(graphX, targetY, graphW, 1, 0xF00000, 0x80, INK_ALPHA, true);
+
+    // averages over the last second or so
+    uint32 average[PROFILE_ZONE_COUNT];
+    uint32 worst = 0;
+    memset(average, 0, sizeof(average));
+
+    int32 avgCount = profiler.frameID < 60 ? profiler.frameID : 60;
+    for (int32 f = 0; f < avgCount; ++f) {
+        ProfilerFrame *frame = &profiler.frames[(profiler.frameID - 1 - f) % PROFILER_FRAME_COUNT];
+        for (int32 z = 0; z < PROFILE_ZONE_COUNT; ++z) average[z] += frame->zoneTime[z];
+
+        if (frame->zoneTime[PROFILE_FRAME] > worst)
+            worst = frame->zoneTime[PROFILE_FRAME];
+    }
+
+    char buffer[0x40];
+    int32 textY = graphY - 8 * (PROFILE_ZONE_COUNT + 1);
+    sprintf_s(buffer, sizeof(buffer), "worst: %.2fms", worst / 1000.0f);
+    DrawDevString(buffer, graphX, textY, ALIGN_LEFT, 0xF0F0F0);
+    textY += 8;
+
+    for (int32 z = 0; z < PROFILE_ZONE_COUNT; ++z) {
+        sprintf_s(buffer, sizeof(buffer), "%s: %.2fms", profilerZoneNames[z], average[z] / (avgCount * 1000.0f));
+        DrawDevString(buffer, graphX, textY, ALIGN_LEFT, profilerZoneColors[z]);
+        textY += 8;
+    }
+
+    if (profiler.overlayMode != PROFILER_OVERLAY_DETAILED)
+        return;
+
+    // draw groups & the most expensive classes from the last frame, down the right hand side
+    ProfilerFrame *last = &profiler.frames[(profiler.frameID - 1) % PROFILER_FRAME_COUNT];
+    int32 textX         = currentScreen->size.x - 8;
+    textY               = 8;
+
+    for (int32 g = 0; g < DRAWGROUP_COUNT; ++g) {
+        if (last->drawGroupTime[g]) {
+            sprintf_s(buffer, sizeof(buffer), "%.15s: %.2fms", drawGroupNames[g], last->drawGroupTime[g] / 1000.0f);
+            DrawDevString(buffer, textX, textY, ALIGN_RIGHT, 0x00F000);
+            textY += 8;
+        }
+    }
+    textY += 8;
+
+    sprintf_s(buffer, sizeof(buffer), "temp: %d/%d, %u overwritten", GetTempEntityUsage(), ENTITY_COUNT - tempEntityInfo.start,
+              tempEntityInfo.overwriteCount);
+    DrawDevString(buffer, textX, textY, ALIGN_RIGHT, tempEntityInfo.overwriteCount ? 0xF0C000 : 0xF0F0F0);
+    textY += 16;
+
+    const int32 topCount = 8;
+    int32 topClasses[topCount];
+    int64 topTimes[topCount];
+    for (int32 t = 0; t < topCount; ++t) {
+        topClasses[t] = -1;
+        topTimes[t]   = 0;
+    }
+
+    for (int32 o = 0; o < objectClassCount; ++o) {
+        int64 time = 0;
+        for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) time += profiler.lastClassTime[o][c];
+
+        for (int32 t = 0; t < topCount; ++t) {
+            if (time > topTimes[t]) {
+                for (int32 m = topCount - 1; m > t; --m) {
+                    topClasses[m] = topClasses[m - 1];
+                    topTimes[m]   = topTimes[m - 1];
+                }
+                topClasses[t] = o;
+                topTimes[t]   = time;
+                break;
+            }
+        }
+    }
+
+    for (int32 t = 0; t < topCount && topClasses[t] >= 0; ++t) {
+        sprintf_s(buffer, sizeof(buffer), "%s: %.3fms", objectClassList[topClasses[t]].name, topTimes[t] / 1000000.0f);
+        DrawDevString(buffer, textX, textY, ALIGN_RIGHT, 0x00C0F0);
+        textY += 8;
+    }
+}
+
+void RSDK::ResetProfilerClassStats()
+{
+    memset(profiler.classStats, 0, sizeof(profiler.classStats));
+    profiler.classStatFrames = 0;
+}
+
+uint64 RSDK::GetProfilerClassSortValue(uint16 classID, uint8 sortMode)
+{
+    ProfilerClassStats *stats = &profiler.classStats[classID];
+
+    switch (sortMode) {
+        default:
+        case PROFILER_SORT_TOTAL: {
+            uint64 total = 0;
+            for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) total += stats->time[c];
+            return total;
+        }
+
+        case PROFILER_SORT_UPDATE: return stats->time[PROFILE_CB_UPDATE];
+        case PROFILER_SORT_LATEUPDATE: return stats->time[PROFILE_CB_LATEUPDATE];
+        case PROFILER_SORT_STATICUPDATE: return stats->time[PROFILE_CB_STATICUPDATE];
+        case PROFILER_SORT_DRAW: return stats->time[PROFILE_CB_DRAW];
+        case PROFILER_SORT_CREATE: return stats->time[PROFILE_CB_CREATE];
+
+        case PROFILER_SORT_CALLS: {
+            uint64 total = 0;
+            for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) total += stats->calls[c];
+            return total;
+        }
+    }
+}
+
+int32 RSDK::SortProfilerClasses(uint16 *sortedIDs, uint8 sortMode)
+{
+    uint64 values[OBJECT_COUNT];
+    int32 count = 0;
+
+    for (int32 o = 0; o < objectClassCount; ++o) {
+        ProfilerClassStats *stats = &profiler.classStats[o];
+
+        uint64 calls = 0;
+        for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) calls += stats->calls[c];
+
+        if (calls) {
+            uint64 value = GetProfilerClassSortValue(o, sortMode);
+
+            // insertion sort, there's only ever a few hundred classes
+            int32 i = count++;
+            for (; i > 0 && values[i - 1] < value; --i) {
+                values[i]    = values[i - 1];
+                sortedIDs[i] = sortedIDs[i - 1];
+            }
+
+            values[i]    = value;
+            sortedIDs[i] = o;
+        }
+    }
+
+    return count;
+}
+
+void RSDK::DumpProfilerClassStats()
+{
+    uint16 sortedIDs[OBJECT_COUNT];
+    int32 count = SortProfilerClasses(sortedIDs, PROFILER_SORT_TOTAL);
+
+    char path[sizeof(SKU::userFileDir) + 0x10];
+    sprintf_s(path, sizeof(path), "%sclasscosts.csv", SKU::userFileDir);
+
+    FileIO *file = fOpen(path, "w");
+    if (file) {
+        char buffer[0x200];
+        int32 len = sprintf_s(buffer, sizeof(buffer), "class,frames,totalMS,msPerFrame");
+        fWrite(buffer, 1, len, file);
+
+        for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) {
+            len = sprintf_s(buffer, sizeof(buffer), ",%sCalls,%sMS", profilerCallbackNames[c], profilerCallbackNames[c]);
+            fWrite(buffer, 1, len, file);
+        }
+        fWrite("\n", 1, 1, file);
+
+        uint32 frames = profiler.classStatFrames ? profiler.classStatFrames : 1;
+        for (int32 i = 0; i < count; ++i) {
+            ProfilerClassStats *stats = &profiler.classStats[sortedIDs[i]];
+            uint64 total              = GetProfilerClassSortValue(sortedIDs[i], PROFILER_SORT_TOTAL);
+
+            len = sprintf_s(buffer, sizeof(buffer), "%s,%u,%.3f,%.4f", objectClassList[sortedIDs[i]].name, profiler.classStatFrames,
+                            total / 1000000.0, total / (frames * 1000000.0));
+            fWrite(buffer, 1, len, file);
+
+            for (int32 c = 0; c < PROFILE_CB_COUNT; ++c) {
+                len = sprintf_s(buffer, sizeof(buffer), ",%llu,%.3f", (unsigned long long)stats->calls[c], stats->time[c] / 1000000.0);
+                fWrite(buffer, 1, len, file);
+            }
+            fWrite("\n", 1, 1, file);
+        }
+
+        fClose(file);
+        PrintLog(PRINT_NORMAL, "[Profiler] Wrote costs for %d classes to %s", count, path);
+    }
+    else {
+        PrintLog(PRINT_NORMAL, "[Profiler] Failed to open %s for writing", path);
+    }
+}
+
+void RSDK::ReleaseProfiler()
+{
+    if (profiler.capturing)
+        StopProfilerCapture();
+
+    profiler.enabled = false;
+
+    if (profiler.events) {
+        free(profiler.events);
+        profiler.events = NULL;
+    }
+}
+#endif
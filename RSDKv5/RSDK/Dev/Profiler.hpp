@@ -0,0 +1,184 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Built-in frame profiler, see RETRO_USE_PROFILER
+// All the PROFILE_ macros compile to nothing when it's disabled
+
+#if RETRO_USE_PROFILER
+#include <atomic>
+#include <chrono>
+#endif
+
+#define PROFILER_FRAME_COUNT (0x100)
+#define PROFILER_EVENT_COUNT (0x40000)
+
+namespace RSDK
+{
+
+#if RETRO_USE_PROFILER
+enum ProfilerZones {
+    PROFILE_FRAME,
+    PROFILE_ENGINE,
+    PROFILE_INPUT,
+    PROFILE_INPUTWAIT, // the late input latch waiting for its target, it's inside PROFILE_ENGINE
+    PROFILE_OBJECTS,
+    PROFILE_DRAWLISTS,
+    PROFILE_COPYFRAMEBUFFER,
+    PROFILE_FLIPSCREEN,
+    PROFILE_AUDIO,
+    PROFILE_ZONE_COUNT,
+};
+
+enum ProfilerClassCallbacks {
+    PROFILE_CB_UPDATE,
+    PROFILE_CB_LATEUPDATE,
+    PROFILE_CB_STATICUPDATE,
+    PROFILE_CB_DRAW,
+    PROFILE_CB_CREATE,
+    PROFILE_CB_COUNT,
+};
+
+enum ProfilerClassSortModes {
+    PROFILER_SORT_TOTAL,
+    PROFILER_SORT_UPDATE,
+    PROFILER_SORT_LATEUPDATE,
+    PROFILER_SORT_STATICUPDATE,
+    PROFILER_SORT_DRAW,
+    PROFILER_SORT_CREATE,
+    PROFILER_SORT_CALLS,
+    PROFILER_SORT_COUNT,
+};
+
+enum ProfilerOverlayModes {
+    PROFILER_OVERLAY_NONE,
+    PROFILER_OVERLAY_GRAPH,
+    PROFILER_OVERLAY_DETAILED,
+};
+
+// all times are in microseconds
+struct ProfilerFrame {
+    uint32 zoneTime[PROFILE_ZONE_COUNT];
+    uint32 drawGroupTime[DRAWGROUP_COUNT];
+};
+
+// cumulative since the last reset, times are inclusive of anything the callback calls into (such as CreateEntity)
+struct ProfilerClassStats {
+    uint64 calls[PROFILE_CB_COUNT];
+    uint64 time[PROFILE_CB_COUNT]; // in nanoseconds
+};
+
+struct ProfilerEvent {
+    const char *name;
+    const char *category;
+    int64 start; // in nanoseconds
+    int64 duration;
+    uint8 threadID;
+};
+
+struct ProfilerInfo {
+    // exposed as viewable variables
+    uint8 overlayMode   = PROFILER_OVERLAY_NONE;
+    bool32 capture      = false;
+    bool32 trackClasses = false;
+
+    // checked by every scope, so it's the only thing that gets touched when the profiler is off
+    std::atomic<bool> enabled{ false };
+    std::atomic<bool> capturing{ false };
+
+    ProfilerFrame frames[PROFILER_FRAME_COUNT];
+    uint32 frameID    = 0;
+    int64 frameStart  = 0;
+    int64 captureBase = 0;
+
+    // accumulated over the current frame, in nanoseconds
+    int64 zoneTime[PROFILE_ZONE_COUNT];
+    int64 drawGroupTime[DRAWGROUP_COUNT];
+    int64 classTime[OBJECT_COUNT][PROFILE_CB_COUNT];
+    // the audio callback runs on its own thread
+    std::atomic<int64> audioTime{ 0 };
+
+    // per-class totals from the last completed frame
+    int64 lastClassTime[OBJECT_COUNT][PROFILE_CB_COUNT];
+
+    ProfilerClassStats classStats[OBJECT_COUNT];
+    uint32 classStatFrames = 0;
+    uint8 classSortMode    = PROFILER_SORT_TOTAL;
+
+    ProfilerEvent *events = NULL;
+    std::atomic<int32> eventCount{ 0 };
+};
+
+extern ProfilerInfo profiler;
+
+inline int64 GetProfilerTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BeginProfilerFrame();
+void EndProfilerZone(uint8 zone, int64 start);
+void EndProfilerClass(uint16 classID, uint8 callback, int64 start);
+void EndProfilerDrawGroup(uint8 group, int64 start);
+void DrawProfilerOverlay();
+void ReleaseProfiler();
+
+void ResetProfilerClassStats();
+uint64 GetProfilerClassSortValue(uint16 classID, uint8 sortMode);
+// fills sortedIDs with every class that's been called at least once, most expensive first
+int32 SortProfilerClasses(uint16 *sortedIDs, uint8 sortMode);
+void DumpProfilerClassStats();
+
+struct ProfilerZoneScope {
+    inline ProfilerZoneScope(uint8 zone) : zone(zone), start(profiler.enabled ? GetProfilerTimestamp() : 0) {}
+    inline ~ProfilerZoneScope()
+    {
+        if (start)
+            EndProfilerZone(zone, start);
+    }
+
+    uint8 zone;
+    int64 start;
+};
+
+struct ProfilerClassScope {
+    inline ProfilerClassScope(uint16 classID, uint8 callback)
+        : classID(classID), callback(callback), start(profiler.enabled ? GetProfilerTimestamp() : 0)
+    {
+    }
+    inline ~ProfilerClassScope()
+    {
+        if (start)
+            EndProfilerClass(classID, callback, start);
+    }
+
+    uint16 classID;
+    uint8 callback;
+    int64 start;
+};
+
+struct ProfilerDrawGroupScope {
+    inline ProfilerDrawGroupScope(uint8 group) : group(group), start(profiler.enabled ? GetProfilerTimestamp() : 0) {}
+    inline ~ProfilerDrawGroupScope()
+    {
+        if (start)
+            EndProfilerDrawGroup(group, start);
+    }
+
+    uint8 group;
+    int64 start;
+};
+
+#define PROFILE_BEGIN_FRAME()            BeginProfilerFrame()
+#define PROFILE_ZONE(zone)               ProfilerZoneScope profileZone(zone)
+#define PROFILE_CLASS(classID, callback) ProfilerClassScope profileClass(classID, callback)
+#define PROFILE_DRAWGROUP(group)         ProfilerDrawGroupScope profileDrawGroup(group)
+#else
+#define PROFILE_BEGIN_FRAME()
+#define PROFILE_ZONE(zone)
+#define PROFILE_CLASS(classID, callback)
+#define PROFILE_DRAWGROUP(group)
+#endif
+
+} // namespace RSDK
+
+#endif // !PROFILER_H
@@ -0,0 +1,1387 @@
+#include "RSDK/Core/RetroEngine.hpp"
+
+#include <chrono>
+
+using namespace RSDK;
+
+#if !RETRO_USE_ORIGINAL_CODE
+SelfTestInfo RSDK::selfTests;
+
+static uint32 selfTestSeed = 0;
+
+// xorshift32, so every run sees the same numbers no matter what the game has done with its own RNG
+static uint32 SelfTestRand()
+{
+    selfTestSeed ^= selfTestSeed << 13;
+    selfTestSeed ^= selfTestSeed >> 17;
+    selfTestSeed ^= selfTestSeed << 5;
+    return selfTestSeed;
+}
+
+static inline int64 GetSelfTestTime()
+{
+    return (int64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ========================
+// Temp entity slots
+// ========================
+
+#define TEMPBENCH_FRAMES      (6000)
+#define TEMPBENCH_STEADY      (3)   // spawned every frame
+#define TEMPBENCH_BURST_EVERY (120) // frames, each burst is spread over 4 frames
+#define TEMPBENCH_LIFE_MIN    (30)  // frames
+#define TEMPBENCH_LIFE_RANGE  (60)
+
+struct TempEntityBenchSetup {
+    const char *name;
+    bool32 useProbe;
+    int32 regionSize;
+    int32 classPool;
+};
+
+struct TempEntityBenchResult {
+    int32 createCount;
+    int32 overwriteCount;
+    int32 orderMismatches;
+    int64 time;
+};
+
+// CreateEntity's slot search from before the free slot bits, kept as the reference for the order slots are handed out in
+static int32 ProbeTempEntitySlot()
+{
+    EntityBase *entity = &objectEntityList[sceneInfo.createSlot];
+
+    int32 permCnt = 0, loopCnt = 0;
+    while (entity->classID) {
+        if (!entity->isPermanent && loopCnt >= 16)
+            break;
+
+        if (entity->isPermanent)
+            ++permCnt;
+
+        sceneInfo.createSlot++;
+        if (sceneInfo.createSlot == ENTITY_COUNT)
+            sceneInfo.createSlot = TEMPENTITY_START;
+        entity = &objectEntityList[sceneInfo.createSlot];
+
+        if (permCnt >= TEMPENTITY_COUNT)
+            break;
+
+        ++loopCnt;
+    }
+
+    return sceneInfo.createSlot;
+}
+
+// Spawns bursts of short-lived entities into the temp slots & despawns them once they expire, half through ResetEntity & half by clearing
+// classID directly, without running any object code
+// checkOrder compares every slot against the one the original probe would've picked, whenever that one was free
+static void RunTempEntityBench(const TempEntityBenchSetup *setup, int32 burstSize, EntityBase *stageEntities, uint16 *lifetimes, bool32 checkOrder,
+                               TempEntityBenchResult *result)
+{
+    memcpy(objectEntityList, stageEntities, sizeof(objectEntityList));
+    // anything the stage spawned into the temp slots is cleared so every run starts out the same
+    memset(&objectEntityList[TEMPENTITY_START], 0, TEMPENTITY_COUNT * sizeof(EntityBase));
+    memset(lifetimes, 0, ENTITY_COUNT * sizeof(uint16));
+
+    engine.tempEntityCount = setup->regionSize;
+    InitTempEntityPools();
+    if (setup->classPool)
+        SetTempEntityPool(2, setup->classPool);
+    sceneInfo.createSlot = TEMPENTITY_START;
+
+    memset(result, 0, sizeof(*result));
+    selfTestSeed = 0x2545F491;
+
+    uint16 spawnLives[0x100];
+    for (int32 f = 0; f < TEMPBENCH_FRAMES; ++f) {
+        tempEntityInfo.stale = true;
+
+        for (int32 s = tempEntityInfo.start; s < ENTITY_COUNT; ++s) {
+            if (lifetimes[s] && !--lifetimes[s]) {
+                EntityBase *entity = &objectEntityList[s];
+                if (SelfTestRand() & 1) {
+                    entity->classID = TYPE_DEFAULTOBJECT;
+                }
+                else {
+                    memset(entity, 0, sizeof(EntityBase));
+                    ReleaseTempEntity(entity);
+                }
+            }
+        }
+
+        int32 spawnCount = (f % TEMPBENCH_BURST_EVERY) < 4 ? burstSize / 4 : TEMPBENCH_STEADY;
+        for (int32 i = 0; i < spawnCount; ++i) spawnLives[i] = TEMPBENCH_LIFE_MIN + SelfTestRand() % TEMPBENCH_LIFE_RANGE;
+
+        int64 startTime = GetSelfTestTime();
+        for (int32 i = 0; i < spawnCount; ++i) {
+            uint16 classID = (i & 1) ? 2 : 1;
+
+            int32 probed = -1;
+            if (checkOrder) {
+                uint16 createSlot    = sceneInfo.createSlot;
+                probed               = ProbeTempEntitySlot();
+                sceneInfo.createSlot = createSlot;
+                if (objectEntityList[probed].classID)
+                    probed = -1;
+            }
+
+            int32 slot = setup->useProbe ? ProbeTempEntitySlot() : AllocateTempEntitySlot(classID);
+            if (probed >= 0 && slot != probed)
+                result->orderMismatches++;
+
+            EntityBase *entity = &objectEntityList[slot];
+            if (entity->classID)
+                result->overwriteCount++;
+
+            entity->classID  = classID;
+            lifetimes[slot] = spawnLives[i];
+        }
+        result->time += GetSelfTestTime() - startTime;
+        result->createCount += spawnCount;
+    }
+}
+
+static bool32 SelfTest_TempEntities()
+{
+    const TempEntityBenchSetup setups[] = {
+        { "probe", true, TEMPENTITY_COUNT, 0 },
+        { "free bits", false, TEMPENTITY_COUNT, 0 },
+        { "free bits + class pool", false, TEMPENTITY_COUNT, 0x40 },
+        { "free bits, max region", false, TEMPENTITY_COUNT_MAX, 0 },
+    };
+    const int32 burstSizes[] = { 0x40, 0x100 };
+
+    EntityBase *stageEntities = (EntityBase *)malloc(sizeof(objectEntityList));
+    uint16 *lifetimes         = (uint16 *)malloc(ENTITY_COUNT * sizeof(uint16));
+    if (!stageEntities || !lifetimes) {
+        free(stageEntities);
+        free(lifetimes);
+        PrintLog(PRINT_NORMAL, "[SelfTest] tempentities: out of memory");
+        return false;
+    }
+
+    memcpy(stageEntities, objectEntityList, sizeof(objectEntityList));
+    TempEntityInfo storedInfo = tempEntityInfo;
+    uint16 storedCreateSlot   = sceneInfo.createSlot;
+    int32 storedRegionSize    = engine.tempEntityCount;
+
+    bool32 passed = true;
+    for (int32 b = 0; b < (int32)(sizeof(burstSizes) / sizeof(burstSizes[0])); ++b) {
+        TempEntityBenchResult result;
+
+        // the free bits have to pick the same slot the probe would have whenever the probe found a free one
+        RunTempEntityBench(&setups[1], burstSizes[b], stageEntities, lifetimes, true, &result);
+        if (result.orderMismatches) {
+            PrintLog(PRINT_NORMAL, "[SelfTest] tempentities: burst %d, %d of %d slots differ from the probe's", burstSizes[b], result.orderMismatches,
+                     result.createCount);
+            passed = false;
+        }
+
+        for (int32 s = 0; s < (int32)(sizeof(setups) / sizeof(setups[0])); ++s) {
+            if (setups[s].classPool && sceneInfo.classCount <= 2)
+                continue;
+
+            RunTempEntityBench(&setups[s], burstSizes[b], stageEntities, lifetimes, false, &result);
+            PrintLog(PRINT_NORMAL, "[SelfTest] tempentities: burst %d, %s (%d slots): %d creates, %.1fns each, %d live entities overwritten",
+                     burstSizes[b], setups[s].name, ENTITY_COUNT - tempEntityInfo.start, result.createCount,
+                     (double)result.time / result.createCount, result.overwriteCount);
+        }
+    }
+
+    memcpy(objectEntityList, stageEntities, sizeof(objectEntityList));
+    tempEntityInfo         = storedInfo;
+    sceneInfo.createSlot   = storedCreateSlot;
+    engine.tempEntityCount = storedRegionSize;
+
+    free(stageEntities);
+    free(lifetimes);
+    return passed;
+}
+
+// ========================
+// Batched math
+// ========================
+
+#define MATHTEST_COUNT (0x1001) // odd, so any unrolled tail gets checked too
+
+// Random values anywhere in the int32 range except INT32_MIN (abs() of it isn't defined), every few are kept small so the arctan shifts
+// & the lookups near 0 get covered as well
+static int32 SelfTestRandValue()
+{
+    int32 value = (int32)SelfTestRand();
+    switch (SelfTestRand() & 3) {
+        default: break;
+        case 1: value >>= 20; break;
+        case 2: value >>= 8; break;
+    }
+    return value == (-0x7FFFFFFF - 1) ? 0 : value;
+}
+
+static bool32 SelfTest_Math()
+{
+    int32 *angles    = (int32 *)malloc(MATHTEST_COUNT * sizeof(int32));
+    int32 *sines     = (int32 *)malloc(MATHTEST_COUNT * sizeof(int32));
+    int32 *cosines   = (int32 *)malloc(MATHTEST_COUNT * sizeof(int32));
+    Vector2 *vectors = (Vector2 *)malloc(MATHTEST_COUNT * sizeof(Vector2));
+    Vector2 *results = (Vector2 *)malloc(MATHTEST_COUNT * sizeof(Vector2));
+    uint8 *arcTans   = (uint8 *)malloc(MATHTEST_COUNT * sizeof(uint8));
+    if (!angles || !sines || !cosines || !vectors || !results || !arcTans) {
+        free(angles);
+        free(sines);
+        free(cosines);
+        free(vectors);
+        free(results);
+        free(arcTans);
+        PrintLog(PRINT_NORMAL, "[SelfTest] math: out of memory");
+        return false;
+    }
+
+    selfTestSeed = 0x6A09E667;
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        angles[i]    = SelfTestRandValue();
+        vectors[i].x = SelfTestRandValue();
+        vectors[i].y = SelfTestRandValue();
+    }
+    // make sure the axes & the diagonals get hit, they're where the arctan quadrant checks flip
+    for (int32 i = 0; i < 9; ++i) {
+        vectors[i].x = ((i % 3) - 1) * 0x10000;
+        vectors[i].y = ((i / 3) - 1) * 0x10000;
+    }
+
+    int32 failCount = 0;
+#define MATHTEST_CHECK(name, result, expected)                                                                                                    \
+    if ((result) != (expected)) {                                                                                                                  \
+        if (++failCount <= 8)                                                                                                                      \
+            PrintLog(PRINT_NORMAL, "[SelfTest] math: %s differs for element %d (%d, expected %d)", name, i, (int32)(result), (int32)(expected));  \
+    }
+
+    SinCos1024Batch(sines, cosines, angles, MATHTEST_COUNT);
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        MATHTEST_CHECK("SinCos1024Batch", sines[i], Sin1024(angles[i]));
+        MATHTEST_CHECK("SinCos1024Batch", cosines[i], Cos1024(angles[i]));
+    }
+
+    SinCos512Batch(sines, cosines, angles, MATHTEST_COUNT);
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        MATHTEST_CHECK("SinCos512Batch", sines[i], Sin512(angles[i]));
+        MATHTEST_CHECK("SinCos512Batch", cosines[i], Cos512(angles[i]));
+    }
+
+    SinCos256Batch(sines, cosines, angles, MATHTEST_COUNT);
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        MATHTEST_CHECK("SinCos256Batch", sines[i], Sin256(angles[i]));
+        MATHTEST_CHECK("SinCos256Batch", cosines[i], Cos256(angles[i]));
+    }
+
+    ArcTanBatch(arcTans, vectors, MATHTEST_COUNT);
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) MATHTEST_CHECK("ArcTanBatch", arcTans[i], ArcTanLookup(vectors[i].x, vectors[i].y));
+
+    const int32 multipliers[] = { 0x10000, 0x8000, 0x18000, -0x10000, 0x123, 0x7FFFFFFF };
+    for (int32 m = 0; m < (int32)(sizeof(multipliers) / sizeof(multipliers[0])); ++m) {
+        memcpy(results, vectors, MATHTEST_COUNT * sizeof(Vector2));
+        MultiplyVectorsBatch(results, MATHTEST_COUNT, multipliers[m]);
+
+        for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+            MATHTEST_CHECK("MultiplyVectorsBatch", results[i].x, (int32)(((int64)vectors[i].x * multipliers[m]) >> 16));
+            MATHTEST_CHECK("MultiplyVectorsBatch", results[i].y, (int32)(((int64)vectors[i].y * multipliers[m]) >> 16));
+        }
+    }
+
+    // the rest are checked against the per-entity fixed point math they replace (9 bit trig & 16.16 positions), using positions a stage can
+    // actually have so nothing overflows
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        vectors[i].x = (int32)(SelfTestRand() & 0x1FFFFFFF);
+        vectors[i].y = (int32)(SelfTestRand() & 0x1FFFFFFF);
+    }
+    Vector2 pivot = { (int32)(SelfTestRand() & 0x1FFFFFFF), (int32)(SelfTestRand() & 0x1FFFFFFF) };
+    for (int32 a = 0; a < 0x200; a += 0x1D) {
+        memcpy(results, vectors, MATHTEST_COUNT * sizeof(Vector2));
+        RotateVectorsBatch(results, MATHTEST_COUNT, &pivot, a);
+
+        for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+            int64 x = vectors[i].x - pivot.x;
+            int64 y = vectors[i].y - pivot.y;
+            MATHTEST_CHECK("RotateVectorsBatch", results[i].x, pivot.x + (int32)((x * Cos512(a) - y * Sin512(a)) >> 9));
+            MATHTEST_CHECK("RotateVectorsBatch", results[i].y, pivot.y + (int32)((x * Sin512(a) + y * Cos512(a)) >> 9));
+        }
+    }
+
+    Vector2 target = { 0x20000000, 0x08000000 };
+    DistanceSquaredBatch(sines, vectors, MATHTEST_COUNT, &target);
+    for (int32 i = 0; i < MATHTEST_COUNT; ++i) {
+        int32 x = (vectors[i].x - target.x) >> 16;
+        int32 y = (vectors[i].y - target.y) >> 16;
+        MATHTEST_CHECK("DistanceSquaredBatch", sines[i], x * x + y * y);
+    }
+#undef MATHTEST_CHECK
+
+    if (failCount)
+        PrintLog(PRINT_NORMAL, "[SelfTest] math: %d results differ from the scalar versions", failCount);
+
+    free(angles);
+    free(sines);
+    free(cosines);
+    free(vectors);
+    free(results);
+    free(arcTans);
+    return !failCount;
+}
+
+// ========================
+// Sfx mixing
+// ========================
+
+#define MIXTEST_FRAMES    (0x400) // per callback
+#define MIXTEST_CALLBACKS (0x100)
+#define MIXTEST_LENGTH    (0x8000) // samples per test sfx, most of them run out & loop or stop partway through
+
+// The sfx loop from ProcessAudioMixing before voices were virtualized, kept as the reference for what the mixer should output
+static void MixSfxReference(ChannelInfo *channel, SAMPLE_FORMAT *streamF, SAMPLE_FORMAT *streamEndF)
+{
+    SAMPLE_FORMAT *sfxBuffer = &channel->samplePtr[channel->bufferPos];
+
+    float volL = channel->volume, volR = channel->volume;
+    if (channel->pan < 0.0f)
+        volR = (1.0f + channel->pan) * channel->volume;
+    else
+        volL = (1.0f - channel->pan) * channel->volume;
+
+    float panL = volL * engine.soundFXVolume;
+    float panR = volR * engine.soundFXVolume;
+
+    uint32 speedPercent       = 0;
+    SAMPLE_FORMAT *curStreamF = streamF;
+    while (curStreamF < streamEndF && streamF < streamEndF) {
+        // same value linearInterpolationLookup held
+        float delta          = (speedPercent / 0x40) / (float)(TO_FIXED(1) / 0x40);
+        SAMPLE_FORMAT sample = (sfxBuffer[1] - sfxBuffer[0]) * delta + sfxBuffer[0];
+
+        speedPercent += channel->speed;
+        sfxBuffer += FROM_FIXED(speedPercent);
+        channel->bufferPos += FROM_FIXED(speedPercent);
+        speedPercent %= TO_FIXED(1);
+
+        curStreamF[0] += sample * panL;
+        curStreamF[1] += sample * panR;
+        curStreamF += 2;
+
+        if (channel->bufferPos >= (int32)channel->sampleLength) {
+            if (channel->loop == (uint32)-1) {
+                channel->state   = CHANNEL_IDLE;
+                channel->soundID = -1;
+                break;
+            }
+            else {
+                channel->bufferPos -= (uint32)channel->sampleLength;
+                channel->bufferPos += channel->loop;
+
+                sfxBuffer = &channel->samplePtr[channel->bufferPos];
+            }
+        }
+    }
+}
+
+// Fills the voices with sfx like PlaySfx would, every other one loops & they all end at different points
+static void SetupMixTestVoices(float *samples, int32 voiceCount, int32 speed)
+{
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
+        MEM_ZERO(channels[c]);
+        channels[c].soundID = -1;
+        channels[c].state   = CHANNEL_IDLE;
+    }
+
+    selfTestSeed = 0x3C6EF372;
+    for (int32 c = 0; c < voiceCount; ++c) {
+        ChannelInfo *channel  = &channels[c];
+        channel->state        = CHANNEL_SFX;
+        channel->soundID      = c;
+        channel->samplePtr    = samples;
+        channel->sampleLength = MIXTEST_LENGTH - (SelfTestRand() % (MIXTEST_LENGTH / 2));
+        channel->loop         = (c & 1) ? SelfTestRand() % (uint32)(channel->sampleLength / 2) : (uint32)-1;
+        channel->volume       = 0.25f + (SelfTestRand() % 0x100) / 256.0f;
+        channel->pan          = ((int32)(SelfTestRand() % 0x101) - 0x80) / 128.0f;
+        channel->speed        = speed;
+        channel->priority     = SelfTestRand() & 0xFF;
+        channel->mixGain      = 1.0f;
+        channel->mixed        = CHANNEL_MIX_STARTED;
+    }
+}
+
+static bool32 SelfTest_Mixer()
+{
+    // one extra sample since the reference's interpolation reads the sample after the last one
+    float *samples         = (float *)malloc((MIXTEST_LENGTH + 1) * sizeof(float));
+    float *output          = (float *)malloc(MIXTEST_FRAMES * AUDIO_CHANNELS * sizeof(float));
+    float *expected        = (float *)malloc(MIXTEST_FRAMES * AUDIO_CHANNELS * sizeof(float));
+    ChannelInfo *stored    = (ChannelInfo *)malloc(sizeof(channels));
+    ChannelInfo *refVoices = (ChannelInfo *)malloc(sizeof(channels));
+    if (!samples || !output || !expected || !stored || !refVoices) {
+        free(samples);
+        free(output);
+        free(expected);
+        free(stored);
+        free(refVoices);
+        PrintLog(PRINT_NORMAL, "[SelfTest] mixer: out of memory");
+        return false;
+    }
+
+    selfTestSeed = 0x9E3779B9;
+    for (int32 i = 0; i < MIXTEST_LENGTH + 1; ++i) samples[i] = ((int32)(SelfTestRand() & 0xFFFF) - 0x8000) / 32768.0f;
+
+    // the device's callback can't run while the voices are swapped out (on devices that have a lock)
+    LockAudioDevice();
+    memcpy(stored, channels, sizeof(channels));
+    AudioDeviceStats storedStats;
+    AudioDeviceBase::CopyAudioStats(&storedStats, &AudioDeviceBase::stats);
+    int32 storedTargetPeriod = AudioDeviceBase::targetPeriod.load();
+    int32 storedFrequency    = AudioDeviceBase::outputFrequency;
+    int32 storedVoiceLimit   = engine.mixedVoiceLimit;
+    float storedSfxVolume    = engine.soundFXVolume;
+
+    AudioDeviceBase::outputFrequency = AUDIO_FREQUENCY;
+    engine.soundFXVolume             = 0.75f;
+
+    bool32 passed = true;
+
+    // with every voice mixed at its original pitch the output has to match the old mixer bit for bit
+    for (int32 voiceCount = 1; voiceCount <= CHANNEL_COUNT; voiceCount += 5) {
+        engine.mixedVoiceLimit = VOICE_COUNT;
+        SetupMixTestVoices(samples, voiceCount, TO_FIXED(1));
+        memcpy(refVoices, channels, sizeof(channels));
+
+        int32 mismatch = -1;
+        for (int32 cb = 0; cb < MIXTEST_CALLBACKS && mismatch < 0; ++cb) {
+            memset(expected, 0, MIXTEST_FRAMES * AUDIO_CHANNELS * sizeof(float));
+            for (int32 c = 0; c < VOICE_COUNT; ++c) {
+                if (refVoices[c].state == CHANNEL_SFX)
+                    MixSfxReference(&refVoices[c], expected, expected + MIXTEST_FRAMES * AUDIO_CHANNELS);
+            }
+
+            AudioDeviceBase::ProcessAudioMixing(output, MIXTEST_FRAMES * AUDIO_CHANNELS);
+            if (memcmp(output, expected, MIXTEST_FRAMES * AUDIO_CHANNELS * sizeof(float)))
+                mismatch = cb;
+        }
+
+        if (mismatch >= 0) {
+            PrintLog(PRINT_NORMAL, "[SelfTest] mixer: %d voices, callback %d differs from the reference mixer", voiceCount, mismatch);
+            passed = false;
+        }
+    }
+
+    // timings, the reference mixes everything it's given while the mixer only mixes the mixedVoiceLimit most audible voices
+    struct MixBench {
+        const char *name;
+        int32 voiceCount;
+        int32 speed;
+    };
+    const MixBench benches[] = {
+        { "16 voices, unpitched", 16, TO_FIXED(1) },
+        { "16 voices, pitched", 16, TO_FIXED(1) + TO_FIXED(1) / 3 },
+        { "16 voices, pitched an octave up", 16, TO_FIXED(2) },
+        { "64 voices, unpitched", VOICE_COUNT, TO_FIXED(1) },
+    };
+    for (int32 b = 0; b < (int32)(sizeof(benches) / sizeof(benches[0])); ++b) {
+        engine.mixedVoiceLimit = storedVoiceLimit;
+
+        SetupMixTestVoices(samples, benches[b].voiceCount, benches[b].speed);
+        memcpy(refVoices, channels, sizeof(channels));
+        int64 refTime = 0, mixTime = 0;
+        for (int32 cb = 0; cb < MIXTEST_CALLBACKS; ++cb) {
+            int64 start = GetSelfTestTime();
+            memset(expected, 0, MIXTEST_FRAMES * AUDIO_CHANNELS * sizeof(float));
+            for (int32 c = 0; c < VOICE_COUNT; ++c) {
+                if (refVoices[c].state == CHANNEL_SFX)
+                    MixSfxReference(&refVoices[c], expected, expected + MIXTEST_FRAMES * AUDIO_CHANNELS);
+            }
+            refTime += GetSelfTestTime() - start;
+
+            start = GetSelfTestTime();
+            AudioDeviceBase::ProcessAudioMixing(output, MIXTEST_FRAMES * AUDIO_CHANNELS);
+            mixTime += GetSelfTestTime() - start;
+        }
+
+        PrintLog(PRINT_NORMAL, "[SelfTest] mixer: %s (%d mixed), %.1fus per %d frame callback, %.1fus before", benches[b].name,
+                 MIN(benches[b].voiceCount, engine.mixedVoiceLimit), mixTime / 1000.0 / MIXTEST_CALLBACKS, MIXTEST_FRAMES,
+                 refTime / 1000.0 / MIXTEST_CALLBACKS);
+    }
+
+    memcpy(channels, stored, sizeof(channels));
+    AudioDeviceBase::CopyAudioStats(&AudioDeviceBase::stats, &storedStats);
+    AudioDeviceBase::targetPeriod.store(storedTargetPeriod);
+    AudioDeviceBase::outputFrequency = storedFrequency;
+    engine.mixedVoiceLimit           = storedVoiceLimit;
+    engine.soundFXVolume             = storedSfxVolume;
+    UnlockAudioDevice();
+
+    free(samples);
+    free(output);
+    free(expected);
+    free(stored);
+    free(refVoices);
+    return passed;
+}
+
+// ========================
+// Ink effect blitters
+// ========================
+
+#define INKTEST_DRAWS   (0x40) // per ink effect & flip
+#define INKTEST_SHEET   (SURFACE_COUNT - 1)
+#define INKTEST_SPRSIZE (0x80)
+#define INKTEST_RECT    (FLIP_XY + 1) // drawn after the sprites for each flip
+
+// Everything the draw functions read or write, so the tests can draw into screen 0 with their own data & put the scene's back afterwards
+struct DrawTestState {
+    ScreenInfo *screen;
+    ScreenInfo *currentScreen;
+    GFXSurface surface;
+    uint16 *palette;
+    uint8 lineBuffer[SCREEN_YSIZE];
+    int32 maskColor;
+    bool32 validDraw;
+    uint16 *tintTable;
+};
+
+static bool32 StoreDrawTestState(DrawTestState *state)
+{
+    state->screen  = (ScreenInfo *)malloc(sizeof(ScreenInfo));
+    state->palette = (uint16 *)malloc(sizeof(fullPalette));
+#if RETRO_REV02
+    // only the pointer gets swapped out here
+    state->tintTable = tintLookupTable;
+    if (!state->screen || !state->palette) {
+#else
+    state->tintTable = (uint16 *)malloc(sizeof(tintLookupTable));
+    if (!state->screen || !state->palette || !state->tintTable) {
+        free(state->tintTable);
+#endif
+        free(state->screen);
+        free(state->palette);
+        return false;
+    }
+
+    memcpy(state->screen, &screens[0], sizeof(ScreenInfo));
+    memcpy(state->palette, fullPalette, sizeof(fullPalette));
+    memcpy(state->lineBuffer, gfxLineBuffer, sizeof(gfxLineBuffer));
+#if !RETRO_REV02
+    memcpy(state->tintTable, tintLookupTable, sizeof(tintLookupTable));
+#endif
+    state->currentScreen = currentScreen;
+    state->surface       = gfxSurface[INKTEST_SHEET];
+    state->maskColor     = maskColor;
+    state->validDraw     = validDraw;
+
+    currentScreen = &screens[0];
+    return true;
+}
+
+static void RestoreDrawTestState(DrawTestState *state)
+{
+    memcpy(&screens[0], state->screen, sizeof(ScreenInfo));
+    memcpy(fullPalette, state->palette, sizeof(fullPalette));
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) MarkPaletteDirty(b);
+    memcpy(gfxLineBuffer, state->lineBuffer, sizeof(gfxLineBuffer));
+#if RETRO_REV02
+    tintLookupTable = state->tintTable;
+#else
+    memcpy(tintLookupTable, state->tintTable, sizeof(tintLookupTable));
+    free(state->tintTable);
+#endif
+    currentScreen             = state->currentScreen;
+    gfxSurface[INKTEST_SHEET] = state->surface;
+    maskColor                 = state->maskColor;
+    validDraw                 = state->validDraw;
+
+    free(state->screen);
+    free(state->palette);
+}
+
+// Random colours, with every few being maskColor so the masked inks have something to find
+static void FillInkTestFrameBuffer(uint16 *frameBuffer, int32 size)
+{
+    for (int32 i = 0; i < size; ++i) {
+        uint32 rand    = SelfTestRand();
+        frameBuffer[i] = (rand & 0x70000) ? (uint16)rand : (uint16)maskColor;
+    }
+}
+
+// The alpha checks the draw functions used to repeat up front, returns false if nothing gets drawn
+static bool32 SetupInkReference(int32 *inkEffect, int32 *alpha)
+{
+    switch (*inkEffect) {
+        default: return true;
+
+        case INK_ALPHA:
+            if (*alpha > 0xFF)
+                *inkEffect = INK_NONE;
+            return *alpha > 0;
+
+        case INK_ADD:
+        case INK_SUB:
+            if (*alpha > 0xFF)
+                *alpha = 0xFF;
+            return *alpha > 0;
+
+        case INK_TINT: return tintLookupTable != NULL;
+    }
+}
+
+// One pixel of each ink effect written out in full, the way the draw functions had them before the blitters were templated
+static void DrawInkReferencePixel(int32 inkEffect, int32 alpha, uint16 pixel, uint16 *frameBufferClr)
+{
+    uint16 dst = *frameBufferClr;
+    switch (inkEffect) {
+        default: break;
+
+        case INK_NONE: *frameBufferClr = pixel; break;
+
+        case INK_BLEND: *frameBufferClr = ((pixel >> 1) & 0x7BEF) + ((dst >> 1) & 0x7BEF); break;
+
+        case INK_ALPHA: {
+            uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
+            uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
+
+            int32 R         = (fbufferBlend[(dst & 0xF800) >> 11] + pixelBlend[(pixel & 0xF800) >> 11]) << 11;
+            int32 G         = (fbufferBlend[(dst & 0x7E0) >> 6] + pixelBlend[(pixel & 0x7E0) >> 6]) << 6;
+            int32 B         = fbufferBlend[dst & 0x1F] + pixelBlend[pixel & 0x1F];
+            *frameBufferClr = R | G | B;
+            break;
+        }
+
+        case INK_ADD: {
+            uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
+
+            int32 R         = MIN((blendTablePtr[(pixel & 0xF800) >> 11] << 11) + (dst & 0xF800), 0xF800);
+            int32 G         = MIN((blendTablePtr[(pixel & 0x7E0) >> 6] << 6) + (dst & 0x7E0), 0x7E0);
+            int32 B         = MIN(blendTablePtr[pixel & 0x1F] + (dst & 0x1F), 0x1F);
+            *frameBufferClr = R | G | B;
+            break;
+        }
+
+        case INK_SUB: {
+            uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
+
+            int32 R         = MAX((dst & 0xF800) - (subBlendTable[(pixel & 0xF800) >> 11] << 11), 0);
+            int32 G         = MAX((dst & 0x7E0) - (subBlendTable[(pixel & 0x7E0) >> 6] << 6), 0);
+            int32 B         = MAX((dst & 0x1F) - subBlendTable[pixel & 0x1F], 0);
+            *frameBufferClr = R | G | B;
+            break;
+        }
+
+        case INK_TINT: *frameBufferClr = tintLookupTable[dst]; break;
+
+        case INK_MASKED:
+            if (dst == maskColor)
+                *frameBufferClr = pixel;
+            break;
+
+        case INK_UNMASKED:
+            if (dst != maskColor)
+                *frameBufferClr = pixel;
+            break;
+    }
+}
+
+// DrawSpriteFlipped one pixel at a time, every screen pixel looks up its own sprite pixel, returns what validDraw should be afterwards
+static bool32 DrawSpriteReference(uint16 *frameBuffer, int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction,
+                                  int32 inkEffect, int32 alpha, GFXSurface *surface)
+{
+    if (!SetupInkReference(&inkEffect, &alpha))
+        return false;
+
+    int32 x1 = MAX(x, currentScreen->clipBound_X1);
+    int32 y1 = MAX(y, currentScreen->clipBound_Y1);
+    int32 x2 = MIN(x + width, currentScreen->clipBound_X2);
+    int32 y2 = MIN(y + height, currentScreen->clipBound_Y2);
+    if (x1 >= x2 || y1 >= y2)
+        return false;
+
+    if (inkEffect < INK_NONE || inkEffect > INK_UNMASKED)
+        return true;
+
+    for (int32 py = y1; py < y2; ++py) {
+        for (int32 px = x1; px < x2; ++px) {
+            int32 u = (direction & FLIP_X) ? width - 1 - (px - x) : px - x;
+            int32 v = (direction & FLIP_Y) ? height - 1 - (py - y) : py - y;
+
+            uint8 index = surface->pixels[(sprY + v) * surface->width + sprX + u];
+            if (index)
+                DrawInkReferencePixel(inkEffect, alpha, fullPalette[gfxLineBuffer[py]][index], &frameBuffer[px + py * currentScreen->pitch]);
+        }
+    }
+
+    return true;
+}
+
+// DrawRectangle (screen relative) one pixel at a time, returns what validDraw should be afterwards
+static bool32 DrawRectangleReference(uint16 *frameBuffer, int32 x, int32 y, int32 width, int32 height, uint32 color, int32 alpha, int32 inkEffect)
+{
+    if (!SetupInkReference(&inkEffect, &alpha))
+        return false;
+
+    int32 x1 = MAX(x, currentScreen->clipBound_X1);
+    int32 y1 = MAX(y, currentScreen->clipBound_Y1);
+    int32 x2 = MIN(x + width, currentScreen->clipBound_X2);
+    int32 y2 = MIN(y + height, currentScreen->clipBound_Y2);
+    if (x1 >= x2 || y1 >= y2)
+        return false;
+
+    if (inkEffect < INK_NONE || inkEffect > INK_UNMASKED)
+        return true;
+
+    uint16 color16 = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+    for (int32 py = y1; py < y2; ++py) {
+        for (int32 px = x1; px < x2; ++px) DrawInkReferencePixel(inkEffect, alpha, color16, &frameBuffer[px + py * currentScreen->pitch]);
+    }
+
+    return true;
+}
+
+// Mostly normal alphas, but every few are out of range on either side so the early outs & clamps get covered
+static int32 InkTestAlpha()
+{
+    uint32 rand = SelfTestRand();
+    switch (rand & 7) {
+        case 0: return -(int32)((rand >> 3) & 0xFF);
+        case 1: return 0x100 + ((rand >> 3) & 0xFF);
+        default: return (rand >> 3) & 0xFF;
+    }
+}
+
+static bool32 SelfTest_InkBlitters()
+{
+    DrawTestState state;
+    uint8 *sprite    = (uint8 *)malloc(INKTEST_SPRSIZE * INKTEST_SPRSIZE);
+    uint16 *expected = (uint16 *)malloc(sizeof(screens[0].frameBuffer));
+    uint16 *tint     = (uint16 *)malloc(0x10000 * sizeof(uint16));
+    if (!sprite || !expected || !tint || !StoreDrawTestState(&state)) {
+        free(sprite);
+        free(expected);
+        free(tint);
+        PrintLog(PRINT_NORMAL, "[SelfTest] inkblitters: out of memory");
+        return false;
+    }
+
+    selfTestSeed = 0x2545F491;
+
+    // about a quarter of the sprite is transparent
+    for (int32 i = 0; i < INKTEST_SPRSIZE * INKTEST_SPRSIZE; ++i) sprite[i] = (SelfTestRand() & 3) ? (uint8)SelfTestRand() : 0;
+    for (int32 i = 0; i < 0x10000; ++i) tint[i] = (uint16)SelfTestRand();
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) {
+        for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) fullPalette[b][c] = (uint16)SelfTestRand();
+    }
+    for (int32 l = 0; l < SCREEN_YSIZE; ++l) gfxLineBuffer[l] = SelfTestRand() % PALETTE_BANK_COUNT;
+#if RETRO_REV02
+    tintLookupTable = tint;
+#else
+    memcpy(tintLookupTable, tint, sizeof(tintLookupTable));
+#endif
+
+    GFXSurface *surface = &gfxSurface[INKTEST_SHEET];
+    surface->pixels     = sprite;
+    surface->width      = INKTEST_SPRSIZE;
+    surface->height     = INKTEST_SPRSIZE;
+    surface->lineSize   = 7;
+
+    maskColor           = (uint16)SelfTestRand();
+    ScreenInfo *screen  = currentScreen;
+    uint16 *frameBuffer = screen->frameBuffer;
+    int32 bufferSize    = screen->pitch * SCREEN_YSIZE;
+
+    bool32 passed = true;
+
+    // the ink effect is looped over past both ends, out of range values still count as a draw but don't draw anything
+    for (int32 inkEffect = INK_NONE - 1; inkEffect <= INK_UNMASKED + 1 && passed; ++inkEffect) {
+        for (int32 shape = FLIP_NONE; shape <= INKTEST_RECT && passed; ++shape) {
+            for (int32 d = 0; d < INKTEST_DRAWS && passed; ++d) {
+                screen->clipBound_X1 = SelfTestRand() % 0x20;
+                screen->clipBound_Y1 = SelfTestRand() % 0x20;
+                screen->clipBound_X2 = screen->pitch - SelfTestRand() % 0x20;
+                screen->clipBound_Y2 = SCREEN_YSIZE - SelfTestRand() % 0x20;
+
+                FillInkTestFrameBuffer(frameBuffer, bufferSize);
+                memcpy(expected, frameBuffer, bufferSize * sizeof(uint16));
+
+                int32 width  = 1 + SelfTestRand() % 0x60;
+                int32 height = 1 + SelfTestRand() % 0x60;
+                int32 x      = (int32)(SelfTestRand() % (screen->pitch + 0x60)) - 0x50;
+                int32 y      = (int32)(SelfTestRand() % (SCREEN_YSIZE + 0x60)) - 0x50;
+                int32 alpha  = InkTestAlpha();
+
+                bool32 expectedValid = false;
+                validDraw            = false;
+                if (shape == INKTEST_RECT) {
+                    uint32 color  = SelfTestRand();
+                    expectedValid = DrawRectangleReference(expected, x, y, width, height, color, alpha, inkEffect);
+                    DrawRectangle(x, y, width, height, color, alpha, inkEffect, true);
+                }
+                else {
+                    int32 sprX    = SelfTestRand() % (INKTEST_SPRSIZE - width + 1);
+                    int32 sprY    = SelfTestRand() % (INKTEST_SPRSIZE - height + 1);
+                    expectedValid = DrawSpriteReference(expected, x, y, width, height, sprX, sprY, shape, inkEffect, alpha, surface);
+                    DrawSpriteFlipped(x, y, width, height, sprX, sprY, shape, inkEffect, alpha, INKTEST_SHEET);
+                }
+
+                if (memcmp(frameBuffer, expected, bufferSize * sizeof(uint16)) || validDraw != expectedValid) {
+                    const char *shapeNames[] = { "sprite", "sprite (flip x)", "sprite (flip y)", "sprite (flip xy)", "rectangle" };
+                    PrintLog(PRINT_NORMAL, "[SelfTest] inkblitters: %s, ink %d, alpha %d, %dx%d at %d,%d differs from the reference", shapeNames[shape],
+                             inkEffect, alpha, width, height, x, y);
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    RestoreDrawTestState(&state);
+
+    free(sprite);
+    free(expected);
+    free(tint);
+    return passed;
+}
+
+// ========================
+// Rotozoom layers
+// ========================
+
+#define LAYERTEST_SHIFT  (7) // 128x128 tile layouts, wide enough for any screen
+#define ROTOTEST_FRAMES  (0x40)
+#define ROTOTEST_BENCHES (0x200)
+
+// The tileset & its opacity tables, which the layer tests fill with their own tiles
+struct TilesetTestState {
+    uint8 *pixels;
+    uint8 *rowOpacity;
+    uint8 *opacity;
+};
+
+static bool32 StoreTilesetTestState(TilesetTestState *state)
+{
+    state->pixels     = (uint8 *)malloc(sizeof(tilesetPixels));
+    state->rowOpacity = (uint8 *)malloc(sizeof(tileRowOpacity));
+    state->opacity    = (uint8 *)malloc(sizeof(tileOpacity));
+    if (!state->pixels || !state->rowOpacity || !state->opacity) {
+        free(state->pixels);
+        free(state->rowOpacity);
+        free(state->opacity);
+        return false;
+    }
+
+    memcpy(state->pixels, tilesetPixels, sizeof(tilesetPixels));
+    memcpy(state->rowOpacity, tileRowOpacity, sizeof(tileRowOpacity));
+    memcpy(state->opacity, tileOpacity, sizeof(tileOpacity));
+    return true;
+}
+
+static void RestoreTilesetTestState(TilesetTestState *state)
+{
+    memcpy(tilesetPixels, state->pixels, sizeof(tilesetPixels));
+    memcpy(tileRowOpacity, state->rowOpacity, sizeof(tileRowOpacity));
+    memcpy(tileOpacity, state->opacity, sizeof(tileOpacity));
+
+    free(state->pixels);
+    free(state->rowOpacity);
+    free(state->opacity);
+}
+
+// Every tile row (flipped copies included) is randomly empty, opaque or mixed, & every few tiles are left completely empty or opaque
+// so the whole tile classes get used as well
+static void FillTestTileset()
+{
+    for (int32 t = 0; t < TILE_COUNT * 4; ++t) {
+        uint8 *pixels = &tilesetPixels[t * TILE_DATASIZE];
+        uint32 kind   = SelfTestRand() & 7;
+
+        for (int32 y = 0; y < TILE_SIZE; ++y) {
+            uint32 row = kind < 2 ? kind : SelfTestRand() % 3;
+            for (int32 x = 0; x < TILE_SIZE; ++x) {
+                switch (row) {
+                    case 0: *pixels++ = 0; break;
+                    case 1: *pixels++ = 1 + SelfTestRand() % 0xFF; break;
+                    default: *pixels++ = (SelfTestRand() & 1) ? (uint8)SelfTestRand() : 0; break;
+                }
+            }
+        }
+    }
+
+    UpdateTileOpacity(0, TILE_COUNT);
+}
+
+// Random tiles with random flags, including the odd blank (0xFFFF) tile
+static void FillTestLayout(uint16 *layout, int32 size)
+{
+    for (int32 i = 0; i < size; ++i) layout[i] = (SelfTestRand() & 0xF) ? (uint16)SelfTestRand() : 0xFFFF;
+}
+
+// DrawLayerRotozoomLines' per-pixel loop, every line used to be drawn this way before unrotated ones were drawn in per-tile spans
+static void DrawLayerRotozoomLinesReference(TileLayer *layer, ScanlineInfo *scanline, int32 startY, int32 endY, int32 clipX1, int32 clipX2)
+{
+    uint16 *layout      = layer->layout;
+    uint8 *lineBuffer   = &gfxLineBuffer[startY];
+    uint16 *frameBuffer = &currentScreen->frameBuffer[clipX1 + startY * currentScreen->pitch];
+
+    int32 width    = (TILE_SIZE << layer->widthShift) - 1;
+    int32 height   = (TILE_SIZE << layer->heightShift) - 1;
+    int32 lineSize = clipX2 - clipX1;
+
+    for (int32 cy = startY; cy < endY; ++cy) {
+        int32 posX = scanline->position.x;
+        int32 posY = scanline->position.y;
+
+        uint16 *activePalette = fullPalette[*lineBuffer];
+        ++lineBuffer;
+        int32 fbOffset = currentScreen->pitch - lineSize;
+
+        for (int32 cx = 0; cx < lineSize; ++cx) {
+            int32 tx = posX >> 20;
+            int32 ty = posY >> 20;
+            int32 x  = FROM_FIXED(posX) & 0xF;
+            int32 y  = FROM_FIXED(posY) & 0xF;
+
+            uint16 tile = layout[((width >> 4) & tx) + (((height >> 4) & ty) << layer->widthShift)] & 0xFFF;
+            uint8 idx   = tilesetPixels[TILE_SIZE * (y + TILE_SIZE * tile) + x];
+
+            if (idx)
+                *frameBuffer = activePalette[idx];
+
+            posX += scanline->deform.x;
+            posY += scanline->deform.y;
+            ++frameBuffer;
+        }
+
+        frameBuffer += fbOffset;
+        ++scanline;
+    }
+}
+
+// Steps that sit right on the span path's edges (no step, whole & half pixels, just under ROTOZOOM_SPAN_MAX_STEP) as well as random ones
+// on either side of it
+static int32 RotozoomTestStep()
+{
+    const int32 steps[] = { 0, TO_FIXED(1), TO_FIXED(1) / 2, TO_FIXED(4) - 1, TO_FIXED(4), 1 };
+
+    uint32 rand = SelfTestRand();
+    int32 step  = (rand & 3) ? (int32)(SelfTestRand() % TO_FIXED(5)) : steps[(rand >> 2) % (sizeof(steps) / sizeof(steps[0]))];
+    return (rand & 0x80) ? -step : step;
+}
+
+// Anywhere within a few thousand layouts either side of 0, but often on a whole pixel or tile so spans end exactly on a tile's edge
+static int32 RotozoomTestPosition()
+{
+    uint32 rand = SelfTestRand();
+    int32 pos   = (int32)(SelfTestRand() & 0x3FFFFFFF) - 0x20000000;
+    switch (rand & 7) {
+        case 0: return pos & ~0xFFFFF;
+        case 1:
+        case 2: return pos & ~0xFFFF;
+        default: return pos;
+    }
+}
+
+static bool32 SelfTest_Rotozoom()
+{
+    DrawTestState drawState;
+    TilesetTestState tilesetState;
+    TileLayer *layer       = (TileLayer *)malloc(sizeof(TileLayer));
+    uint16 *layout         = (uint16 *)malloc((1 << (LAYERTEST_SHIFT * 2)) * sizeof(uint16));
+    ScanlineInfo *lines    = (ScanlineInfo *)malloc(SCREEN_YSIZE * sizeof(ScanlineInfo));
+    uint16 *initial        = (uint16 *)malloc(sizeof(screens[0].frameBuffer));
+    uint16 *expected       = (uint16 *)malloc(sizeof(screens[0].frameBuffer));
+    bool32 storedDrawState = false;
+    bool32 storedTileset   = false;
+    if (layer && layout && lines && initial && expected) {
+        storedDrawState = StoreDrawTestState(&drawState);
+        storedTileset   = storedDrawState && StoreTilesetTestState(&tilesetState);
+    }
+
+    if (!storedTileset) {
+        if (storedDrawState)
+            RestoreDrawTestState(&drawState);
+        free(layer);
+        free(layout);
+        free(lines);
+        free(initial);
+        free(expected);
+        PrintLog(PRINT_NORMAL, "[SelfTest] rotozoom: out of memory");
+        return false;
+    }
+
+    selfTestSeed = 0x6C078965;
+    FillTestTileset();
+    FillTestLayout(layout, 1 << (LAYERTEST_SHIFT * 2));
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) {
+        for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) fullPalette[b][c] = (uint16)SelfTestRand();
+    }
+    for (int32 l = 0; l < SCREEN_YSIZE; ++l) gfxLineBuffer[l] = SelfTestRand() % PALETTE_BANK_COUNT;
+
+    memset(layer, 0, sizeof(TileLayer));
+    layer->type        = LAYER_ROTOZOOM;
+    layer->widthShift  = LAYERTEST_SHIFT;
+    layer->heightShift = LAYERTEST_SHIFT;
+    layer->xsize       = 1 << LAYERTEST_SHIFT;
+    layer->ysize       = 1 << LAYERTEST_SHIFT;
+    layer->layout      = layout;
+
+    ScreenInfo *screen  = currentScreen;
+    uint16 *frameBuffer = screen->frameBuffer;
+    int32 bufferSize    = screen->pitch * SCREEN_YSIZE;
+
+    bool32 passed = true;
+
+    // most lines are unrotated so they take the span path, the rest are rotated & have to keep matching as well
+    for (int32 f = 0; f < ROTOTEST_FRAMES && passed; ++f) {
+        for (int32 l = 0; l < SCREEN_YSIZE; ++l) {
+            lines[l].position.x = RotozoomTestPosition();
+            lines[l].position.y = RotozoomTestPosition();
+            lines[l].deform.x   = RotozoomTestStep();
+            lines[l].deform.y   = (SelfTestRand() & 3) ? 0 : RotozoomTestStep();
+        }
+
+        int32 clipX1 = SelfTestRand() % 0x20;
+        int32 clipX2 = screen->pitch - SelfTestRand() % 0x20;
+        int32 startY = SelfTestRand() % 0x20;
+        int32 endY   = SCREEN_YSIZE - SelfTestRand() % 0x20;
+
+        for (int32 i = 0; i < bufferSize; ++i) initial[i] = (uint16)SelfTestRand();
+
+        memcpy(frameBuffer, initial, bufferSize * sizeof(uint16));
+        DrawLayerRotozoomLinesReference(layer, &lines[startY], startY, endY, clipX1, clipX2);
+        memcpy(expected, frameBuffer, bufferSize * sizeof(uint16));
+
+        memcpy(frameBuffer, initial, bufferSize * sizeof(uint16));
+        DrawLayerRotozoomLines(layer, &lines[startY], startY, endY, clipX1, clipX2);
+        if (memcmp(frameBuffer, expected, bufferSize * sizeof(uint16))) {
+            int32 pos = 0;
+            while (frameBuffer[pos] == expected[pos]) ++pos;
+
+            ScanlineInfo *line = &lines[pos / screen->pitch];
+            PrintLog(PRINT_NORMAL, "[SelfTest] rotozoom: frame %d, pixel %d,%d differs from the reference (line from %d,%d stepping %d,%d)", f,
+                     pos % screen->pitch, pos / screen->pitch, line->position.x, line->position.y, line->deform.x, line->deform.y);
+            passed = false;
+        }
+    }
+
+    // timings over whole screens of unrotated lines, at a few zoom levels
+    struct RotozoomBench {
+        const char *name;
+        int32 step;
+    };
+    const RotozoomBench benches[] = {
+        { "1x", TO_FIXED(1) },
+        { "2x zoom", TO_FIXED(1) / 2 },
+        { "0.5x zoom", TO_FIXED(2) },
+    };
+    for (int32 b = 0; b < (int32)(sizeof(benches) / sizeof(benches[0])); ++b) {
+        for (int32 l = 0; l < SCREEN_YSIZE; ++l) {
+            lines[l].position.x = (int32)(SelfTestRand() & 0x3FFFFFF);
+            lines[l].position.y = TO_FIXED(l);
+            lines[l].deform.x   = benches[b].step;
+            lines[l].deform.y   = 0;
+        }
+
+        int64 refTime = 0, spanTime = 0;
+        for (int32 f = 0; f < ROTOTEST_BENCHES; ++f) {
+            int64 start = GetSelfTestTime();
+            DrawLayerRotozoomLinesReference(layer, lines, 0, SCREEN_YSIZE, 0, screen->pitch);
+            refTime += GetSelfTestTime() - start;
+
+            start = GetSelfTestTime();
+            DrawLayerRotozoomLines(layer, lines, 0, SCREEN_YSIZE, 0, screen->pitch);
+            spanTime += GetSelfTestTime() - start;
+        }
+
+        PrintLog(PRINT_NORMAL, "[SelfTest] rotozoom: unrotated at %s, %.1fus per screen, %.1fus before", benches[b].name,
+                 spanTime / 1000.0 / ROTOTEST_BENCHES, refTime / 1000.0 / ROTOTEST_BENCHES);
+    }
+
+    RestoreTilesetTestState(&tilesetState);
+    RestoreDrawTestState(&drawState);
+    free(layer);
+    free(layout);
+    free(lines);
+    free(initial);
+    free(expected);
+    return passed;
+}
+
+// ========================
+// Tile layers
+// ========================
+
+#define LAYERTEST_FRAMES    (0x40)
+#define LAYERTEST_BENCHES   (0x100)
+#define LAYERTEST_REPEATS   (4)
+#define OPACITYTEST_BENCHES (0x40)
+
+// Scrolls a layer to a random spot, every renderer reads its positions from scanlines in its own way
+static void SetupLayerTestScanlines(TileLayer *layer, ScanlineInfo *lines)
+{
+    int32 layerSize = TILE_SIZE << LAYERTEST_SHIFT;
+    int32 baseX     = SelfTestRand() % (layerSize - currentScreen->pitch - 0x40);
+    int32 baseY     = SelfTestRand() % (layerSize - SCREEN_YSIZE - 0x40);
+
+    switch (layer->type) {
+        default: break;
+
+        // a few parallax bands, each scrolled a bit differently
+        case LAYER_HSCROLL:
+        case LAYER_BASIC:
+            for (int32 l = 0; l < SCREEN_YSIZE; ++l) {
+                if (!(l & 0x3F))
+                    baseX += SelfTestRand() % 0x10;
+
+                lines[l].position.x = TO_FIXED(baseX);
+                lines[l].position.y = TO_FIXED(baseY + l);
+            }
+            break;
+
+        // VScroll's scanlines are columns
+        case LAYER_VSCROLL:
+            for (int32 c = 0; c < currentScreen->pitch; ++c) {
+                if (!(c & 0x3F))
+                    baseY += SelfTestRand() % 0x10;
+
+                lines[c].position.x = TO_FIXED(baseX + c);
+                lines[c].position.y = TO_FIXED(baseY);
+            }
+            break;
+    }
+}
+
+static void DrawLayerTest(TileLayer *layer)
+{
+    switch (layer->type) {
+        default: break;
+        case LAYER_HSCROLL: DrawLayerHScroll(layer); break;
+        case LAYER_VSCROLL: DrawLayerVScroll(layer); break;
+        case LAYER_BASIC: DrawLayerBasic(layer); break;
+    }
+}
+
+// Marking every tile (& row) as mixed sends the renderers down their original per-pixel paths, which is what they're checked against
+static void SetLayerTestOpacity(bool32 classified, uint8 *rowClasses, uint8 *tileClasses)
+{
+    if (classified) {
+        memcpy(tileRowOpacity, rowClasses, sizeof(tileRowOpacity));
+        memcpy(tileOpacity, tileClasses, sizeof(tileOpacity));
+    }
+    else {
+        memset(tileRowOpacity, TILEOPACITY_MIXED, sizeof(tileRowOpacity));
+        memset(tileOpacity, TILEOPACITY_MIXED, sizeof(tileOpacity));
+    }
+}
+
+static bool32 SelfTest_Layers()
+{
+    DrawTestState drawState;
+    TilesetTestState tilesetState;
+    TileLayer *layer       = (TileLayer *)malloc(sizeof(TileLayer));
+    uint16 *layout         = (uint16 *)malloc((1 << (LAYERTEST_SHIFT * 2)) * sizeof(uint16));
+    ScanlineInfo *lines    = (ScanlineInfo *)malloc(SCREEN_XMAX * sizeof(ScanlineInfo));
+    uint8 *rowClasses      = (uint8 *)malloc(sizeof(tileRowOpacity));
+    uint8 *tileClasses     = (uint8 *)malloc(sizeof(tileOpacity));
+    uint16 *initial        = (uint16 *)malloc(sizeof(screens[0].frameBuffer));
+    uint16 *expected       = (uint16 *)malloc(sizeof(screens[0].frameBuffer));
+    bool32 storedDrawState = false;
+    bool32 storedTileset   = false;
+    if (layer && layout && lines && rowClasses && tileClasses && initial && expected) {
+        storedDrawState = StoreDrawTestState(&drawState);
+        storedTileset   = storedDrawState && StoreTilesetTestState(&tilesetState);
+    }
+
+    if (!storedTileset) {
+        if (storedDrawState)
+            RestoreDrawTestState(&drawState);
+        free(layer);
+        free(layout);
+        free(lines);
+        free(rowClasses);
+        free(tileClasses);
+        free(initial);
+        free(expected);
+        PrintLog(PRINT_NORMAL, "[SelfTest] layers: out of memory");
+        return false;
+    }
+
+    selfTestSeed = 0x41C64E6D;
+    FillTestTileset();
+    FillTestLayout(layout, 1 << (LAYERTEST_SHIFT * 2));
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) {
+        for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) fullPalette[b][c] = (uint16)SelfTestRand();
+    }
+    for (int32 l = 0; l < SCREEN_YSIZE; ++l) gfxLineBuffer[l] = SelfTestRand() % PALETTE_BANK_COUNT;
+
+    // what LoadStageGIF pays for a whole tileset
+    int64 opacityTime = GetSelfTestTime();
+    for (int32 r = 0; r < OPACITYTEST_BENCHES; ++r) UpdateTileOpacity(0, TILE_COUNT);
+    opacityTime = GetSelfTestTime() - opacityTime;
+    PrintLog(PRINT_NORMAL, "[SelfTest] layers: UpdateTileOpacity, %.1fus for a whole tileset", opacityTime / 1000.0 / OPACITYTEST_BENCHES);
+
+    memcpy(rowClasses, tileRowOpacity, sizeof(tileRowOpacity));
+    memcpy(tileClasses, tileOpacity, sizeof(tileOpacity));
+
+    memset(layer, 0, sizeof(TileLayer));
+    layer->widthShift  = LAYERTEST_SHIFT;
+    layer->heightShift = LAYERTEST_SHIFT;
+    layer->xsize       = 1 << LAYERTEST_SHIFT;
+    layer->ysize       = 1 << LAYERTEST_SHIFT;
+    layer->layout      = layout;
+
+    ScreenInfo *screen   = currentScreen;
+    uint16 *frameBuffer  = screen->frameBuffer;
+    int32 bufferSize     = screen->pitch * SCREEN_YSIZE;
+    ScanlineInfo *stored = scanlines;
+    scanlines            = lines;
+
+    screen->clipBound_X1 = 0;
+    screen->clipBound_Y1 = 0;
+    screen->clipBound_X2 = screen->pitch;
+    screen->clipBound_Y2 = screen->size.y;
+
+    bool32 passed = true;
+
+    struct LayerTest {
+        const char *name;
+        uint8 type;
+    };
+    const LayerTest tests[] = {
+        { "HScroll", LAYER_HSCROLL },
+        { "VScroll", LAYER_VSCROLL },
+        { "Basic", LAYER_BASIC },
+    };
+    for (int32 t = 0; t < (int32)(sizeof(tests) / sizeof(tests[0])); ++t) {
+        layer->type = tests[t].type;
+
+        // the opacity classes are only a shortcut, the output has to be the same without them
+        for (int32 f = 0; f < LAYERTEST_FRAMES && passed; ++f) {
+            SetupLayerTestScanlines(layer, lines);
+            for (int32 i = 0; i < bufferSize; ++i) initial[i] = (uint16)SelfTestRand();
+
+            memcpy(frameBuffer, initial, bufferSize * sizeof(uint16));
+            SetLayerTestOpacity(false, rowClasses, tileClasses);
+            DrawLayerTest(layer);
+            memcpy(expected, frameBuffer, bufferSize * sizeof(uint16));
+
+            memcpy(frameBuffer, initial, bufferSize * sizeof(uint16));
+            SetLayerTestOpacity(true, rowClasses, tileClasses);
+            DrawLayerTest(layer);
+            if (memcmp(frameBuffer, expected, bufferSize * sizeof(uint16))) {
+                PrintLog(PRINT_NORMAL, "[SelfTest] layers: %s frame %d differs from the original per-pixel paths", tests[t].name, f);
+                passed = false;
+            }
+        }
+
+        // each frame is drawn a few times both ways & only the quickest of each is kept, so one-off stalls don't swamp the difference
+        int64 classifiedTime = 0, mixedTime = 0;
+        for (int32 f = 0; f < LAYERTEST_BENCHES; ++f) {
+            SetupLayerTestScanlines(layer, lines);
+
+            int64 classifiedBest = 0, mixedBest = 0;
+            for (int32 r = 0; r < LAYERTEST_REPEATS; ++r) {
+                SetLayerTestOpacity(false, rowClasses, tileClasses);
+                int64 start = GetSelfTestTime();
+                DrawLayerTest(layer);
+                int64 time = GetSelfTestTime() - start;
+                if (!r || time < mixedBest)
+                    mixedBest = time;
+
+                SetLayerTestOpacity(true, rowClasses, tileClasses);
+                start = GetSelfTestTime();
+                DrawLayerTest(layer);
+                time = GetSelfTestTime() - start;
+                if (!r || time < classifiedBest)
+                    classifiedBest = time;
+            }
+
+            mixedTime += mixedBest;
+            classifiedTime += classifiedBest;
+        }
+
+        PrintLog(PRINT_NORMAL, "[SelfTest] layers: %s, %.1fus per screen, %.1fus with every tile drawn per-pixel", tests[t].name,
+                 classifiedTime / 1000.0 / LAYERTEST_BENCHES, mixedTime / 1000.0 / LAYERTEST_BENCHES);
+    }
+
+    scanlines = stored;
+    RestoreTilesetTestState(&tilesetState);
+    RestoreDrawTestState(&drawState);
+    free(layer);
+    free(layout);
+    free(lines);
+    free(rowClasses);
+    free(tileClasses);
+    free(initial);
+    free(expected);
+    return passed;
+}
+
+// ========================
+// Runner
+// ========================
+
+struct SelfTest {
+    const char *name;
+    bool32 (*run)();
+};
+
+static const SelfTest selfTestList[] = {
+    { "tempentities", SelfTest_TempEntities },
+    { "math", SelfTest_Math },
+    { "mixer", SelfTest_Mixer },
+    { "inkblitters", SelfTest_InkBlitters },
+    { "rotozoom", SelfTest_Rotozoom },
+    { "layers", SelfTest_Layers },
+};
+
+void RSDK::SetupSelfTests(const char *names)
+{
+    sprintf_s(selfTests.names, sizeof(selfTests.names), "%s", names);
+    selfTests.pending = true;
+}
+
+static bool32 SelfTestSelected(const char *name)
+{
+    if (!strcmp(selfTests.names, "all"))
+        return true;
+
+    int32 len = (int32)strlen(name);
+    for (const char *list = selfTests.names; *list;) {
+        const char *end = strchr(list, ',');
+        int32 entryLen  = end ? (int32)(end - list) : (int32)strlen(list);
+
+        if (entryLen == len && !strncmp(list, name, len))
+            return true;
+
+        if (!end)
+            break;
+        list = end + 1;
+    }
+
+    return false;
+}
+
+void RSDK::RunSelfTests()
+{
+    selfTests.pending = false;
+
+    for (int32 t = 0; t < (int32)(sizeof(selfTestList) / sizeof(selfTestList[0])); ++t) {
+        if (!SelfTestSelected(selfTestList[t].name))
+            continue;
+
+        PrintLog(PRINT_NORMAL, "[SelfTest] Running %s", selfTestList[t].name);
+        selfTests.runCount++;
+        if (!selfTestList[t].run()) {
+            PrintLog(PRINT_NORMAL, "[SelfTest] %s FAILED", selfTestList[t].name);
+            selfTests.failCount++;
+        }
+    }
+
+    if (!selfTests.runCount)
+        PrintLog(PRINT_NORMAL, "[SelfTest] Nothing matched \"%s\"", selfTests.names);
+    else
+        PrintLog(PRINT_NORMAL, "[SelfTest] %d run, %d failed", selfTests.runCount, selfTests.failCount);
+
+    RenderDevice::isRunning = false;
+}
+#endif
@@ -0,0 +1,30 @@
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+// Built-in tests & benchmarks for the engine's internals, so changes to them can be checked without a separate test harness
+// selftest=<name>,<name>... (or selftest=all) runs them once the first scene has loaded, logs the results & quits
+// Tests compare an optimized path against its reference implementation & fail on any difference, benchmarks only log timings
+// Some of them use the loaded scene's data, so pick one with stage=/scene= when that matters
+
+namespace RSDK
+{
+
+#if !RETRO_USE_ORIGINAL_CODE
+struct SelfTestInfo {
+    char names[0x100];
+    bool32 pending  = false;
+    int32 runCount  = 0;
+    int32 failCount = 0;
+};
+
+extern SelfTestInfo selfTests;
+
+// called by ParseArguments
+void SetupSelfTests(const char *names);
+// called once a scene has finished loading, the scene's state isn't kept so the engine quits afterwards
+void RunSelfTests();
+#endif
+
+} // namespace RSDK
+
+#endif // !SELFTEST_H
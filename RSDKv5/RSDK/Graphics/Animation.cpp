@@ -8,6 +8,10 @@ using namespace RSDK;
 
 SpriteAnimation RSDK::spriteAnimationList[SPRFILE_COUNT];
 
+#if !RETRO_USE_ORIGINAL_CODE
+static NameMap animationNameMap;
+#endif
+
 uint16 RSDK::LoadSpriteAnimation(const char *filePath, uint8 scope)
 {
     if (!scope || scope > SCOPE_STAGE)
@@ -19,9 +23,19 @@ uint16 RSDK::LoadSpriteAnimation(const char *filePath, uint8 scope)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(filePath, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&animationNameMap, hash);
+    if (slot >= 0 && HASH_MATCH_MD5(spriteAnimationList[slot].hash, hash))
+        return slot;
+#endif
+
     for (int32 i = 0; i < SPRFILE_COUNT; ++i) {
-        if (HASH_MATCH_MD5(spriteAnimationList[i].hash, hash))
+        if (HASH_MATCH_MD5(spriteAnimationList[i].hash, hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&animationNameMap, hash, i);
+#endif
             return i;
+        }
     }
 
     uint16 id = -1;
@@ -122,8 +136,17 @@ uint16 RSDK::CreateSpriteAnimation(const char *filename, uint32 frameCount, uint
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(filename, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&animationNameMap, hash);
+    if (slot >= 0 && HASH_MATCH_MD5(spriteAnimationList[slot].hash, hash))
+        return slot;
+#endif
+
     for (int32 i = 0; i < SPRFILE_COUNT; ++i) {
         if (HASH_MATCH_MD5(spriteAnimationList[i].hash, hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&animationNameMap, hash, i);
+#endif
             return i;
         }
     }
@@ -139,6 +139,14 @@ bool RenderDevice::Init()
 void RenderDevice::CopyFrameBuffer()
 {
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if !RETRO_USE_ORIGINAL_CODE
+        // mapping with WRITE_DISCARD throws the old contents away, so the whole screen has to be written if anything changed
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, 0, &startY, &endY))
+            continue;
+#endif
+
         D3D11_MAPPED_SUBRESOURCE mappedResource;
         if (SUCCEEDED(dx11Context->Map(screenTextures[s], 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource))) {
             WORD *pixels        = (WORD *)mappedResource.pData;
@@ -824,6 +832,9 @@ bool RenderDevice::InitGraphicsAPI()
         if (FAILED(dx11Device->CreateShaderResourceView(screenTextures[s], &resDesc, &screenTextureViews[s])))
             return false;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
 
     D3D11_TEXTURE2D_DESC desc = {};
     desc.Width                = RETRO_VIDEO_TEXTURE_W;
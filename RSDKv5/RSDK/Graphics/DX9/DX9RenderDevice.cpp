@@ -123,6 +123,14 @@ void RenderDevice::CopyFrameBuffer()
     dx9Device->SetTexture(0, NULL);
 
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if !RETRO_USE_ORIGINAL_CODE
+        // locking with D3DLOCK_DISCARD throws the old contents away, so the whole screen has to be written if anything changed
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, 0, &startY, &endY))
+            continue;
+#endif
+
         D3DLOCKED_RECT rect;
 
         if (SUCCEEDED(screenTextures[s]->LockRect(0, &rect, NULL, D3DLOCK_DISCARD))) {
@@ -674,6 +682,9 @@ bool RenderDevice::InitGraphicsAPI()
                                             &screenTextures[s], NULL)))
             return false;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
 
     if (FAILED(dx9Device->CreateTexture(RETRO_VIDEO_TEXTURE_W, RETRO_VIDEO_TEXTURE_H, 1, D3DUSAGE_DYNAMIC, D3DFMT_A8R8G8B8, D3DPOOL_DEFAULT,
                                         &imageTexture, NULL)))
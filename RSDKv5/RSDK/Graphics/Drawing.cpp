@@ -1,5 +1,9 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 using namespace RSDK;
 
 #if RETRO_REV0U
@@ -231,6 +235,710 @@ char RSDK::drawGroupNames[0x10][0x10] = {
     if (frameBufferClr != maskColor)                                                                                                                 \
         frameBufferClr = pixel;
 
+// Templated blitters
+// Each ink effect (& flip for sprites) gets its own inner loop instantiated at compile time, rather than every draw function
+// carrying a hand-written copy of each loop. They all use the setPixel macros above, so the output is identical either way
+
+struct InkParams {
+    uint16 *fbufferBlend;
+    uint16 *pixelBlend;
+    uint16 *blendTablePtr;
+    uint16 *subBlendTable;
+};
+
+// handles the alpha checks every draw function does up front, returns false if there's nothing to draw
+static inline bool32 SetupInkEffect(int32 &inkEffect, int32 &alpha, InkParams *params)
+{
+    switch (inkEffect) {
+        default: break;
+        case INK_ALPHA:
+            if (alpha > 0xFF)
+                inkEffect = INK_NONE;
+            else if (alpha <= 0)
+                return false;
+
+            params->fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
+            params->pixelBlend   = &blendLookupTable[0x20 * alpha];
+            break;
+
+        case INK_ADD:
+        case INK_SUB:
+            if (alpha > 0xFF)
+                alpha = 0xFF;
+            else if (alpha <= 0)
+                return false;
+
+            params->blendTablePtr = &blendLookupTable[0x20 * alpha];
+            params->subBlendTable = &subtractLookupTable[0x20 * alpha];
+            break;
+
+        case INK_TINT:
+            if (!tintLookupTable)
+                return false;
+            break;
+    }
+
+    return true;
+}
+
+template <int32 inkEffect> struct InkPixel;
+
+template <> struct InkPixel<INK_NONE> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params) { frameBufferClr = pixel; }
+};
+
+template <> struct InkPixel<INK_BLEND> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params) { setPixelBlend(pixel, frameBufferClr); }
+};
+
+template <> struct InkPixel<INK_ALPHA> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params)
+    {
+        uint16 *fbufferBlend = params.fbufferBlend;
+        uint16 *pixelBlend   = params.pixelBlend;
+        setPixelAlpha(pixel, frameBufferClr, alpha);
+    }
+};
+
+template <> struct InkPixel<INK_ADD> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params)
+    {
+        uint16 *blendTablePtr = params.blendTablePtr;
+        setPixelAdditive(pixel, frameBufferClr);
+    }
+};
+
+template <> struct InkPixel<INK_SUB> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params)
+    {
+        uint16 *subBlendTable = params.subBlendTable;
+        setPixelSubtractive(pixel, frameBufferClr);
+    }
+};
+
+// tint ignores the source colour entirely, it only uses the sprite as a mask
+template <> struct InkPixel<INK_TINT> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params) { frameBufferClr = tintLookupTable[frameBufferClr]; }
+};
+
+template <> struct InkPixel<INK_MASKED> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params) { setPixelMasked(pixel, frameBufferClr); }
+};
+
+template <> struct InkPixel<INK_UNMASKED> {
+    static inline void Draw(uint16 pixel, uint16 &frameBufferClr, const InkParams &params) { setPixelUnmasked(pixel, frameBufferClr); }
+};
+
+// builds a lookup table of a blitter template, indexed by ink effect
+#define INK_BLITTER_LIST(blitter)                                                                                                                    \
+    {                                                                                                                                                \
+        blitter<INK_NONE>, blitter<INK_BLEND>, blitter<INK_ALPHA>, blitter<INK_ADD>, blitter<INK_SUB>, blitter<INK_TINT>, blitter<INK_MASKED>,       \
+            blitter<INK_UNMASKED>                                                                                                                    \
+    }
+
+template <int32 inkEffect>
+static void BlitRectangle(uint16 *frameBuffer, int32 pitch, int32 width, int32 height, uint16 color, const InkParams &params)
+{
+    while (height--) {
+        int32 w = width;
+        while (w--) {
+            InkPixel<inkEffect>::Draw(color, *frameBuffer, params);
+            ++frameBuffer;
+        }
+        frameBuffer += pitch;
+    }
+}
+
+// fills each line between its scan edges, the edges get clipped in place
+template <int32 inkEffect>
+static void BlitScanEdges(uint16 *frameBuffer, int32 pitch, ScanEdge *edge, int32 lineCount, int32 clipX1, int32 clipX2, uint16 color,
+                          const InkParams &params)
+{
+    while (lineCount-- > 0) {
+        if (edge->start < clipX1)
+            edge->start = clipX1;
+        if (edge->start > clipX2)
+            edge->start = clipX2;
+
+        if (edge->end < clipX1)
+            edge->end = clipX1;
+        if (edge->end > clipX2)
+            edge->end = clipX2;
+
+        uint16 *frameBufferPtr = &frameBuffer[edge->start];
+        int32 count            = edge->end - edge->start;
+        while (count-- > 0) {
+            InkPixel<inkEffect>::Draw(color, *frameBufferPtr, params);
+            ++frameBufferPtr;
+        }
+
+        ++edge;
+        frameBuffer += pitch;
+    }
+}
+
+// gfxPitch is applied after each line, so it's negative when flipped vertically
+template <bool flipX> struct SpriteBlit {
+    template <int32 inkEffect>
+    static void Blit(uint16 *frameBuffer, int32 pitch, uint8 *pixels, int32 gfxPitch, uint8 *lineBuffer, int32 width, int32 height,
+                     const InkParams &params)
+    {
+        while (height--) {
+            uint16 *activePalette = fullPalette[*lineBuffer++];
+            int32 w               = width;
+            while (w--) {
+                if (*pixels > 0)
+                    InkPixel<inkEffect>::Draw(activePalette[*pixels], *frameBuffer, params);
+                pixels += flipX ? -1 : 1;
+                ++frameBuffer;
+            }
+            frameBuffer += pitch;
+            pixels += gfxPitch;
+        }
+    }
+};
+
+struct RotozoomBlit {
+    uint16 *frameBuffer;
+    int32 pitch;
+    uint8 *pixels;
+    uint8 *lineBuffer;
+    int32 lineSize;
+    int32 xSize;
+    int32 ySize;
+    int32 drawX;
+    int32 drawY;
+    int32 deltaX;
+    int32 deltaY;
+    int32 deltaXLen;
+    int32 deltaYLen;
+    int32 fullSprX;
+    int32 fullSprY;
+    int32 fullX;
+    int32 fullY;
+};
+
+template <int32 inkEffect> static void BlitSpriteRotozoom(const RotozoomBlit &blit, const InkParams &params)
+{
+    uint16 *frameBuffer = blit.frameBuffer;
+    uint8 *lineBuffer   = blit.lineBuffer;
+    int32 drawX         = blit.drawX;
+    int32 drawY         = blit.drawY;
+
+    for (int32 y = 0; y < blit.ySize; ++y) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 drawXPos        = drawX;
+        int32 drawYPos        = drawY;
+        for (int32 x = 0; x < blit.xSize; ++x) {
+            if (drawXPos >= blit.fullSprX && drawXPos < blit.fullX && drawYPos >= blit.fullSprY && drawYPos < blit.fullY) {
+                uint8 index = blit.pixels[(FROM_FIXED(drawYPos) << blit.lineSize) + FROM_FIXED(drawXPos)];
+                if (index)
+                    InkPixel<inkEffect>::Draw(activePalette[index], *frameBuffer, params);
+            }
+
+            ++frameBuffer;
+            drawXPos += blit.deltaX;
+            drawYPos += blit.deltaY;
+        }
+
+        drawX -= blit.deltaXLen;
+        drawY += blit.deltaYLen;
+        frameBuffer += blit.pitch;
+    }
+}
+
+template <int32 inkEffect>
+static void BlitDeformedSprite(uint16 *frameBuffer, uint8 *lineBuffer, ScanlineInfo *scanline, int32 lineCount, GFXSurface *surface,
+                               const InkParams &params)
+{
+    uint8 *pixels  = surface->pixels;
+    int32 width    = surface->width - 1;
+    int32 height   = surface->height - 1;
+    int32 lineSize = surface->lineSize;
+
+    while (lineCount--) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 lx              = scanline->position.x;
+        int32 ly              = scanline->position.y;
+        int32 dx              = scanline->deform.x;
+        int32 dy              = scanline->deform.y;
+        for (int32 i = 0; i < currentScreen->pitch; ++i) {
+            uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
+            if (palIndex)
+                InkPixel<inkEffect>::Draw(activePalette[palIndex], *frameBuffer, params);
+
+            lx += dx;
+            ly += dy;
+            ++frameBuffer;
+        }
+        ++scanline;
+    }
+}
+
+typedef void (*RectangleBlitter)(uint16 *frameBuffer, int32 pitch, int32 width, int32 height, uint16 color, const InkParams &params);
+typedef void (*ScanEdgeBlitter)(uint16 *frameBuffer, int32 pitch, ScanEdge *edge, int32 lineCount, int32 clipX1, int32 clipX2, uint16 color,
+                                const InkParams &params);
+typedef void (*SpriteBlitter)(uint16 *frameBuffer, int32 pitch, uint8 *pixels, int32 gfxPitch, uint8 *lineBuffer, int32 width, int32 height,
+                              const InkParams &params);
+typedef void (*RotozoomBlitter)(const RotozoomBlit &blit, const InkParams &params);
+typedef void (*DeformedSpriteBlitter)(uint16 *frameBuffer, uint8 *lineBuffer, ScanlineInfo *scanline, int32 lineCount, GFXSurface *surface,
+                                      const InkParams &params);
+
+static const RectangleBlitter rectangleBlitters[]           = INK_BLITTER_LIST(BlitRectangle);
+static const ScanEdgeBlitter scanEdgeBlitters[]             = INK_BLITTER_LIST(BlitScanEdges);
+static const SpriteBlitter spriteBlitters[2][8]             = { INK_BLITTER_LIST(SpriteBlit<false>::Blit), INK_BLITTER_LIST(SpriteBlit<true>::Blit) };
+static const RotozoomBlitter rotozoomBlitters[]             = INK_BLITTER_LIST(BlitSpriteRotozoom);
+static const DeformedSpriteBlitter deformedSpriteBlitters[] = INK_BLITTER_LIST(BlitDeformedSprite);
+
+// Draw commands
+// Everything a blitter needs to draw one clipped shape, so the same draw can be run straight away or queued up & run later in strips
+// Every command covers lineCount rows of the screen starting at startY, and can be run over any part of that range on its own
+
+enum DrawCommandTypes {
+    DRAWCMD_RECTANGLE,
+    DRAWCMD_SCANEDGES,
+    DRAWCMD_SPRITE,
+    DRAWCMD_ROTOZOOM,
+    DRAWCMD_DEFORMED,
+    DRAWCMD_LAYER_HSCROLL,
+    DRAWCMD_LAYER_ROTOZOOM,
+};
+
+struct DrawCommand {
+    uint8 type;
+    uint8 inkEffect;
+    uint8 flipX;
+    int32 startY;
+    int32 lineCount;
+    uint16 *frameBuffer; // start of the first row, unused by layers
+    InkParams params;
+    union {
+        struct {
+            int32 width;
+            uint16 color;
+        } rectangle;
+
+        struct {
+            ScanEdge *edges;
+            int32 clipX1;
+            int32 clipX2;
+            uint16 color;
+        } scanEdges;
+
+        struct {
+            uint8 *pixels;
+            int32 gfxPitch;
+            int32 width;
+        } sprite;
+
+        RotozoomBlit rotozoom;
+
+        struct {
+            ScanlineInfo *scanlines;
+            GFXSurface *surface;
+        } deformed;
+
+        struct {
+            TileLayer *layer;
+            ScanlineInfo *scanlines;
+            int32 clipX1;
+            int32 clipX2;
+        } layer;
+    };
+};
+
+// runs rows startY to endY of a command, which have to be within the rows it covers
+static void RunDrawCommand(const DrawCommand *command, int32 startY, int32 endY)
+{
+    int32 skip        = startY - command->startY;
+    int32 lineCount   = endY - startY;
+    uint8 *lineBuffer = &gfxLineBuffer[startY];
+
+    switch (command->type) {
+        default: break;
+
+        case DRAWCMD_RECTANGLE:
+            rectangleBlitters[command->inkEffect](&command->frameBuffer[skip * currentScreen->pitch], currentScreen->pitch - command->rectangle.width,
+                                                  command->rectangle.width, lineCount, command->rectangle.color, command->params);
+            break;
+
+        case DRAWCMD_SCANEDGES:
+            scanEdgeBlitters[command->inkEffect](&command->frameBuffer[skip * currentScreen->pitch], currentScreen->pitch,
+                                                 &command->scanEdges.edges[skip], lineCount, command->scanEdges.clipX1, command->scanEdges.clipX2,
+                                                 command->scanEdges.color, command->params);
+            break;
+
+        case DRAWCMD_SPRITE: {
+            int32 width      = command->sprite.width;
+            int32 lineStride = (command->flipX ? -width : width) + command->sprite.gfxPitch;
+            spriteBlitters[command->flipX][command->inkEffect](&command->frameBuffer[skip * currentScreen->pitch], currentScreen->pitch - width,
+                                                               &command->sprite.pixels[skip * lineStride], command->sprite.gfxPitch, lineBuffer,
+                                                               width, lineCount, command->params);
+            break;
+        }
+
+        case DRAWCMD_ROTOZOOM: {
+            // the draw position steps by a fixed amount per row, the sums are done unsigned so they wrap the same way stepping would
+            RotozoomBlit blit = command->rotozoom;
+            blit.frameBuffer  = &command->frameBuffer[skip * currentScreen->pitch];
+            blit.lineBuffer   = lineBuffer;
+            blit.ySize        = lineCount;
+            blit.drawX        = (int32)((uint32)blit.drawX - (uint32)skip * (uint32)blit.deltaXLen);
+            blit.drawY        = (int32)((uint32)blit.drawY + (uint32)skip * (uint32)blit.deltaYLen);
+            rotozoomBlitters[command->inkEffect](blit, command->params);
+            break;
+        }
+
+        case DRAWCMD_DEFORMED:
+            deformedSpriteBlitters[command->inkEffect](&command->frameBuffer[skip * currentScreen->pitch], lineBuffer,
+                                                       &command->deformed.scanlines[skip], lineCount, command->deformed.surface, command->params);
+            break;
+
+        case DRAWCMD_LAYER_HSCROLL: DrawLayerHScrollLines(command->layer.layer, &command->layer.scanlines[skip], startY, endY); break;
+
+        case DRAWCMD_LAYER_ROTOZOOM:
+            DrawLayerRotozoomLines(command->layer.layer, &command->layer.scanlines[skip], startY, endY, command->layer.clipX1, command->layer.clipX2);
+            break;
+    }
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+bool32 RSDK::useDeferredDrawing = false;
+
+static bool32 deferredDrawActive = false;
+
+static DrawCommand *drawCommands = NULL;
+static int32 drawCommandCount    = 0;
+static int32 drawCommandTop      = 0;
+static int32 drawCommandBottom   = 0;
+
+// holds the scan edges & scanlines commands use, since the originals get overwritten by the next draw
+static uint8 *drawCommandArena   = NULL;
+static int32 drawCommandArenaPos = 0;
+
+// command IDs for each strip, in queue order
+static uint16 *drawStripCommands = NULL;
+static int32 drawStripCommandCount[DRAWSTRIP_COUNT];
+static int32 drawStripTop[DRAWSTRIP_COUNT + 1];
+static int32 drawStripCount = 0;
+
+// strip 0 is always rasterized by the main thread, the rest get a thread each
+static std::thread drawThreads[DRAWSTRIP_COUNT - 1];
+static int32 drawThreadCount = 0;
+static std::mutex drawLock;
+static std::condition_variable drawCond;
+static std::condition_variable drawDoneCond;
+static uint32 drawJobID      = 0;
+static int32 drawThreadsBusy = 0;
+static bool32 drawQuit       = false;
+
+static void RasterizeDrawStrip(int32 stripID)
+{
+    int32 stripTop    = drawStripTop[stripID];
+    int32 stripBottom = drawStripTop[stripID + 1];
+
+    uint16 *commandIDs = &drawStripCommands[stripID * DRAWCOMMAND_COUNT];
+    for (int32 c = 0; c < drawStripCommandCount[stripID]; ++c) {
+        DrawCommand *command = &drawCommands[commandIDs[c]];
+        RunDrawCommand(command, MAX(command->startY, stripTop), MIN(command->startY + command->lineCount, stripBottom));
+    }
+}
+
+static void DrawThread(int32 stripID)
+{
+    uint32 jobID = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(drawLock);
+            drawCond.wait(lock, [&jobID] { return drawQuit || drawJobID != jobID; });
+            if (drawQuit)
+                break;
+
+            jobID = drawJobID;
+        }
+
+        if (stripID < drawStripCount)
+            RasterizeDrawStrip(stripID);
+
+        std::lock_guard<std::mutex> lock(drawLock);
+        if (!--drawThreadsBusy)
+            drawDoneCond.notify_one();
+    }
+}
+
+static void *AllocateDrawCommandData(const void *data, int32 dataSize)
+{
+    int32 size = (dataSize + 7) & ~7;
+    if (drawCommandArenaPos + size > DRAWCOMMAND_ARENA_SIZE)
+        FlushDrawCommands();
+
+    if (drawCommandArenaPos + size > DRAWCOMMAND_ARENA_SIZE)
+        return NULL;
+
+    void *copy = &drawCommandArena[drawCommandArenaPos];
+    memcpy(copy, data, dataSize);
+    drawCommandArenaPos += size;
+    return copy;
+}
+
+static void QueueDrawCommand(DrawCommand *command)
+{
+    if (command->lineCount <= 0)
+        return;
+
+    if (drawCommandCount >= DRAWCOMMAND_COUNT)
+        FlushDrawCommands();
+
+    void *data = NULL;
+    switch (command->type) {
+        default: break;
+
+        case DRAWCMD_SCANEDGES:
+            data = command->scanEdges.edges = (ScanEdge *)AllocateDrawCommandData(command->scanEdges.edges, command->lineCount * sizeof(ScanEdge));
+            break;
+
+        case DRAWCMD_DEFORMED:
+            data = command->deformed.scanlines =
+                (ScanlineInfo *)AllocateDrawCommandData(command->deformed.scanlines, command->lineCount * sizeof(ScanlineInfo));
+            break;
+
+        case DRAWCMD_LAYER_HSCROLL:
+        case DRAWCMD_LAYER_ROTOZOOM:
+            data = command->layer.scanlines =
+                (ScanlineInfo *)AllocateDrawCommandData(command->layer.scanlines, command->lineCount * sizeof(ScanlineInfo));
+            break;
+
+        case DRAWCMD_RECTANGLE:
+        case DRAWCMD_SPRITE:
+        case DRAWCMD_ROTOZOOM: data = command; break;
+    }
+
+    // too big to ever fit, the queue's empty by now so it can just be drawn
+    if (!data) {
+        RunDrawCommand(command, command->startY, command->startY + command->lineCount);
+        return;
+    }
+
+    if (!drawCommandCount) {
+        drawCommandTop    = command->startY;
+        drawCommandBottom = command->startY + command->lineCount;
+    }
+    else {
+        drawCommandTop    = MIN(drawCommandTop, command->startY);
+        drawCommandBottom = MAX(drawCommandBottom, command->startY + command->lineCount);
+    }
+
+    drawCommands[drawCommandCount++] = *command;
+}
+
+void RSDK::BeginDeferredDrawing()
+{
+    if (!useDeferredDrawing)
+        return;
+
+    if (!drawCommands) {
+        drawCommands      = (DrawCommand *)malloc(DRAWCOMMAND_COUNT * sizeof(DrawCommand));
+        drawCommandArena  = (uint8 *)malloc(DRAWCOMMAND_ARENA_SIZE);
+        drawStripCommands = (uint16 *)malloc(DRAWSTRIP_COUNT * DRAWCOMMAND_COUNT * sizeof(uint16));
+
+        if (!drawCommands || !drawCommandArena || !drawStripCommands) {
+            PrintLog(PRINT_NORMAL, "[DRAW] Failed to allocate the draw command queue, deferred drawing disabled");
+            ReleaseDeferredDrawing();
+            useDeferredDrawing = false;
+            return;
+        }
+    }
+
+    if (!drawThreadCount) {
+        int32 threadCount = MIN((int32)std::thread::hardware_concurrency(), DRAWSTRIP_COUNT) - 1;
+        if (threadCount <= 0) {
+            // nothing to gain with only the one core
+            PrintLog(PRINT_NORMAL, "[DRAW] Only one core available, deferred drawing disabled");
+            useDeferredDrawing = false;
+            return;
+        }
+
+        drawQuit = false;
+        for (int32 t = 0; t < threadCount; ++t) drawThreads[t] = std::thread(DrawThread, t + 1);
+        drawThreadCount = threadCount;
+    }
+
+    deferredDrawActive = true;
+}
+
+void RSDK::FlushDrawCommands()
+{
+    if (!drawCommandCount)
+        return;
+
+    // split the rows the queue covers evenly between the threads, without making strips so thin that most commands span all of them
+    int32 rowCount  = drawCommandBottom - drawCommandTop;
+    int32 stripSize = MAX((rowCount + drawThreadCount) / (drawThreadCount + 1), 16);
+    drawStripCount  = MIN((rowCount + stripSize - 1) / stripSize, drawThreadCount + 1);
+
+    for (int32 s = 0; s < drawStripCount; ++s) {
+        drawStripTop[s]          = drawCommandTop + s * stripSize;
+        drawStripCommandCount[s] = 0;
+    }
+    drawStripTop[drawStripCount] = drawCommandBottom;
+
+    for (int32 c = 0; c < drawCommandCount; ++c) {
+        DrawCommand *command = &drawCommands[c];
+        int32 firstStrip     = (command->startY - drawCommandTop) / stripSize;
+        int32 lastStrip      = MIN((command->startY + command->lineCount - 1 - drawCommandTop) / stripSize, drawStripCount - 1);
+
+        for (int32 s = firstStrip; s <= lastStrip; ++s) drawStripCommands[s * DRAWCOMMAND_COUNT + drawStripCommandCount[s]++] = c;
+    }
+
+    if (drawStripCount > 1) {
+        {
+            std::lock_guard<std::mutex> lock(drawLock);
+            drawThreadsBusy = drawThreadCount;
+            drawJobID++;
+        }
+        drawCond.notify_all();
+    }
+
+    RasterizeDrawStrip(0);
+
+    if (drawStripCount > 1) {
+        std::unique_lock<std::mutex> lock(drawLock);
+        drawDoneCond.wait(lock, [] { return !drawThreadsBusy; });
+    }
+
+    drawCommandCount    = 0;
+    drawCommandArenaPos = 0;
+}
+
+void RSDK::EndDeferredDrawing()
+{
+    FlushDrawCommands();
+    deferredDrawActive = false;
+}
+
+void RSDK::ReleaseDeferredDrawing()
+{
+    EndDeferredDrawing();
+
+    if (drawThreadCount) {
+        {
+            std::lock_guard<std::mutex> lock(drawLock);
+            drawQuit = true;
+        }
+        drawCond.notify_all();
+
+        for (int32 t = 0; t < drawThreadCount; ++t) drawThreads[t].join();
+        drawThreadCount = 0;
+    }
+
+    free(drawCommands);
+    free(drawCommandArena);
+    free(drawStripCommands);
+    drawCommands      = NULL;
+    drawCommandArena  = NULL;
+    drawStripCommands = NULL;
+}
+
+bool32 RSDK::DeferLayerDraw(TileLayer *layer)
+{
+    if (!deferredDrawActive)
+        return false;
+
+    DrawCommand command;
+    command.type            = layer->type == LAYER_ROTOZOOM ? DRAWCMD_LAYER_ROTOZOOM : DRAWCMD_LAYER_HSCROLL;
+    command.startY          = currentScreen->clipBound_Y1;
+    command.lineCount       = currentScreen->clipBound_Y2 - currentScreen->clipBound_Y1;
+    command.frameBuffer     = NULL;
+    command.layer.layer     = layer;
+    command.layer.scanlines = &scanlines[currentScreen->clipBound_Y1];
+    command.layer.clipX1    = currentScreen->clipBound_X1;
+    command.layer.clipX2    = currentScreen->clipBound_X2;
+    QueueDrawCommand(&command);
+    return true;
+}
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+bool32 RSDK::usePartialUploads = true;
+
+static FrameUploadInfo frameUploads[SCREEN_COUNT];
+
+bool32 RSDK::GetFrameUploadRows(int32 screenID, int32 textureID, int32 *startY, int32 *endY)
+{
+    *startY = 0;
+    *endY   = SCREEN_YSIZE;
+
+    FrameUploadInfo *upload = &frameUploads[screenID];
+    if (!usePartialUploads) {
+        // the hashes won't be kept up to date anymore
+        upload->pitch = 0;
+        return true;
+    }
+
+    ScreenInfo *screen  = &screens[screenID];
+    uint16 *frameBuffer = screen->frameBuffer;
+    uint32 serial       = ++upload->serial;
+
+    if (upload->pitch != screen->pitch) {
+        upload->pitch = screen->pitch;
+        for (int32 y = 0; y < SCREEN_YSIZE; ++y) {
+            upload->rowHashes[y]  = HashWordsFNV64(HASH_INIT_FNV64, frameBuffer, screen->pitch);
+            upload->rowSerials[y] = serial;
+            frameBuffer += screen->pitch;
+        }
+
+        for (int32 t = 0; t < FRAMEUPLOAD_TEXTURE_COUNT; ++t) upload->textureSerials[t] = 0;
+    }
+    else {
+        for (int32 y = 0; y < SCREEN_YSIZE; ++y) {
+            uint64 hash = HashWordsFNV64(HASH_INIT_FNV64, frameBuffer, screen->pitch);
+            if (hash != upload->rowHashes[y]) {
+                upload->rowHashes[y]  = hash;
+                upload->rowSerials[y] = serial;
+            }
+
+            frameBuffer += screen->pitch;
+        }
+    }
+
+    uint32 textureSerial              = upload->textureSerials[textureID];
+    upload->textureSerials[textureID] = serial;
+
+    int32 top    = 0;
+    int32 bottom = SCREEN_YSIZE;
+    while (top < bottom && upload->rowSerials[top] <= textureSerial) ++top;
+    while (bottom > top && upload->rowSerials[bottom - 1] <= textureSerial) --bottom;
+
+    if (top == bottom)
+        return false;
+
+    *startY = top;
+    *endY   = bottom;
+    return true;
+}
+
+void RSDK::InvalidateFrameUploads()
+{
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) {
+        frameUploads[s].pitch = 0;
+        for (int32 t = 0; t < FRAMEUPLOAD_TEXTURE_COUNT; ++t) frameUploads[s].textureSerials[t] = 0;
+    }
+}
+#endif
+
+// draws a command straight away, or queues it up if deferred drawing is active
+static inline void SubmitDrawCommand(DrawCommand *command)
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    if (deferredDrawActive) {
+        QueueDrawCommand(command);
+        return;
+    }
+#endif
+
+    RunDrawCommand(command, command->startY, command->startY + command->lineCount);
+}
+
 void RSDK::RenderDeviceBase::ProcessDimming()
 {
     // Bug Details:
@@ -585,6 +1293,11 @@ void RSDK::SwapDrawListEntries(uint8 drawGroup, uint16 slot1, uint16 slot2, uint
 
 void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    // drawn straight away, so anything queued has to land first
+    FlushDrawCommands();
+#endif
+
     alphaR = CLAMP(alphaR, 0x00, 0xFF);
     alphaG = CLAMP(alphaG, 0x00, 0xFF);
     alphaB = CLAMP(alphaB, 0x00, 0xFF);
@@ -614,6 +1327,10 @@ void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
 
 void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     switch (inkEffect) {
         default: break;
 
@@ -1143,28 +1860,9 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
 }
 void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
-    switch (inkEffect) {
-        default: break;
-        case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
-    }
+    InkParams params;
+    if (!SetupInkEffect(inkEffect, alpha, &params))
+        return;
 
     if (!screenRelative) {
         x      = FROM_FIXED(x) - currentScreen->position.x;
@@ -1192,150 +1890,27 @@ void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 col
     if (width <= 0 || height <= 0)
         return;
 
-    int32 pitch         = currentScreen->pitch - width;
-    validDraw           = true;
-    uint16 *frameBuffer = &currentScreen->frameBuffer[x + (y * currentScreen->pitch)];
-    uint16 color16      = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+    validDraw = true;
+    if (inkEffect < 0 || inkEffect >= (int32)(sizeof(rectangleBlitters) / sizeof(rectangleBlitters[0])))
+        return;
 
-    switch (inkEffect) {
-        case INK_NONE: {
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    *frameBuffer = color16;
-                    ++frameBuffer;
-                }
-
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_BLEND: {
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    setPixelBlend(color16, *frameBuffer);
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_ALPHA: {
-            uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-            uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    setPixelAlpha(color16, *frameBuffer, alpha);
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_ADD: {
-            uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-            int32 h               = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    setPixelAdditive(color16, *frameBuffer);
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_SUB: {
-            uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-            int32 h               = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    setPixelSubtractive(color16, *frameBuffer);
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_TINT: {
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    *frameBuffer = tintLookupTable[*frameBuffer];
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_MASKED: {
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    if (*frameBuffer == maskColor)
-                        *frameBuffer = color16;
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-
-        case INK_UNMASKED: {
-            int32 h = height;
-            while (h--) {
-                int32 w = width;
-                while (w--) {
-                    if (*frameBuffer != maskColor)
-                        *frameBuffer = color16;
-                    ++frameBuffer;
-                }
-                frameBuffer += pitch;
-            }
-            break;
-        }
-    }
+    DrawCommand command;
+    command.type            = DRAWCMD_RECTANGLE;
+    command.inkEffect       = inkEffect;
+    command.startY          = y;
+    command.lineCount       = height;
+    command.frameBuffer     = &currentScreen->frameBuffer[x + (y * currentScreen->pitch)];
+    command.params          = params;
+    command.rectangle.width = width;
+    command.rectangle.color = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+    SubmitDrawCommand(&command);
 }
 void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
     if (radius > 0) {
-        switch (inkEffect) {
-            default: break;
-            case INK_ALPHA:
-                if (alpha > 0xFF)
-                    inkEffect = INK_NONE;
-                else if (alpha <= 0)
-                    return;
-                break;
-
-            case INK_ADD:
-            case INK_SUB:
-                if (alpha > 0xFF)
-                    alpha = 0xFF;
-                else if (alpha <= 0)
-                    return;
-                break;
-
-            case INK_TINT:
-                if (!tintLookupTable)
-                    return;
-                break;
-        }
+        InkParams params;
+        if (!SetupInkEffect(inkEffect, alpha, &params))
+            return;
 
         if (!screenRelative) {
             x = FROM_FIXED(x) - currentScreen->position.x;
@@ -1418,228 +1993,19 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
             }
 
             // validDraw              = true;
-            uint16 *frameBuffer = &currentScreen->frameBuffer[top * currentScreen->pitch];
-            uint16 color16      = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
-
-            switch (inkEffect) {
-                default: break;
-                case INK_NONE:
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                frameBuffer[edge->start + x] = color16;
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-
-                case INK_BLEND:
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                setPixelBlend(color16, frameBuffer[edge->start + x]);
-                            }
-
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-
-                case INK_ALPHA:
-                    if (top <= bottom) {
-                        uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                        uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                setPixelAlpha(color16, frameBuffer[edge->start + x], alpha);
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                setPixelAdditive(color16, frameBuffer[edge->start + x]);
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-                }
-
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                setPixelSubtractive(color16, frameBuffer[edge->start + x]);
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-                }
-
-                case INK_TINT:
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                frameBuffer[edge->start + x] = tintLookupTable[frameBuffer[edge->start + x]];
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-
-                case INK_MASKED:
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                if (frameBuffer[edge->start + x] == maskColor)
-                                    frameBuffer[edge->start + x] = color16;
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
-
-                case INK_UNMASKED:
-                    if (top <= bottom) {
-                        ScanEdge *edge = &scanEdgeBuffer[top];
-                        int32 sizeY    = bottom - top;
-
-                        for (int32 y = 0; y < sizeY; ++y) {
-                            if (edge->start < currentScreen->clipBound_X1)
-                                edge->start = currentScreen->clipBound_X1;
-                            if (edge->start > currentScreen->clipBound_X2)
-                                edge->start = currentScreen->clipBound_X2;
-
-                            if (edge->end < currentScreen->clipBound_X1)
-                                edge->end = currentScreen->clipBound_X1;
-                            if (edge->end > currentScreen->clipBound_X2)
-                                edge->end = currentScreen->clipBound_X2;
-
-                            int32 count = edge->end - edge->start;
-                            for (int32 x = 0; x < count; ++x) {
-                                if (frameBuffer[edge->start + x] != maskColor)
-                                    frameBuffer[edge->start + x] = color16;
-                            }
-                            ++edge;
-                            frameBuffer += currentScreen->pitch;
-                        }
-                    }
-                    break;
+            if (top <= bottom && inkEffect >= 0 && inkEffect < (int32)(sizeof(scanEdgeBlitters) / sizeof(scanEdgeBlitters[0]))) {
+                DrawCommand command;
+                command.type             = DRAWCMD_SCANEDGES;
+                command.inkEffect        = inkEffect;
+                command.startY           = top;
+                command.lineCount        = bottom - top;
+                command.frameBuffer      = &currentScreen->frameBuffer[top * currentScreen->pitch];
+                command.params           = params;
+                command.scanEdges.edges  = &scanEdgeBuffer[top];
+                command.scanEdges.clipX1 = currentScreen->clipBound_X1;
+                command.scanEdges.clipX2 = currentScreen->clipBound_X2;
+                command.scanEdges.color  = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+                SubmitDrawCommand(&command);
             }
         }
     }
@@ -1647,6 +2013,10 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
 void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRadius, uint32 color, int32 alpha, int32 inkEffect,
                              bool32 screenRelative)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -1927,6 +2297,67 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
 
 void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32 b, int32 alpha, int32 inkEffect)
 {
+    InkParams params;
+    if (!SetupInkEffect(inkEffect, alpha, &params))
+        return;
+
+    int32 top    = 0x7FFFFFFF;
+    int32 bottom = -0x10000;
+    for (int32 v = 0; v < vertCount; ++v) {
+        if (vertices[v].y < top)
+            top = vertices[v].y;
+        if (vertices[v].y > bottom)
+            bottom = vertices[v].y;
+    }
+
+    int32 topScreen    = FROM_FIXED(top);
+    int32 bottomScreen = FROM_FIXED(bottom);
+
+    if (topScreen < currentScreen->clipBound_Y1)
+        topScreen = currentScreen->clipBound_Y1;
+    if (topScreen > currentScreen->clipBound_Y2)
+        topScreen = currentScreen->clipBound_Y2;
+
+    if (bottomScreen < currentScreen->clipBound_Y1)
+        bottomScreen = currentScreen->clipBound_Y1;
+    if (bottomScreen > currentScreen->clipBound_Y2)
+        bottomScreen = currentScreen->clipBound_Y2;
+
+    if (topScreen != bottomScreen) {
+        ScanEdge *edge = &scanEdgeBuffer[topScreen];
+        for (int32 s = topScreen; s <= bottomScreen; ++s) {
+            edge->start = 0x7FFF;
+            edge->end   = -1;
+            ++edge;
+        }
+
+        for (int32 v = 0; v < vertCount - 1; ++v) {
+            ProcessScanEdge(vertices[v + 0].x, vertices[v + 0].y, vertices[v + 1].x, vertices[v + 1].y);
+        }
+        ProcessScanEdge(vertices[0].x, vertices[0].y, vertices[vertCount - 1].x, vertices[vertCount - 1].y);
+
+        if (inkEffect >= 0 && inkEffect < (int32)(sizeof(scanEdgeBlitters) / sizeof(scanEdgeBlitters[0]))) {
+            DrawCommand command;
+            command.type             = DRAWCMD_SCANEDGES;
+            command.inkEffect        = inkEffect;
+            command.startY           = topScreen;
+            command.lineCount        = bottomScreen - topScreen + 1;
+            command.frameBuffer      = &currentScreen->frameBuffer[topScreen * currentScreen->pitch];
+            command.params           = params;
+            command.scanEdges.edges  = &scanEdgeBuffer[topScreen];
+            command.scanEdges.clipX1 = currentScreen->clipBound_X1;
+            command.scanEdges.clipX2 = currentScreen->clipBound_X2;
+            command.scanEdges.color  = rgb32To16_B[b] | rgb32To16_G[g] | rgb32To16_R[r];
+            SubmitDrawCommand(&command);
+        }
+    }
+}
+void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, int32 alpha, int32 inkEffect)
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -1981,32 +2412,58 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
         }
 
         for (int32 v = 0; v < vertCount - 1; ++v) {
-            ProcessScanEdge(vertices[v + 0].x, vertices[v + 0].y, vertices[v + 1].x, vertices[v + 1].y);
+            ProcessScanEdgeClr(colors[v + 0], colors[v + 1], vertices[v + 0].x, vertices[v + 0].y, vertices[v + 1].x, vertices[v + 1].y);
         }
-        ProcessScanEdge(vertices[0].x, vertices[0].y, vertices[vertCount - 1].x, vertices[vertCount - 1].y);
+        ProcessScanEdgeClr(colors[vertCount - 1], colors[0], vertices[vertCount - 1].x, vertices[vertCount - 1].y, vertices[0].x, vertices[0].y);
 
         uint16 *frameBuffer = &currentScreen->frameBuffer[topScreen * currentScreen->pitch];
-        uint16 color16      = rgb32To16_B[b] | rgb32To16_G[g] | rgb32To16_R[r];
 
         edge = &scanEdgeBuffer[topScreen];
         switch (inkEffect) {
             default: break;
-
             case INK_NONE:
                 for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
+                    int32 count  = edge->end - edge->start;
+                    int32 deltaR = 0;
+                    int32 deltaG = 0;
+                    int32 deltaB = 0;
+                    if (count > 0) {
+                        deltaR = (edge->endR - edge->startR) / count;
+                        deltaG = (edge->endG - edge->startG) / count;
+                        deltaB = (edge->endB - edge->startB) / count;
+                    }
+                    int32 startR = edge->startR;
+                    int32 startG = edge->startG;
+                    int32 startB = edge->startB;
+
+                    if (edge->start > currentScreen->clipBound_X2) {
                         edge->start = currentScreen->clipBound_X2;
+                    }
+                    else if (edge->start < currentScreen->clipBound_X1) {
+                        int32 dist = (currentScreen->clipBound_X1 - edge->start);
+                        startR += deltaR * dist;
+                        startG += deltaG * dist;
+                        startB += deltaB * dist;
+                        count -= dist;
+                        edge->start = currentScreen->clipBound_X1;
+                    }
 
-                    if (edge->end < currentScreen->clipBound_X1)
+                    if (edge->end < currentScreen->clipBound_X1) {
                         edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
+                        count     = currentScreen->clipBound_X1 - edge->start;
+                    }
+
+                    if (edge->end > currentScreen->clipBound_X2) {
                         edge->end = currentScreen->clipBound_X2;
+                        count     = currentScreen->clipBound_X2 - edge->start;
+                    }
 
-                    int32 count = edge->end - edge->start;
                     for (int32 x = 0; x < count; ++x) {
-                        frameBuffer[edge->start + x] = color16;
+                        frameBuffer[edge->start + x] = (startB >> 19) + ((startG >> 13) & 0x7E0) + ((startR >> 8) & 0xF800);
+
+                        startR += deltaR;
+                        startG += deltaG;
+                        startB += deltaB;
                     }
                     ++edge;
                     frameBuffer += currentScreen->pitch;
@@ -2015,327 +2472,48 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
 
             case INK_BLEND:
                 for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
+                    int32 start  = edge->start;
+                    int32 count  = edge->end - edge->start;
+                    int32 deltaR = 0;
+                    int32 deltaG = 0;
+                    int32 deltaB = 0;
+                    if (count > 0) {
+                        deltaR = (edge->endR - edge->startR) / count;
+                        deltaG = (edge->endG - edge->startG) / count;
+                        deltaB = (edge->endB - edge->startB) / count;
+                    }
+                    int32 startR = edge->startR;
+                    int32 startG = edge->startG;
+                    int32 startB = edge->startB;
+
+                    if (start > currentScreen->clipBound_X2) {
                         edge->start = currentScreen->clipBound_X2;
+                    }
+
+                    if (start < currentScreen->clipBound_X1) {
+                        startR += deltaR * (currentScreen->clipBound_X1 - edge->start);
+                        startG += deltaG * (currentScreen->clipBound_X1 - edge->start);
+                        startB += deltaB * (currentScreen->clipBound_X1 - edge->start);
+                        count -= (currentScreen->clipBound_X1 - edge->start);
+                        edge->start = currentScreen->clipBound_X1;
+                    }
 
-                    if (edge->end < currentScreen->clipBound_X1)
+                    if (edge->end < currentScreen->clipBound_X1) {
                         edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
+                    }
+
+                    if (edge->end > currentScreen->clipBound_X2) {
                         edge->end = currentScreen->clipBound_X2;
+                        count     = currentScreen->clipBound_X2 - edge->start;
+                    }
 
-                    int32 count = edge->end - edge->start;
                     for (int32 x = 0; x < count; ++x) {
-                        setPixelBlend(color16, frameBuffer[edge->start + x]);
-                    }
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-
-            case INK_ALPHA: {
-                uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelAlpha(color16, frameBuffer[edge->start + x], alpha);
-                    }
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-            }
-
-            case INK_ADD: {
-                uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelAdditive(color16, frameBuffer[edge->start + x]);
-                    }
-
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-            }
-
-            case INK_SUB: {
-                uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelSubtractive(color16, frameBuffer[edge->start + x]);
-                    }
-
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-            }
-
-            case INK_TINT:
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        frameBuffer[edge->start + x] = tintLookupTable[frameBuffer[edge->start + x]];
-                    }
-
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-
-            case INK_MASKED:
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        if (frameBuffer[edge->start + x] == maskColor)
-                            frameBuffer[edge->start + x] = color16;
-                    }
-
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-
-            case INK_UNMASKED:
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    if (edge->start < currentScreen->clipBound_X1)
-                        edge->start = currentScreen->clipBound_X1;
-                    if (edge->start > currentScreen->clipBound_X2)
-                        edge->start = currentScreen->clipBound_X2;
-
-                    if (edge->end < currentScreen->clipBound_X1)
-                        edge->end = currentScreen->clipBound_X1;
-                    if (edge->end > currentScreen->clipBound_X2)
-                        edge->end = currentScreen->clipBound_X2;
-
-                    int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        if (frameBuffer[edge->start + x] != maskColor)
-                            frameBuffer[edge->start + x] = color16;
-                    }
-
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-        }
-    }
-}
-void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, int32 alpha, int32 inkEffect)
-{
-    switch (inkEffect) {
-        default: break;
-        case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
-    }
-
-    int32 top    = 0x7FFFFFFF;
-    int32 bottom = -0x10000;
-    for (int32 v = 0; v < vertCount; ++v) {
-        if (vertices[v].y < top)
-            top = vertices[v].y;
-        if (vertices[v].y > bottom)
-            bottom = vertices[v].y;
-    }
-
-    int32 topScreen    = FROM_FIXED(top);
-    int32 bottomScreen = FROM_FIXED(bottom);
-
-    if (topScreen < currentScreen->clipBound_Y1)
-        topScreen = currentScreen->clipBound_Y1;
-    if (topScreen > currentScreen->clipBound_Y2)
-        topScreen = currentScreen->clipBound_Y2;
-
-    if (bottomScreen < currentScreen->clipBound_Y1)
-        bottomScreen = currentScreen->clipBound_Y1;
-    if (bottomScreen > currentScreen->clipBound_Y2)
-        bottomScreen = currentScreen->clipBound_Y2;
-
-    if (topScreen != bottomScreen) {
-        ScanEdge *edge = &scanEdgeBuffer[topScreen];
-        for (int32 s = topScreen; s <= bottomScreen; ++s) {
-            edge->start = 0x7FFF;
-            edge->end   = -1;
-            ++edge;
-        }
-
-        for (int32 v = 0; v < vertCount - 1; ++v) {
-            ProcessScanEdgeClr(colors[v + 0], colors[v + 1], vertices[v + 0].x, vertices[v + 0].y, vertices[v + 1].x, vertices[v + 1].y);
-        }
-        ProcessScanEdgeClr(colors[vertCount - 1], colors[0], vertices[vertCount - 1].x, vertices[vertCount - 1].y, vertices[0].x, vertices[0].y);
-
-        uint16 *frameBuffer = &currentScreen->frameBuffer[topScreen * currentScreen->pitch];
-
-        edge = &scanEdgeBuffer[topScreen];
-        switch (inkEffect) {
-            default: break;
-            case INK_NONE:
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    int32 count  = edge->end - edge->start;
-                    int32 deltaR = 0;
-                    int32 deltaG = 0;
-                    int32 deltaB = 0;
-                    if (count > 0) {
-                        deltaR = (edge->endR - edge->startR) / count;
-                        deltaG = (edge->endG - edge->startG) / count;
-                        deltaB = (edge->endB - edge->startB) / count;
-                    }
-                    int32 startR = edge->startR;
-                    int32 startG = edge->startG;
-                    int32 startB = edge->startB;
-
-                    if (edge->start > currentScreen->clipBound_X2) {
-                        edge->start = currentScreen->clipBound_X2;
-                    }
-                    else if (edge->start < currentScreen->clipBound_X1) {
-                        int32 dist = (currentScreen->clipBound_X1 - edge->start);
-                        startR += deltaR * dist;
-                        startG += deltaG * dist;
-                        startB += deltaB * dist;
-                        count -= dist;
-                        edge->start = currentScreen->clipBound_X1;
-                    }
-
-                    if (edge->end < currentScreen->clipBound_X1) {
-                        edge->end = currentScreen->clipBound_X1;
-                        count     = currentScreen->clipBound_X1 - edge->start;
-                    }
-
-                    if (edge->end > currentScreen->clipBound_X2) {
-                        edge->end = currentScreen->clipBound_X2;
-                        count     = currentScreen->clipBound_X2 - edge->start;
-                    }
-
-                    for (int32 x = 0; x < count; ++x) {
-                        frameBuffer[edge->start + x] = (startB >> 19) + ((startG >> 13) & 0x7E0) + ((startR >> 8) & 0xF800);
-
-                        startR += deltaR;
-                        startG += deltaG;
-                        startB += deltaB;
-                    }
-                    ++edge;
-                    frameBuffer += currentScreen->pitch;
-                }
-                break;
-
-            case INK_BLEND:
-                for (int32 s = topScreen; s <= bottomScreen; ++s) {
-                    int32 start  = edge->start;
-                    int32 count  = edge->end - edge->start;
-                    int32 deltaR = 0;
-                    int32 deltaG = 0;
-                    int32 deltaB = 0;
-                    if (count > 0) {
-                        deltaR = (edge->endR - edge->startR) / count;
-                        deltaG = (edge->endG - edge->startG) / count;
-                        deltaB = (edge->endB - edge->startB) / count;
-                    }
-                    int32 startR = edge->startR;
-                    int32 startG = edge->startG;
-                    int32 startB = edge->startB;
-
-                    if (start > currentScreen->clipBound_X2) {
-                        edge->start = currentScreen->clipBound_X2;
-                    }
-
-                    if (start < currentScreen->clipBound_X1) {
-                        startR += deltaR * (currentScreen->clipBound_X1 - edge->start);
-                        startG += deltaG * (currentScreen->clipBound_X1 - edge->start);
-                        startB += deltaB * (currentScreen->clipBound_X1 - edge->start);
-                        count -= (currentScreen->clipBound_X1 - edge->start);
-                        edge->start = currentScreen->clipBound_X1;
-                    }
-
-                    if (edge->end < currentScreen->clipBound_X1) {
-                        edge->end = currentScreen->clipBound_X1;
-                    }
-
-                    if (edge->end > currentScreen->clipBound_X2) {
-                        edge->end = currentScreen->clipBound_X2;
-                        count     = currentScreen->clipBound_X2 - edge->start;
-                    }
-
-                    for (int32 x = 0; x < count; ++x) {
-                        uint16 color = (startB >> 19) + ((startG >> 13) & 0x7E0) + ((startR >> 8) & 0xF800);
-                        setPixelBlend(color, frameBuffer[edge->start + x]);
-
-                        startR += deltaR;
-                        startG += deltaG;
-                        startB += deltaB;
+                        uint16 color = (startB >> 19) + ((startG >> 13) & 0x7E0) + ((startR >> 8) & 0xF800);
+                        setPixelBlend(color, frameBuffer[edge->start + x]);
+
+                        startR += deltaR;
+                        startG += deltaG;
+                        startB += deltaB;
                     }
 
                     ++edge;
@@ -2854,28 +3032,9 @@ void RSDK::DrawSprite(Animator *animator, Vector2 *position, bool32 screenRelati
 void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect, int32 alpha,
                              int32 sheetID)
 {
-    switch (inkEffect) {
-        default: break;
-        case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
-    }
+    InkParams params;
+    if (!SetupInkEffect(inkEffect, alpha, &params))
+        return;
     int32 widthFlip  = width;
     int32 heightFlip = height;
 
@@ -2898,645 +3057,62 @@ void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32
         sprY -= val;
         height += val;
         heightFlip += 2 * val;
-        y = currentScreen->clipBound_Y1;
-    }
-
-    if (width <= 0 || height <= 0)
-        return;
-
-    GFXSurface *surface = &gfxSurface[sheetID];
-    validDraw           = true;
-    int32 pitch         = currentScreen->pitch - width;
-    int32 gfxPitch      = 0;
-    uint8 *lineBuffer   = NULL;
-    uint8 *pixels       = NULL;
-    uint16 *frameBuffer = NULL;
-
-    switch (direction) {
-        default: break;
-
-        case FLIP_NONE:
-            gfxPitch    = surface->width - width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[sprX + surface->width * sprY];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-            }
-            break;
-
-        case FLIP_X:
-            gfxPitch    = width + surface->width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[widthFlip - 1 + sprX + surface->width * sprY];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-            }
-            break;
-
-        case FLIP_Y:
-            gfxPitch    = width + surface->width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[sprX + surface->width * (sprY + heightFlip - 1)];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
-
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-            }
-            break;
+        y = currentScreen->clipBound_Y1;
+    }
 
-        case FLIP_XY:
-            gfxPitch    = surface->width - width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[widthFlip - 1 + sprX + surface->width * (sprY + heightFlip - 1)];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+    if (width <= 0 || height <= 0)
+        return;
 
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+    GFXSurface *surface = &gfxSurface[sheetID];
+    validDraw           = true;
+    if (inkEffect < 0 || inkEffect >= (int32)(sizeof(spriteBlitters[0]) / sizeof(spriteBlitters[0][0])))
+        return;
 
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+    DrawCommand command;
+    command.type         = DRAWCMD_SPRITE;
+    command.inkEffect    = inkEffect;
+    command.startY       = y;
+    command.lineCount    = height;
+    command.frameBuffer  = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
+    command.params       = params;
+    command.sprite.width = width;
 
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+    switch (direction) {
+        default: return;
 
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+        case FLIP_NONE:
+            command.flipX           = false;
+            command.sprite.pixels   = &surface->pixels[sprX + surface->width * sprY];
+            command.sprite.gfxPitch = surface->width - width;
+            break;
 
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+        case FLIP_X:
+            command.flipX           = true;
+            command.sprite.pixels   = &surface->pixels[widthFlip - 1 + sprX + surface->width * sprY];
+            command.sprite.gfxPitch = width + surface->width;
+            break;
 
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+        case FLIP_Y:
+            command.flipX           = false;
+            command.sprite.pixels   = &surface->pixels[sprX + surface->width * (sprY + heightFlip - 1)];
+            command.sprite.gfxPitch = -(width + surface->width);
+            break;
 
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-            }
+        case FLIP_XY:
+            command.flipX           = true;
+            command.sprite.pixels   = &surface->pixels[widthFlip - 1 + sprX + surface->width * (sprY + heightFlip - 1)];
+            command.sprite.gfxPitch = -(surface->width - width);
             break;
     }
+
+    SubmitDrawCommand(&command);
 }
 void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 width, int32 height, int32 sprX, int32 sprY, int32 scaleX,
                               int32 scaleY, int32 direction, int16 rotation, int32 inkEffect, int32 alpha, int32 sheetID)
 {
-    switch (inkEffect) {
-        default: break;
-        case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
-    }
+    InkParams params;
+    if (!SetupInkEffect(inkEffect, alpha, &params))
+        return;
 
     int32 angle = 0x200 - (rotation & 0x1FF);
     if (!(rotation & 0x1FF))
@@ -3634,441 +3210,79 @@ void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int3
     int32 ySize = bottom - top;
     if (xSize >= 1 && ySize >= 1) {
         GFXSurface *surface = &gfxSurface[sheetID];
-
-        int32 fullX         = TO_FIXED(sprX + width);
-        int32 fullY         = TO_FIXED(sprY + height);
         validDraw           = true;
-        int32 fullScaleX    = (int32)((512.0 / (float)scaleX) * 512.0);
-        int32 fullScaleY    = (int32)((512.0 / (float)scaleY) * 512.0);
-        int32 deltaXLen     = fullScaleX * sine >> 2;
-        int32 deltaX        = fullScaleX * cosine >> 2;
-        int32 pitch         = currentScreen->pitch - xSize;
-        int32 deltaYLen     = fullScaleY * cosine >> 2;
-        int32 deltaY        = fullScaleY * sine >> 2;
-        int32 lineSize      = surface->lineSize;
-        uint8 *lineBuffer   = &gfxLineBuffer[top];
-        int32 xLen          = left - x;
-        int32 yLen          = top - y;
-        uint8 *pixels       = surface->pixels;
-        uint16 *frameBuffer = &currentScreen->frameBuffer[left + (top * currentScreen->pitch)];
-        int32 fullSprX      = TO_FIXED(sprX) - 1;
-        int32 fullSprY      = TO_FIXED(sprY) - 1;
-
-        int32 drawX = 0, drawY = 0;
+        if (inkEffect < 0 || inkEffect >= (int32)(sizeof(rotozoomBlitters) / sizeof(rotozoomBlitters[0])))
+            return;
+
+        int32 fullScaleX = (int32)((512.0 / (float)scaleX) * 512.0);
+        int32 fullScaleY = (int32)((512.0 / (float)scaleY) * 512.0);
+        int32 xLen       = left - x;
+        int32 yLen       = top - y;
+
+        DrawCommand command;
+        command.type        = DRAWCMD_ROTOZOOM;
+        command.inkEffect   = inkEffect;
+        command.startY      = top;
+        command.lineCount   = ySize;
+        command.frameBuffer = &currentScreen->frameBuffer[left + (top * currentScreen->pitch)];
+        command.params      = params;
+
+        RotozoomBlit &blit = command.rotozoom;
+        blit.pitch         = currentScreen->pitch - xSize;
+        blit.pixels        = surface->pixels;
+        blit.lineSize      = surface->lineSize;
+        blit.xSize       = xSize;
+        blit.ySize       = ySize;
+        blit.deltaXLen   = fullScaleX * sine >> 2;
+        blit.deltaX      = fullScaleX * cosine >> 2;
+        blit.deltaYLen   = fullScaleY * cosine >> 2;
+        blit.deltaY      = fullScaleY * sine >> 2;
+        blit.fullSprX    = TO_FIXED(sprX) - 1;
+        blit.fullSprY    = TO_FIXED(sprY) - 1;
+        blit.fullX       = TO_FIXED(sprX + width);
+        blit.fullY       = TO_FIXED(sprY + height);
+        blit.drawX       = 0;
+        blit.drawY       = 0;
+
         if (direction == FLIP_X) {
-            drawX     = sprXPos + deltaXLen * yLen - deltaX * xLen - (fullScaleX >> 1);
-            drawY     = sprYPos + deltaYLen * yLen + deltaY * xLen;
-            deltaX    = -deltaX;
-            deltaXLen = -deltaXLen;
+            blit.drawX     = sprXPos + blit.deltaXLen * yLen - blit.deltaX * xLen - (fullScaleX >> 1);
+            blit.drawY     = sprYPos + blit.deltaYLen * yLen + blit.deltaY * xLen;
+            blit.deltaX    = -blit.deltaX;
+            blit.deltaXLen = -blit.deltaXLen;
         }
         else if (!direction) {
-            drawX = sprXPos + deltaX * xLen - deltaXLen * yLen;
-            drawY = sprYPos + deltaYLen * yLen + deltaY * xLen;
+            blit.drawX = sprXPos + blit.deltaX * xLen - blit.deltaXLen * yLen;
+            blit.drawY = sprYPos + blit.deltaYLen * yLen + blit.deltaY * xLen;
         }
 
-        switch (inkEffect) {
-            case INK_NONE:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_BLEND:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                setPixelBlend(activePalette[index], *frameBuffer);
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_ALPHA: {
-                uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelAlpha(activePalette[index], *frameBuffer, alpha);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_ADD: {
-                uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelAdditive(activePalette[index], *frameBuffer);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_SUB: {
-                uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelSubtractive(activePalette[index], *frameBuffer);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_TINT:
-                for (int32 y = 0; y < ySize; ++y) {
-                    int32 drawXPos = drawX;
-                    int32 drawYPos = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_MASKED:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_UNMASKED:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-        }
+        SubmitDrawCommand(&command);
     }
 }
 
 void RSDK::DrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha)
 {
-    switch (inkEffect) {
-        default: break;
-        case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
-
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
-    }
-
-    validDraw              = true;
-    GFXSurface *surface    = &gfxSurface[sheetID];
-    uint8 *pixels          = surface->pixels;
-    int32 clipY1           = currentScreen->clipBound_Y1;
-    ScanlineInfo *scanline = &scanlines[clipY1];
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[clipY1 * currentScreen->pitch];
-    uint8 *lineBuffer      = &gfxLineBuffer[clipY1];
-    int32 width            = surface->width - 1;
-    int32 height           = surface->height - 1;
-    int32 lineSize         = surface->lineSize;
-
-    switch (inkEffect) {
-        case INK_NONE:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        *frameBuffer = activePalette[palIndex];
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-
-        case INK_BLEND:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        setPixelBlend(activePalette[palIndex], *frameBuffer);
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-
-        case INK_ALPHA: {
-            uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-            uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelAlpha(activePalette[palIndex], *frameBuffer, alpha);
-                    }
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
-
-        case INK_ADD: {
-            uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelAdditive(activePalette[palIndex], *frameBuffer);
-                    }
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
-
-        case INK_SUB: {
-            uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelSubtractive(activePalette[palIndex], *frameBuffer);
-                    }
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
+    InkParams params;
+    if (!SetupInkEffect(inkEffect, alpha, &params))
+        return;
 
-        case INK_TINT:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                int32 lx = scanline->position.x;
-                int32 ly = scanline->position.y;
-                int32 dx = scanline->deform.x;
-                int32 dy = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        *frameBuffer = tintLookupTable[*frameBuffer];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
+    validDraw = true;
+    if (inkEffect < 0 || inkEffect >= (int32)(sizeof(deformedSpriteBlitters) / sizeof(deformedSpriteBlitters[0])))
+        return;
 
-        case INK_MASKED:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex && *frameBuffer == maskColor)
-                        *frameBuffer = activePalette[palIndex];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
+    int32 clipY1 = currentScreen->clipBound_Y1;
+    if (clipY1 >= currentScreen->clipBound_Y2)
+        return;
 
-        case INK_UNMASKED:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex && *frameBuffer != maskColor)
-                        *frameBuffer = activePalette[palIndex];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-    }
+    DrawCommand command;
+    command.type               = DRAWCMD_DEFORMED;
+    command.inkEffect          = inkEffect;
+    command.startY             = clipY1;
+    command.lineCount          = currentScreen->clipBound_Y2 - clipY1;
+    command.frameBuffer        = &currentScreen->frameBuffer[clipY1 * currentScreen->pitch];
+    command.params             = params;
+    command.deformed.scanlines = &scanlines[clipY1];
+    command.deformed.surface   = &gfxSurface[sheetID];
+    SubmitDrawCommand(&command);
 }
 
 void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position, Vector2 *offset, bool32 screenRelative)
@@ -4101,6 +3315,10 @@ void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position
                 for (int32 ty = 0; ty < countY; ++ty) {
                     for (int32 tx = 0; tx < countX; ++tx) {
                         uint16 tile = tiles[tx + (ty * countX)];
+#if !RETRO_USE_ORIGINAL_CODE
+                        if (tile < 0xFFFF && tileOpacity[tile & 0xFFF] == TILEOPACITY_EMPTY)
+                            continue;
+#endif
                         if (tile < 0xFFFF) {
                             DrawSpriteFlipped((tx * TILE_SIZE) + pivotX, (ty * TILE_SIZE) + pivotY, TILE_SIZE, TILE_SIZE, 0,
                                               TILE_SIZE * (tile & 0xFFF), FLIP_NONE, sceneInfo.entity->inkEffect, sceneInfo.entity->alpha, 0);
@@ -4123,6 +3341,10 @@ void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position
                 for (int32 ty = 0; ty < countY; ++ty) {
                     for (int32 tx = 0; tx < countX; ++tx) {
                         uint16 tile = tiles[tx + (ty * countX)];
+#if !RETRO_USE_ORIGINAL_CODE
+                        if (tile < 0xFFFF && tileOpacity[tile & 0xFFF] == TILEOPACITY_EMPTY)
+                            continue;
+#endif
                         if (tile < 0xFFFF) {
                             switch ((tile >> 10) & 3) {
                                 case FLIP_NONE:
@@ -4168,6 +3390,10 @@ void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position
                 for (int32 ty = 0; ty < countY; ++ty) {
                     for (int32 tx = 0; tx < countX; ++tx) {
                         uint16 tile = tiles[tx + (ty * countX)];
+#if !RETRO_USE_ORIGINAL_CODE
+                        if (tile < 0xFFFF && tileOpacity[tile & 0xFFF] == TILEOPACITY_EMPTY)
+                            continue;
+#endif
                         if (tile < 0xFFFF) {
                             switch ((tile >> 10) & 3) {
                                 case FLIP_NONE:
@@ -4213,6 +3439,10 @@ void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position
                 for (int32 ty = 0; ty < countY; ++ty) {
                     for (int32 tx = 0; tx < countX; ++tx) {
                         uint16 tile = tiles[tx + (ty * countX)];
+#if !RETRO_USE_ORIGINAL_CODE
+                        if (tile < 0xFFFF && tileOpacity[tile & 0xFFF] == TILEOPACITY_EMPTY)
+                            continue;
+#endif
                         if (tile < 0xFFFF) {
                             switch ((tile >> 10) & 3) {
                                 case FLIP_NONE:
@@ -4248,6 +3478,10 @@ void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position
 }
 void RSDK::DrawAniTile(uint16 sheetID, uint16 tileIndex, uint16 srcX, uint16 srcY, uint16 width, uint16 height)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    // queued draws could still be using the old tiles
+    FlushDrawCommands();
+#endif
 
     if (sheetID < SURFACE_COUNT && tileIndex < TILE_COUNT) {
         GFXSurface *surface = &gfxSurface[sheetID];
@@ -4306,6 +3540,10 @@ void RSDK::DrawAniTile(uint16 sheetID, uint16 tileIndex, uint16 srcX, uint16 src
                 tilePixels += (TILE_SIZE * 2);
             }
         }
+
+#if !RETRO_USE_ORIGINAL_CODE
+        UpdateTileOpacity(tileIndex, cnt);
+#endif
     }
 }
 
@@ -4391,6 +3629,10 @@ void RSDK::DrawString(Animator *animator, Vector2 *position, String *string, int
 }
 void RSDK::DrawDevString(const char *string, int32 x, int32 y, int32 align, uint32 color)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     uint16 color16 = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
 
     int32 charOffset   = 0;
@@ -407,6 +407,56 @@ void DrawString(Animator *animator, Vector2 *position, String *string, int32 end
                 Vector2 *charPositions, bool32 screenRelative);
 void DrawDevString(const char *string, int32 x, int32 y, int32 align, uint32 color);
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Deferred drawing
+// While it's active (one screen at a time, inside ProcessObjectDrawLists) the draw functions still do all their clipping & validDraw
+// checks straight away, but the actual blitting is queued up instead. On a flush the queue is binned into horizontal strips which are
+// rasterized on worker threads, each strip replaying its commands in the order they were queued, so the output is the same either way
+// Anything a queued command reads later (palettes, the tint table, the mask colour, tilesets & tile layouts) flushes the queue before it
+// changes, and draw functions that aren't queued (lines, outlines, blended faces, VScroll/Basic layers...) flush before drawing
+#define DRAWCOMMAND_COUNT      (0x1000)
+#define DRAWCOMMAND_ARENA_SIZE (0x40000)
+#define DRAWSTRIP_COUNT        (8)
+
+struct TileLayer;
+
+// exposed as a viewable variable
+extern bool32 useDeferredDrawing;
+
+void BeginDeferredDrawing();
+void FlushDrawCommands();
+void EndDeferredDrawing();
+void ReleaseDeferredDrawing();
+
+// returns false if the layer should just be drawn straight away
+bool32 DeferLayerDraw(TileLayer *layer);
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Frame uploads
+// Each row of a screen's frame buffer is hashed right before it gets uploaded & compared against its hash from the last upload, so
+// render devices only have to upload the band of rows that changed since that texture was last written to, or nothing at all when the
+// frame is identical (pause menus, static title cards & so on)
+// Devices that cycle through more than one texture per screen tell it which one they're uploading to, so each one catches up on the rows it missed
+#define FRAMEUPLOAD_TEXTURE_COUNT (2)
+
+struct FrameUploadInfo {
+    uint64 rowHashes[SCREEN_YSIZE];
+    uint32 rowSerials[SCREEN_YSIZE]; // the upload each row last changed on
+    uint32 textureSerials[FRAMEUPLOAD_TEXTURE_COUNT]; // the upload each texture was last brought up to date on, 0 if its contents are unknown
+    uint32 serial;
+    int32 pitch; // the pitch the hashes were taken with, 0 if they're invalid
+};
+
+// exposed as a viewable variable
+extern bool32 usePartialUploads;
+
+// returns false if the texture already matches the screen's frame buffer, otherwise sets the rows that need uploading (startY to endY - 1)
+bool32 GetFrameUploadRows(int32 screenID, int32 textureID, int32 *startY, int32 *endY);
+// has to be called whenever the screen textures are (re)created, so the next uploads are full ones
+void InvalidateFrameUploads();
+#endif
+
 inline void ClearGfxSurfaces()
 {
     // Unload sprite sheets
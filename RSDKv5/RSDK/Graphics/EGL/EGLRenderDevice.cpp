@@ -84,12 +84,19 @@ GLuint RenderDevice::VBO;
 GLuint RenderDevice::screenTextures[SCREEN_COUNT];
 // Back buffer we upload into this frame, then swap:
 static GLuint screenTexturesBack[SCREEN_COUNT];
+#if !RETRO_USE_ORIGINAL_CODE
+// which of the two texture sets the back buffer currently is, so frame uploads know what each one is missing
+static int32 screenTexturesBackID = 0;
+#endif
 static inline void swapScreenTextureSets() {
     for (int i = 0; i < SCREEN_COUNT; ++i) {
         GLuint tmp              = RenderDevice::screenTextures[i];
         RenderDevice::screenTextures[i] = screenTexturesBack[i];
         screenTexturesBack[i]   = tmp;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    screenTexturesBackID ^= 1;
+#endif
 }
 GLuint RenderDevice::imageTexture;
 
@@ -429,6 +436,9 @@ bool RenderDevice::InitGraphicsAPI()
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
     glGenTextures(1, &imageTexture);
     glBindTexture(GL_TEXTURE_2D, imageTexture);
 #if RETRO_PLATFORM == RETRO_SWITCH
@@ -641,8 +651,19 @@ void RenderDevice::CopyFrameBuffer()
         return;
 
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if RETRO_USE_ORIGINAL_CODE
         glBindTexture(GL_TEXTURE_2D, screenTexturesBack[s]);
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, screens[s].pitch, SCREEN_YSIZE, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, screens[s].frameBuffer);
+#else
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, screenTexturesBackID, &startY, &endY))
+            continue;
+
+        glBindTexture(GL_TEXTURE_2D, screenTexturesBack[s]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, startY, screens[s].pitch, endY - startY, GL_RGB, GL_UNSIGNED_SHORT_5_6_5,
+                        &screens[s].frameBuffer[startY * screens[s].pitch]);
+#endif
     }
 }
 
@@ -342,6 +342,9 @@ bool RenderDevice::InitGraphicsAPI()
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
     glGenTextures(1, &imageTexture);
     glBindTexture(GL_TEXTURE_2D, imageTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, RETRO_VIDEO_TEXTURE_W, RETRO_VIDEO_TEXTURE_H, 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
@@ -532,8 +535,19 @@ void RenderDevice::UpdateFPSCap() { lastFrame = glfwGetTime(); }
 void RenderDevice::CopyFrameBuffer()
 {
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if RETRO_USE_ORIGINAL_CODE
         glBindTexture(GL_TEXTURE_2D, screenTextures[s]);
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, screens[s].pitch, SCREEN_YSIZE, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, screens[s].frameBuffer);
+#else
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, 0, &startY, &endY))
+            continue;
+
+        glBindTexture(GL_TEXTURE_2D, screenTextures[s]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, startY, screens[s].pitch, endY - startY, GL_RGB, GL_UNSIGNED_SHORT_5_6_5,
+                        &screens[s].frameBuffer[startY * screens[s].pitch]);
+#endif
     }
 }
 
@@ -20,6 +20,25 @@ uint16 RSDK::fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 uint8 RSDK::gfxLineBuffer[SCREEN_YSIZE];
 
 int32 RSDK::maskColor = 0;
+
+#if !RETRO_USE_ORIGINAL_CODE
+uint8 RSDK::paletteDirtyBanks = 0;
+uint32 RSDK::paletteGeneration[PALETTE_BANK_COUNT];
+uint8 RSDK::paletteUntrackedBanks = 0;
+
+// the last fade written to each bank, along with the generations of the banks it was made from
+struct PaletteFadeInfo {
+    uint8 srcBankA;
+    uint8 srcBankB;
+    int16 blendAmount;
+    int32 startIndex;
+    int32 endIndex;
+    uint32 generation[3];
+    bool32 valid;
+};
+static PaletteFadeInfo lastPaletteFade[PALETTE_BANK_COUNT];
+#endif
+
 #if RETRO_REV02
 uint16 *RSDK::tintLookupTable = NULL;
 #else
@@ -29,12 +48,21 @@ uint16 RSDK::tintLookupTable[0x10000];
 #if RETRO_REV02
 void RSDK::LoadPalette(uint8 bankID, const char *filename, uint16 disabledRows)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    if (bankID >= PALETTE_BANK_COUNT)
+        return;
+#endif
+
     char fullFilePath[0x80];
     sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Palettes/%s", filename);
 
     FileInfo info;
     InitFileInfo(&info);
     if (LoadFile(&info, fullFilePath, FMODE_RB)) {
+#if !RETRO_USE_ORIGINAL_CODE
+        FlushDrawCommands();
+#endif
+
         for (int32 r = 0; r < 0x10; ++r) {
             if (!(disabledRows >> r & 1)) {
                 for (int32 c = 0; c < 0x10; ++c) {
@@ -49,6 +77,10 @@ void RSDK::LoadPalette(uint8 bankID, const char *filename, uint16 disabledRows)
             }
         }
 
+#if !RETRO_USE_ORIGINAL_CODE
+        MarkPaletteDirty(bankID);
+#endif
+
         CloseFile(&info);
     }
 }
@@ -62,6 +94,23 @@ void RSDK::BlendColors(uint8 destBankID, uint32 *srcColorsA, uint32 *srcColorsB,
 
     uint8 blendA         = 0xFF - blendAmount;
     uint16 *paletteColor = &fullPalette[destBankID][startIndex];
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+
+    // indexed with no loop-carried pointers so the compiler is free to vectorize it
+    for (int32 i = 0; i < count; ++i) {
+        uint32 clrA = srcColorsA[i];
+        uint32 clrB = srcColorsB[i];
+
+        uint32 r = (blendAmount * ((clrB >> 0x10) & 0xFF) + blendA * ((clrA >> 0x10) & 0xFF)) >> 8;
+        uint32 g = (blendAmount * ((clrB >> 0x08) & 0xFF) + blendA * ((clrA >> 0x08) & 0xFF)) >> 8;
+        uint32 b = (blendAmount * ((clrB >> 0x00) & 0xFF) + blendA * ((clrA >> 0x00) & 0xFF)) >> 8;
+
+        paletteColor[i] = (uint16)((b >> 3) | ((g >> 2) << 5) | ((r >> 3) << 11));
+    }
+
+    MarkPaletteDirty(destBankID);
+#else
     for (int32 i = startIndex; i < startIndex + count; ++i) {
         int32 r = blendAmount * ((*srcColorsB >> 0x10) & 0xFF) + blendA * ((*srcColorsA >> 0x10) & 0xFF);
         int32 g = blendAmount * ((*srcColorsB >> 0x08) & 0xFF) + blendA * ((*srcColorsA >> 0x08) & 0xFF);
@@ -73,6 +122,7 @@ void RSDK::BlendColors(uint8 destBankID, uint32 *srcColorsA, uint32 *srcColorsB,
         srcColorsB++;
         ++paletteColor;
     }
+#endif
 }
 #endif
 
@@ -87,7 +137,54 @@ void RSDK::SetPaletteFade(uint8 destBankID, uint8 srcBankA, uint8 srcBankB, int1
     if (startIndex >= endIndex)
         return;
 
-    uint32 blendA        = 0xFF - blendAmount;
+    uint32 blendA = 0xFF - blendAmount;
+#if !RETRO_USE_ORIGINAL_CODE
+    // fades tend to get set every frame whether they've changed or not, so skip it if this exact fade is already sitting in the bank
+    PaletteFadeInfo *fade = &lastPaletteFade[destBankID];
+    if (fade->valid && fade->srcBankA == srcBankA && fade->srcBankB == srcBankB && fade->blendAmount == blendAmount && fade->startIndex == startIndex
+        && fade->endIndex == endIndex && PaletteUnchanged(destBankID, fade->generation[0]) && PaletteUnchanged(srcBankA, fade->generation[1])
+        && PaletteUnchanged(srcBankB, fade->generation[2])) {
+        return;
+    }
+
+    FlushDrawCommands();
+
+    // the range is inclusive, so an endIndex of 0x100 writes colour 0's blend into the first colour of the next bank (if there is one)
+    int32 lastIndex = endIndex;
+    if (destBankID == PALETTE_BANK_COUNT - 1)
+        lastIndex = MIN(lastIndex, PALETTE_BANK_SIZE - 1);
+
+    // works on the RGB565 values directly (expanded exactly like GetPaletteEntry does) rather than calling GetPaletteEntry twice per colour,
+    // srcA and dest are often the same bank but every colour is only read before it's written so that's fine
+    uint16 *srcColorsA = fullPalette[srcBankA];
+    uint16 *srcColorsB = fullPalette[srcBankB];
+    uint16 *dstColors  = &fullPalette[0][0] + destBankID * PALETTE_BANK_SIZE;
+    for (int32 i = startIndex; i <= lastIndex; ++i) {
+        uint32 clrA = srcColorsA[i & 0xFF];
+        uint32 clrB = srcColorsB[i & 0xFF];
+
+        uint32 r = (blendAmount * ((clrB >> 8) & 0xF8) + blendA * ((clrA >> 8) & 0xF8)) >> 8;
+        uint32 g = (blendAmount * ((clrB >> 3) & 0xFC) + blendA * ((clrA >> 3) & 0xFC)) >> 8;
+        uint32 b = (blendAmount * ((clrB << 3) & 0xF8) + blendA * ((clrA << 3) & 0xF8)) >> 8;
+
+        dstColors[i] = (uint16)((b >> 3) | ((g >> 2) << 5) | ((r >> 3) << 11));
+    }
+
+    MarkPaletteDirty(destBankID);
+    if (lastIndex >= PALETTE_BANK_SIZE)
+        MarkPaletteDirty(destBankID + 1);
+
+    fade->srcBankA      = srcBankA;
+    fade->srcBankB      = srcBankB;
+    fade->blendAmount   = blendAmount;
+    fade->startIndex    = startIndex;
+    fade->endIndex      = endIndex;
+    fade->generation[0] = paletteGeneration[destBankID];
+    fade->generation[1] = paletteGeneration[srcBankA];
+    fade->generation[2] = paletteGeneration[srcBankB];
+    // one that spills into the next bank could have its source changed by that, so it isn't worth tracking
+    fade->valid = lastIndex < PALETTE_BANK_SIZE;
+#else
     uint16 *paletteColor = &fullPalette[destBankID][startIndex];
     for (int32 i = startIndex; i <= endIndex; ++i) {
         uint32 clrA = GetPaletteEntry(srcBankA, i);
@@ -101,4 +198,5 @@ void RSDK::SetPaletteFade(uint8 destBankID, uint8 srcBankA, uint8 srcBankB, int1
 
         ++paletteColor;
     }
+#endif
 }
\ No newline at end of file
@@ -27,6 +27,29 @@ extern uint8 gfxLineBuffer[SCREEN_YSIZE]; // Pointers to active palette
 
 extern int32 maskColor;
 
+#if !RETRO_USE_ORIGINAL_CODE
+// one bit per bank, set whenever a bank in fullPalette is written to, cleared at the start of every frame
+extern uint8 paletteDirtyBanks;
+// bumped on every write to a bank, for anything that needs to know about changes across more than one frame
+extern uint32 paletteGeneration[PALETTE_BANK_COUNT];
+// banks a mod has been handed a pointer to through GetPaletteBank, writes through that can't be seen so these never count as unchanged
+extern uint8 paletteUntrackedBanks;
+
+inline void MarkPaletteDirty(uint8 bankID)
+{
+    paletteDirtyBanks |= 1 << bankID;
+    ++paletteGeneration[bankID];
+}
+
+inline bool32 PaletteUnchanged(uint8 bankID, uint32 generation)
+{
+    return !(paletteUntrackedBanks & (1 << bankID)) && paletteGeneration[bankID] == generation;
+}
+
+// defined in Drawing.cpp, queued draws read the palettes when they're run so they have to be drawn before anything here changes
+void FlushDrawCommands();
+#endif
+
 #if RETRO_REV02
 extern uint16 *tintLookupTable;
 #else
@@ -43,8 +66,12 @@ void LoadPalette(uint8 bankID, const char *filePath, uint16 disabledRows);
 
 inline void SetActivePalette(uint8 newActiveBank, int32 startLine, int32 endLine)
 {
-    if (newActiveBank < PALETTE_BANK_COUNT)
+    if (newActiveBank < PALETTE_BANK_COUNT) {
+#if !RETRO_USE_ORIGINAL_CODE
+        FlushDrawCommands();
+#endif
         for (int32 l = startLine; l < endLine && l < SCREEN_YSIZE; l++) gfxLineBuffer[l] = newActiveBank;
+    }
 }
 
 inline uint32 GetPaletteEntry(uint8 bankID, uint8 index)
@@ -62,16 +89,34 @@ inline uint32 GetPaletteEntry(uint8 bankID, uint8 index)
 
 inline void SetPaletteEntry(uint8 bankID, uint8 index, uint32 color)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    if (bankID >= PALETTE_BANK_COUNT)
+        return;
+
+    FlushDrawCommands();
+#endif
     fullPalette[bankID][index] = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+#if !RETRO_USE_ORIGINAL_CODE
+    MarkPaletteDirty(bankID);
+#endif
 }
 
 inline void SetPaletteMask(uint32 color)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
     maskColor = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
 }
 
 #if RETRO_REV02
-inline void SetTintLookupTable(uint16 *lookupTable) { tintLookupTable = lookupTable; }
+inline void SetTintLookupTable(uint16 *lookupTable)
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+    tintLookupTable = lookupTable;
+}
 
 #if RETRO_USE_MOD_LOADER && RETRO_MOD_LOADER_VER >= 2
 inline uint16 *GetTintLookupTable() { return tintLookupTable; }
@@ -84,14 +129,51 @@ inline uint16 *GetTintLookupTable() { return tintLookupTable; }
 inline void CopyPalette(uint8 sourceBank, uint8 srcBankStart, uint8 destinationBank, uint8 destBankStart, uint8 count)
 {
     if (sourceBank < PALETTE_BANK_COUNT && destinationBank < PALETTE_BANK_COUNT) {
+#if !RETRO_USE_ORIGINAL_CODE
+        FlushDrawCommands();
+
+        // copying forwards onto an overlapping range smears the first colours across it, keep doing that for compatibility
+        if (sourceBank != destinationBank || destBankStart <= srcBankStart || destBankStart >= srcBankStart + count) {
+            memmove(&fullPalette[destinationBank][destBankStart], &fullPalette[sourceBank][srcBankStart], count * sizeof(uint16));
+        }
+        else {
+            for (int32 i = 0; i < count; ++i) {
+                fullPalette[destinationBank][destBankStart + i] = fullPalette[sourceBank][srcBankStart + i];
+            }
+        }
+
+        MarkPaletteDirty(destinationBank);
+#else
         for (int32 i = 0; i < count; ++i) {
             fullPalette[destinationBank][destBankStart + i] = fullPalette[sourceBank][srcBankStart + i];
         }
+#endif
     }
 }
 
 inline void RotatePalette(uint8 bankID, uint8 startIndex, uint8 endIndex, bool32 right)
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    if (bankID < PALETTE_BANK_COUNT) {
+        FlushDrawCommands();
+
+        uint16 *bank = fullPalette[bankID];
+        if (right) {
+            uint16 startClr = bank[endIndex];
+            if (endIndex > startIndex)
+                memmove(&bank[startIndex + 1], &bank[startIndex], (endIndex - startIndex) * sizeof(uint16));
+            bank[startIndex] = startClr;
+        }
+        else {
+            uint16 startClr = bank[startIndex];
+            if (endIndex > startIndex)
+                memmove(&bank[startIndex], &bank[startIndex + 1], (endIndex - startIndex) * sizeof(uint16));
+            bank[endIndex] = startClr;
+        }
+
+        MarkPaletteDirty(bankID);
+    }
+#else
     if (right) {
         uint16 startClr = fullPalette[bankID][endIndex];
         for (int32 i = endIndex; i > startIndex; --i) fullPalette[bankID][i] = fullPalette[bankID][i - 1];
@@ -102,6 +184,7 @@ inline void RotatePalette(uint8 bankID, uint8 startIndex, uint8 endIndex, bool32
         for (int32 i = startIndex; i < endIndex; ++i) fullPalette[bankID][i] = fullPalette[bankID][i + 1];
         fullPalette[bankID][endIndex] = startClr;
     }
+#endif
 }
 
 #if RETRO_REV02
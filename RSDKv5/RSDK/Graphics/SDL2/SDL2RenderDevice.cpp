@@ -82,10 +82,23 @@ void RenderDevice::CopyFrameBuffer()
     uint16 *pixels = NULL;
 
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if RETRO_USE_ORIGINAL_CODE
         SDL_LockTexture(screenTexture[s], NULL, (void **)&pixels, &pitch);
 
         uint16 *frameBuffer = screens[s].frameBuffer;
         for (int32 y = 0; y < SCREEN_YSIZE; ++y) {
+#else
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, 0, &startY, &endY))
+            continue;
+
+        SDL_Rect rect = { 0, startY, screens[s].size.x, endY - startY };
+        SDL_LockTexture(screenTexture[s], &rect, (void **)&pixels, &pitch);
+
+        uint16 *frameBuffer = &screens[s].frameBuffer[startY * screens[s].pitch];
+        for (int32 y = startY; y < endY; ++y) {
+#endif
             memcpy(pixels, frameBuffer, screens[s].size.x * sizeof(uint16));
             frameBuffer += screens[s].pitch;
             pixels += pitch / sizeof(uint16);
@@ -533,6 +546,9 @@ bool RenderDevice::InitGraphicsAPI()
             return 0;
         }
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
     imageTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, RETRO_VIDEO_TEXTURE_W, RETRO_VIDEO_TEXTURE_H);
     if (!imageTexture)
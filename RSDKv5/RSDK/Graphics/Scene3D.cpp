@@ -440,6 +440,10 @@ void RSDK::MatrixInverse(Matrix *dest, Matrix *matrix)
     for (int32 i = 0; i < 0x10; ++i) dest->values[i / 4][i % 4] = (int32)inv[i];
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+static NameMap modelNameMap;
+#endif
+
 uint16 RSDK::LoadMesh(const char *filename, uint8 scope)
 {
     if (!scope || scope > SCOPE_STAGE)
@@ -451,8 +455,17 @@ uint16 RSDK::LoadMesh(const char *filename, uint8 scope)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(fullFilePath, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&modelNameMap, hash);
+    if (slot >= 0 && HASH_MATCH_MD5(hash, modelList[slot].hash))
+        return slot;
+#endif
+
     for (int32 i = 0; i < MODEL_COUNT; ++i) {
         if (HASH_MATCH_MD5(hash, modelList[i].hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&modelNameMap, hash, i);
+#endif
             return i;
         }
     }
@@ -573,13 +586,101 @@ uint16 RSDK::Create3DScene(const char *name, uint16 vertexLimit, uint8 scope)
 
     return id;
 }
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::MatrixTransformVertices(ModelVertex *dest, ModelVertex *src, int32 count, Matrix *matWorld, Matrix *matNormals)
+{
+    int32 m00 = matWorld->values[0][0], m01 = matWorld->values[0][1], m02 = matWorld->values[0][2], m03 = matWorld->values[0][3];
+    int32 m10 = matWorld->values[1][0], m11 = matWorld->values[1][1], m12 = matWorld->values[1][2], m13 = matWorld->values[1][3];
+    int32 m20 = matWorld->values[2][0], m21 = matWorld->values[2][1], m22 = matWorld->values[2][2], m23 = matWorld->values[2][3];
+
+    if (matNormals) {
+        int32 n00 = matNormals->values[0][0], n01 = matNormals->values[0][1], n02 = matNormals->values[0][2];
+        int32 n10 = matNormals->values[1][0], n11 = matNormals->values[1][1], n12 = matNormals->values[1][2];
+        int32 n20 = matNormals->values[2][0], n21 = matNormals->values[2][1], n22 = matNormals->values[2][2];
+
+        for (int32 v = 0; v < count; ++v) {
+            int32 x  = src[v].x;
+            int32 y  = src[v].y;
+            int32 z  = src[v].z;
+            int32 nx = src[v].nx;
+            int32 ny = src[v].ny;
+            int32 nz = src[v].nz;
+
+            dest[v].x  = m03 + (m00 * x >> 8) + (m01 * y >> 8) + (m02 * z >> 8);
+            dest[v].y  = m13 + (m10 * x >> 8) + (m11 * y >> 8) + (m12 * z >> 8);
+            dest[v].z  = m23 + (m20 * x >> 8) + (m21 * y >> 8) + (m22 * z >> 8);
+            dest[v].nx = (n00 * nx >> 8) + (n01 * ny >> 8) + (n02 * nz >> 8);
+            dest[v].ny = (n10 * nx >> 8) + (n11 * ny >> 8) + (n12 * nz >> 8);
+            dest[v].nz = (n20 * nx >> 8) + (n21 * ny >> 8) + (n22 * nz >> 8);
+        }
+    }
+    else {
+        for (int32 v = 0; v < count; ++v) {
+            int32 x = src[v].x;
+            int32 y = src[v].y;
+            int32 z = src[v].z;
+
+            dest[v].x = m03 + (m00 * x >> 8) + (m01 * y >> 8) + (m02 * z >> 8);
+            dest[v].y = m13 + (m10 * x >> 8) + (m11 * y >> 8) + (m12 * z >> 8);
+            dest[v].z = m23 + (m20 * x >> 8) + (m21 * y >> 8) + (m22 * z >> 8);
+        }
+    }
+}
+
+void RSDK::InterpolateVertices(ModelVertex *dest, ModelVertex *frameA, ModelVertex *frameB, int32 count, int32 interpolate, bool32 useNormals)
+{
+    for (int32 v = 0; v < count; ++v) {
+        dest[v].x = frameA[v].x + ((interpolate * (frameB[v].x - frameA[v].x)) >> 8);
+        dest[v].y = frameA[v].y + ((interpolate * (frameB[v].y - frameA[v].y)) >> 8);
+        dest[v].z = frameA[v].z + ((interpolate * (frameB[v].z - frameA[v].z)) >> 8);
+    }
+
+    if (useNormals) {
+        for (int32 v = 0; v < count; ++v) {
+            dest[v].nx = frameA[v].nx + ((interpolate * (frameB[v].nx - frameA[v].nx)) >> 8);
+            dest[v].ny = frameA[v].ny + ((interpolate * (frameB[v].ny - frameA[v].ny)) >> 8);
+            dest[v].nz = frameA[v].nz + ((interpolate * (frameB[v].nz - frameA[v].nz)) >> 8);
+        }
+    }
+}
+
+// models get every vertex transformed once up front, instead of once for every face that uses it
+static ModelVertex transformedVertices[0x10000];
+
+static void AddTransformedVertices(Scene3D *scn, Model *mdl, int32 vertID, uint8 *faceVertCounts, bool32 useNormals, color color)
+{
+    // MODEL_USECOLOURS on its own has always used the color that was passed in
+    bool32 useColors = mdl->flags == (MODEL_USENORMALS | MODEL_USECOLOURS);
+
+    int32 f = 0;
+    for (int32 i = 0; i < mdl->indexCount;) {
+        faceVertCounts[f++] = mdl->faceVertCount;
+
+        for (int32 c = 0; c < mdl->faceVertCount; ++c) {
+            uint16 index           = mdl->indices[i++];
+            ModelVertex *modelVert = &transformedVertices[index];
+            Scene3DVertex *vertex  = &scn->vertices[vertID++];
+
+            vertex->x = modelVert->x;
+            vertex->y = modelVert->y;
+            vertex->z = modelVert->z;
+            if (useNormals) {
+                vertex->nx = modelVert->nx;
+                vertex->ny = modelVert->ny;
+                vertex->nz = modelVert->nz;
+            }
+            vertex->color = useColors ? mdl->colors[index].color : color;
+        }
+    }
+}
+#endif
+
 void RSDK::AddModelToScene(uint16 modelFrames, uint16 sceneIndex, uint8 drawMode, Matrix *matWorld, Matrix *matNormals, color color)
 {
     if (modelFrames < MODEL_COUNT && sceneIndex < SCENE3D_COUNT) {
         if (matWorld) {
             Model *mdl            = &modelList[modelFrames];
             Scene3D *scn          = &scene3DList[sceneIndex];
-            uint16 *indices       = mdl->indices;
             int32 vertID          = scn->vertexCount;
             uint8 *faceVertCounts = &scn->faceVertCounts[scn->faceCount];
             int32 indCnt          = mdl->indexCount;
@@ -588,8 +689,10 @@ void RSDK::AddModelToScene(uint16 modelFrames, uint16 sceneIndex, uint8 drawMode
                 scn->drawMode = drawMode;
                 scn->faceCount += indCnt / mdl->faceVertCount;
 
-                int32 i = 0;
-                int32 f = 0;
+#if RETRO_USE_ORIGINAL_CODE
+                uint16 *indices = mdl->indices;
+                int32 i         = 0;
+                int32 f         = 0;
                 switch (mdl->flags) {
                     default:
                     case MODEL_NOFLAGS:
@@ -713,6 +816,12 @@ void RSDK::AddModelToScene(uint16 modelFrames, uint16 sceneIndex, uint8 drawMode
                         }
                         break;
                 }
+#else
+                bool32 useNormals = (mdl->flags == MODEL_USENORMALS || mdl->flags == (MODEL_USENORMALS | MODEL_USECOLOURS)) && matNormals;
+
+                MatrixTransformVertices(transformedVertices, mdl->vertices, mdl->vertCount, matWorld, useNormals ? matNormals : NULL);
+                AddTransformedVertices(scn, mdl, vertID, faceVertCounts, useNormals, color);
+#endif
             }
         }
     }
@@ -724,7 +833,6 @@ void RSDK::AddMeshFrameToScene(uint16 modelFrames, uint16 sceneIndex, Animator *
         if (matWorld && animator) {
             Model *mdl            = &modelList[modelFrames];
             Scene3D *scn          = &scene3DList[sceneIndex];
-            uint16 *indices       = mdl->indices;
             int32 vertID          = scn->vertexCount;
             uint8 *faceVertCounts = &scn->faceVertCounts[scn->faceCount];
             int32 indCnt          = mdl->indexCount;
@@ -739,6 +847,8 @@ void RSDK::AddMeshFrameToScene(uint16 modelFrames, uint16 sceneIndex, Animator *
                 int32 frameOffset     = animator->frameID * mdl->vertCount;
                 int32 nextFrameOffset = nextFrame * mdl->vertCount;
 
+#if RETRO_USE_ORIGINAL_CODE
+                uint16 *indices   = mdl->indices;
                 int32 i           = 0;
                 int32 f           = 0;
                 int32 interpolate = animator->timer;
@@ -882,6 +992,14 @@ void RSDK::AddMeshFrameToScene(uint16 modelFrames, uint16 sceneIndex, Animator *
                         }
                         break;
                 }
+#else
+                bool32 useNormals = (mdl->flags == MODEL_USENORMALS || mdl->flags == (MODEL_USENORMALS | MODEL_USECOLOURS)) && matNormals;
+
+                InterpolateVertices(transformedVertices, &mdl->vertices[frameOffset], &mdl->vertices[nextFrameOffset], mdl->vertCount, animator->timer,
+                                    useNormals);
+                MatrixTransformVertices(transformedVertices, transformedVertices, mdl->vertCount, matWorld, useNormals ? matNormals : NULL);
+                AddTransformedVertices(scn, mdl, vertID, faceVertCounts, useNormals, color);
+#endif
             }
         }
     }
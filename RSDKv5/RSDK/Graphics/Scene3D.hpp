@@ -142,6 +142,14 @@ void MatrixRotateY(Matrix *matrix, int16 angle);
 void MatrixRotateZ(Matrix *matrix, int16 angle);
 void MatrixRotateXYZ(Matrix *matrix, int16 rotationX, int16 rotationY, int16 rotationZ);
 void MatrixInverse(Matrix *dest, Matrix *matrix);
+
+#if !RETRO_USE_ORIGINAL_CODE
+// batched versions of the per vertex math in AddModelToScene & AddMeshFrameToScene, giving the exact same results
+// dest can be the same array as src
+void MatrixTransformVertices(ModelVertex *dest, ModelVertex *src, int32 count, Matrix *matWorld, Matrix *matNormals);
+void InterpolateVertices(ModelVertex *dest, ModelVertex *frameA, ModelVertex *frameB, int32 count, int32 interpolate, bool32 useNormals);
+#endif
+
 inline void MatrixCopy(Matrix *matDst, Matrix *matSrc) { memcpy(matDst, matSrc, sizeof(Matrix)); }
 
 uint16 LoadMesh(const char *filepath, uint8 scope);
@@ -903,6 +903,10 @@ bool32 RSDK::ImageTGA::Load(const char *fileName, bool32 loadHeader)
 }
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+static NameMap surfaceNameMap;
+#endif
+
 uint16 RSDK::LoadSpriteSheet(const char *filename, uint8 scope)
 {
     char fullFilePath[0x100];
@@ -914,8 +918,17 @@ uint16 RSDK::LoadSpriteSheet(const char *filename, uint8 scope)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(filename, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&surfaceNameMap, hash);
+    if (slot >= 0 && HASH_MATCH_MD5(gfxSurface[slot].hash, hash))
+        return slot;
+#endif
+
     for (int32 i = 0; i < SURFACE_COUNT; ++i) {
         if (HASH_MATCH_MD5(gfxSurface[i].hash, hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&surfaceNameMap, hash, i);
+#endif
             return i;
         }
     }
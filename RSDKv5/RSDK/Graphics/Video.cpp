@@ -1,5 +1,12 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#endif
+
 using namespace RSDK;
 
 FileInfo VideoManager::file;
@@ -18,6 +25,170 @@ th_pixel_fmt VideoManager::pixelFormat;
 ogg_int64_t VideoManager::granulePos = 0;
 bool32 VideoManager::initializing    = false;
 
+#if !RETRO_USE_ORIGINAL_CODE
+VideoFrame VideoManager::frames[VIDEO_FRAME_COUNT];
+int32 VideoManager::frameReadPos     = 0;
+int32 VideoManager::frameCount       = 0;
+bool32 VideoManager::decodeFinished  = false;
+double VideoManager::presentedTime   = 0.0;
+int32 VideoManager::decodedFrames    = 0;
+int32 VideoManager::droppedFrames    = 0;
+double VideoManager::decodeTime      = 0.0;
+double VideoManager::decodeTimeMax   = 0.0;
+double VideoManager::decodeTimeTotal = 0.0;
+
+static std::thread decodeThread;
+static std::mutex decodeLock;
+static std::condition_variable decodeCond;
+static bool32 decodeQuit = false;
+
+// Demuxes & decodes the next packet into frame, returns false once the end of the file is reached
+static bool32 DecodeVideoFrame(VideoFrame *frame)
+{
+    while (ogg_stream_packetout(&VideoManager::to, &VideoManager::op) <= 0) {
+        char *buffer = ogg_sync_buffer(&VideoManager::oy, 0x1000);
+        if (!ReadBytes(&VideoManager::file, buffer, 0x1000))
+            return false;
+
+        ogg_sync_wrote(&VideoManager::oy, 0x1000);
+
+        while (ogg_sync_pageout(&VideoManager::oy, &VideoManager::og) > 0) ogg_stream_pagein(&VideoManager::to, &VideoManager::og);
+    }
+
+    int32 result     = th_decode_packetin(VideoManager::td, &VideoManager::op, &VideoManager::granulePos);
+    frame->endTime   = th_granule_time(VideoManager::td, VideoManager::granulePos);
+    frame->duplicate = result != 0; // nothing new to show (or a bad packet), just hold the last frame for longer
+
+    if (!frame->duplicate) {
+        th_ycbcr_buffer yuv;
+        th_decode_ycbcr_out(VideoManager::td, yuv);
+
+        for (int32 p = 0; p < 3; ++p) {
+            // the decoder is free to hand out negative strides, the copy is always stored top-down
+            int32 stride = abs(yuv[p].stride);
+            int32 size   = stride * yuv[p].height;
+            if (frame->planeSize[p] < size) {
+                free(frame->planeData[p]);
+                frame->planeData[p] = (uint8 *)malloc(size);
+                frame->planeSize[p] = frame->planeData[p] ? size : 0;
+            }
+
+            if (!frame->planeData[p]) {
+                frame->duplicate = true;
+                break;
+            }
+
+            for (int32 y = 0; y < yuv[p].height; ++y) memcpy(&frame->planeData[p][y * stride], &yuv[p].data[y * yuv[p].stride], stride);
+
+            frame->yuv[p].width  = yuv[p].width;
+            frame->yuv[p].height = yuv[p].height;
+            frame->yuv[p].stride = stride;
+            frame->yuv[p].data   = frame->planeData[p];
+        }
+    }
+
+    return true;
+}
+
+static void UploadVideoFrame(VideoFrame *frame)
+{
+    th_ycbcr_buffer &yuv = frame->yuv;
+
+    int32 dataPos = (VideoManager::ti.pic_x & 0xFFFFFFFE) + (VideoManager::ti.pic_y & 0xFFFFFFFE) * yuv[0].stride;
+    switch (VideoManager::pixelFormat) {
+        default: break;
+
+        case TH_PF_444:
+            RenderDevice::SetupVideoTexture_YUV444(yuv[0].width, yuv[0].height, &yuv[0].data[dataPos], &yuv[1].data[dataPos], &yuv[2].data[dataPos],
+                                                   yuv[0].stride, yuv[1].stride, yuv[2].stride);
+            break;
+
+        case TH_PF_422:
+            RenderDevice::SetupVideoTexture_YUV422(yuv[0].width, yuv[0].height, &yuv[0].data[dataPos],
+                                                   &yuv[1].data[yuv[1].stride * VideoManager::ti.pic_y + (VideoManager::ti.pic_x >> 1)],
+                                                   &yuv[2].data[yuv[1].stride * VideoManager::ti.pic_y + (VideoManager::ti.pic_x >> 1)],
+                                                   yuv[0].stride, yuv[1].stride, yuv[2].stride);
+            break;
+
+        case TH_PF_420:
+            RenderDevice::SetupVideoTexture_YUV420(yuv[0].width, yuv[0].height, &yuv[0].data[dataPos],
+                                                   &yuv[1].data[yuv[1].stride * (VideoManager::ti.pic_y >> 1) + (VideoManager::ti.pic_x >> 1)],
+                                                   &yuv[2].data[yuv[1].stride * (VideoManager::ti.pic_y >> 1) + (VideoManager::ti.pic_x >> 1)],
+                                                   yuv[0].stride, yuv[1].stride, yuv[2].stride);
+            break;
+    }
+}
+
+static void VideoDecodeThread()
+{
+    while (true) {
+        VideoFrame *frame = NULL;
+        {
+            std::unique_lock<std::mutex> lock(decodeLock);
+            decodeCond.wait(lock, [] { return decodeQuit || VideoManager::frameCount < VIDEO_FRAME_COUNT; });
+            if (decodeQuit)
+                break;
+
+            // the slot past the end of the queue is never touched by the main thread
+            frame = &VideoManager::frames[(VideoManager::frameReadPos + VideoManager::frameCount) % VIDEO_FRAME_COUNT];
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        bool32 decoded = DecodeVideoFrame(frame);
+        double time    = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        std::lock_guard<std::mutex> lock(decodeLock);
+        if (!decoded) {
+            VideoManager::decodeFinished = true;
+            break;
+        }
+
+        VideoManager::decodeTime = time;
+        VideoManager::decodeTimeTotal += time;
+        VideoManager::decodeTimeMax = MAX(VideoManager::decodeTimeMax, time);
+        VideoManager::decodedFrames++;
+        VideoManager::frameCount++;
+    }
+}
+
+static void StopVideoDecodeThread()
+{
+    if (decodeThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(decodeLock);
+            decodeQuit = true;
+        }
+        decodeCond.notify_all();
+        decodeThread.join();
+    }
+
+    for (int32 f = 0; f < VIDEO_FRAME_COUNT; ++f) {
+        for (int32 p = 0; p < 3; ++p) {
+            free(VideoManager::frames[f].planeData[p]);
+            VideoManager::frames[f].planeData[p] = NULL;
+            VideoManager::frames[f].planeSize[p] = 0;
+        }
+    }
+}
+#endif
+
+static void CloseVideo()
+{
+    CloseFile(&VideoManager::file);
+
+    // Flush everything out
+    while (ogg_sync_pageout(&VideoManager::oy, &VideoManager::og) > 0) ogg_stream_pagein(&VideoManager::to, &VideoManager::og);
+
+    ogg_stream_clear(&VideoManager::to);
+    th_decode_free(VideoManager::td);
+    th_comment_clear(&VideoManager::tc);
+    th_info_clear(&VideoManager::ti);
+    ogg_sync_clear(&VideoManager::oy);
+
+    videoSettings.shaderID    = engine.storedShaderID;
+    videoSettings.screenCount = 1;
+}
+
 bool32 RSDK::LoadVideo(const char *filename, double startDelay, bool32 (*skipCallback)())
 {
     if (ENGINE_VERSION == 5 && sceneInfo.state == ENGINESTATE_VIDEOPLAYBACK)
@@ -205,7 +376,11 @@ void RSDK::ProcessVideo()
         else
             engine.displayTime = streamPos;
 
+#if !RETRO_USE_ORIGINAL_CODE
+        curTime = VideoManager::presentedTime;
+#else
         curTime = th_granule_time(VideoManager::td, VideoManager::granulePos);
+#endif
 
 #if RETRO_USE_MOD_LOADER
         RunModCallbacks(MODCB_ONVIDEOSKIPCB, (void *)engine.skipCallback);
@@ -215,6 +390,76 @@ void RSDK::ProcessVideo()
         }
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // decoding happens on its own thread, all we do here is pick the frame that's due & upload it
+    if (VideoManager::initializing) {
+        // the first frame is decoded right away, so there's something to show before the thread gets going
+        VideoManager::frameReadPos    = 0;
+        VideoManager::frameCount      = 0;
+        VideoManager::decodeFinished  = false;
+        VideoManager::decodedFrames   = 0;
+        VideoManager::droppedFrames   = 0;
+        VideoManager::decodeTime      = 0.0;
+        VideoManager::decodeTimeMax   = 0.0;
+        VideoManager::decodeTimeTotal = 0.0;
+
+        VideoFrame *frame = &VideoManager::frames[0];
+        if (DecodeVideoFrame(frame)) {
+            VideoManager::decodedFrames++;
+            VideoManager::presentedTime = frame->endTime;
+            if (!frame->duplicate)
+                UploadVideoFrame(frame);
+        }
+        else {
+            VideoManager::presentedTime = 0.0;
+        }
+
+        decodeQuit   = false;
+        decodeThread = std::thread(VideoDecodeThread);
+
+        VideoManager::initializing = false;
+    }
+    else if (!finished && engine.displayTime >= engine.videoStartDelay + curTime) {
+        VideoFrame *frame = NULL;
+        {
+            std::lock_guard<std::mutex> lock(decodeLock);
+
+            // find the newest frame that's due, anything before it has been missed
+            int32 dueCount = 0;
+            double time    = curTime;
+            while (dueCount < VideoManager::frameCount && engine.displayTime >= engine.videoStartDelay + time) {
+                time = VideoManager::frames[(VideoManager::frameReadPos + dueCount) % VIDEO_FRAME_COUNT].endTime;
+                dueCount++;
+            }
+
+            for (int32 f = 0; f < dueCount - 1; ++f) {
+                if (!VideoManager::frames[VideoManager::frameReadPos].duplicate)
+                    VideoManager::droppedFrames++;
+
+                VideoManager::frameReadPos = (VideoManager::frameReadPos + 1) % VIDEO_FRAME_COUNT;
+                VideoManager::frameCount--;
+            }
+
+            if (dueCount)
+                frame = &VideoManager::frames[VideoManager::frameReadPos];
+            else if (VideoManager::decodeFinished)
+                finished = true;
+        }
+        // (if the decoder is running behind there's nothing to do but keep showing the current frame)
+
+        if (frame) {
+            // the frame stays queued while it's being uploaded so the decoder can't write over it
+            if (!frame->duplicate)
+                UploadVideoFrame(frame);
+
+            std::lock_guard<std::mutex> lock(decodeLock);
+            VideoManager::presentedTime = frame->endTime;
+            VideoManager::frameReadPos  = (VideoManager::frameReadPos + 1) % VIDEO_FRAME_COUNT;
+            VideoManager::frameCount--;
+        }
+        decodeCond.notify_one();
+    }
+#else
     if (!finished && (VideoManager::initializing || engine.displayTime >= engine.videoStartDelay + curTime)) {
         while (ogg_stream_packetout(&VideoManager::to, &VideoManager::op) <= 0) {
             char *buffer = ogg_sync_buffer(&VideoManager::oy, 0x1000);
@@ -261,21 +506,18 @@ void RSDK::ProcessVideo()
 
         VideoManager::initializing = false;
     }
+#endif
 
     if (finished) {
-        CloseFile(&VideoManager::file);
-
-        // Flush everything out
-        while (ogg_sync_pageout(&VideoManager::oy, &VideoManager::og) > 0) ogg_stream_pagein(&VideoManager::to, &VideoManager::og);
+#if !RETRO_USE_ORIGINAL_CODE
+        StopVideoDecodeThread();
 
-        ogg_stream_clear(&VideoManager::to);
-        th_decode_free(VideoManager::td);
-        th_comment_clear(&VideoManager::tc);
-        th_info_clear(&VideoManager::ti);
-        ogg_sync_clear(&VideoManager::oy);
+        if (VideoManager::decodedFrames)
+            PrintLog(PRINT_NORMAL, "Video finished: %d frames decoded, %d dropped, decode time avg %.2fms, max %.2fms", VideoManager::decodedFrames,
+                     VideoManager::droppedFrames, VideoManager::decodeTimeTotal / VideoManager::decodedFrames, VideoManager::decodeTimeMax);
+#endif
 
-        videoSettings.shaderID    = engine.storedShaderID;
-        videoSettings.screenCount = 1;
+        CloseVideo();
         if (ENGINE_VERSION == 5)
             sceneInfo.state = engine.storedState;
 #if RETRO_REV0U
@@ -284,3 +526,16 @@ void RSDK::ProcessVideo()
 #endif
     }
 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::ReleaseVideo()
+{
+    // a video is open from LoadVideo on, but the decode thread only gets started by the first ProcessVideo after that
+    if (!decodeThread.joinable() && !VideoManager::initializing)
+        return;
+
+    StopVideoDecodeThread();
+    CloseVideo();
+    VideoManager::initializing = false;
+}
+#endif
@@ -4,6 +4,19 @@
 namespace RSDK
 {
 
+#if !RETRO_USE_ORIGINAL_CODE
+#define VIDEO_FRAME_COUNT (4)
+
+// a decoded frame waiting in the queue, planes are copied out of the decoder so it can keep working ahead
+struct VideoFrame {
+    th_ycbcr_buffer yuv;
+    uint8 *planeData[3];
+    int32 planeSize[3];
+    double endTime; // granule time, the time this frame stops being displayed
+    bool32 duplicate;
+};
+#endif
+
 struct VideoManager {
     static FileInfo file;
 
@@ -20,10 +33,30 @@ struct VideoManager {
     static th_pixel_fmt pixelFormat;
     static ogg_int64_t granulePos;
     static bool32 initializing;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    // frame queue, filled by the decode thread & consumed by ProcessVideo
+    static VideoFrame frames[VIDEO_FRAME_COUNT];
+    static int32 frameReadPos;
+    static int32 frameCount;
+    static bool32 decodeFinished;
+    static double presentedTime;
+
+    // stats
+    static int32 decodedFrames;
+    static int32 droppedFrames;
+    static double decodeTime;    // ms, most recent frame
+    static double decodeTimeMax; // ms
+    static double decodeTimeTotal;
+#endif
 };
 
 bool32 LoadVideo(const char *filename, double startDelay, bool32 (*skipCallback)());
 void ProcessVideo();
+#if !RETRO_USE_ORIGINAL_CODE
+// stops a video that's still playing without restoring the state it interrupted (shutdown, or a scene load from the dev menu)
+void ReleaseVideo();
+#endif
 
 } // namespace RSDK
 
@@ -983,6 +983,9 @@ bool RenderDevice::InitGraphicsAPI()
 
         //! WE DON'T MAKE THE SAMPLER YET
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateFrameUploads();
+#endif
 
     {
         //! IMAGE TEXTURE
@@ -1370,6 +1373,7 @@ void RenderDevice::UpdateFPSCap() { lastFrame = glfwGetTime(); }
 void RenderDevice::CopyFrameBuffer()
 {
     for (int32 s = 0; s < videoSettings.screenCount; ++s) {
+#if RETRO_USE_ORIGINAL_CODE
         uint16 *pixels      = (uint16 *)screenTextures[s].map;
         uint16 *frameBuffer = screens[s].frameBuffer;
 
@@ -1377,6 +1381,21 @@ void RenderDevice::CopyFrameBuffer()
         int32 pitch       = (screenTextures[s].layout.rowPitch >> 1) - screenPitch;
 
         for (int32 y = 0; y < SCREEN_YSIZE; ++y) {
+#else
+        int32 startY = 0;
+        int32 endY   = SCREEN_YSIZE;
+        if (!GetFrameUploadRows(s, 0, &startY, &endY))
+            continue;
+
+        // the texture memory stays mapped, so only the changed rows have to be written
+        uint16 *pixels      = (uint16 *)((uint8 *)screenTextures[s].map + startY * screenTextures[s].layout.rowPitch);
+        uint16 *frameBuffer = &screens[s].frameBuffer[startY * screens[s].pitch];
+
+        int32 screenPitch = screens[s].pitch;
+        int32 pitch       = (screenTextures[s].layout.rowPitch >> 1) - screenPitch;
+
+        for (int32 y = startY; y < endY; ++y) {
+#endif
             int32 pixelCount = screenPitch >> 4;
             for (int32 x = 0; x < pixelCount; ++x) {
                 pixels[0]  = frameBuffer[0];
@@ -1,5 +1,8 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#include <chrono>
+#include <thread>
+
 using namespace RSDK;
 
 InputDevice *RSDK::inputDeviceList[INPUTDEVICE_COUNT];
@@ -17,6 +20,10 @@ TriggerState RSDK::triggerR[PLAYER_COUNT + 1];
 #endif
 TouchInfo RSDK::touchInfo;
 
+#if !RETRO_USE_ORIGINAL_CODE
+InputLatency RSDK::inputLatency;
+#endif
+
 GamePadMappings *RSDK::gamePadMappings = NULL;
 int32 RSDK::gamePadCount               = 0;
 
@@ -52,6 +59,10 @@ int32 RSDK::gamePadCount               = 0;
 #include "Paddleboat/PDBInputDevice.cpp"
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include "Replay/ReplayInputDevice.cpp"
+#endif
+
 void RSDK::RemoveInputDevice(InputDevice *targetDevice)
 {
     if (targetDevice) {
@@ -131,6 +142,10 @@ void RSDK::InitInputDevices()
 #if RETRO_INPUTDEVICE_PDBOAT
     SKU::InitPaddleboatInputAPI();
 #endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    StartInputReplay();
+#endif
 }
 
 void RSDK::ReleaseInputDevices()
@@ -193,6 +208,10 @@ void RSDK::ClearInput()
 
 void RSDK::ProcessInput()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    LatchInput();
+#endif
+
     ClearInput();
 
     bool32 anyPress = false;
@@ -308,7 +327,142 @@ void RSDK::ProcessInput()
             }
         }
     }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    UpdateInputReplay(anyPress);
+#endif
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+static inline int64 GetLatencyTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RSDK::LatchInput()
+{
+    // only the first ProcessInput() of a frame counts
+    if (inputLatency.latched)
+        return;
+    inputLatency.latched = true;
+
+    int64 wait = 0;
+    if (inputLatency.lateLatch) {
+        if (inputLatency.presentTime && inputLatency.framePeriod) {
+            int64 cost = 0;
+            for (int32 i = 0; i < inputLatency.sampleCount; ++i) {
+                if (inputLatency.costSamples[i] > cost)
+                    cost = inputLatency.costSamples[i];
+            }
+
+            int64 start  = GetLatencyTimestamp();
+            int64 target = inputLatency.presentTime + inputLatency.framePeriod - cost - inputLatency.margin;
+            wait         = target - start;
+            if (wait > inputLatency.framePeriod)
+                wait = inputLatency.framePeriod;
+
+            if (wait > 0) {
+                PROFILE_ZONE(PROFILE_INPUTWAIT);
+
+                // sleeps aren't precise enough to hit the target, so the last couple ms are spent yielding instead
+                const int64 spinTime = 2000000;
+                if (wait > spinTime)
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(wait - spinTime));
+
+                while (GetLatencyTimestamp() < start + wait) std::this_thread::yield();
+            }
+            else {
+                wait = 0;
+            }
+        }
+
+        // anything that came in while waiting should make it into this frame
+        RenderDevice::ProcessEvents();
+    }
+
+    inputLatency.latchTime                          = GetLatencyTimestamp();
+    inputLatency.waitSamples[inputLatency.sampleID] = wait;
+}
+
+void RSDK::BeginInputPresent() { inputLatency.submitTime = GetLatencyTimestamp(); }
+
+void RSDK::EndInputPresent()
+{
+    int64 now = GetLatencyTimestamp();
+
+    if (inputLatency.presentTime) {
+        int64 interval = now - inputLatency.presentTime;
+
+        if (!inputLatency.framePeriod)
+            inputLatency.framePeriod = interval;
+        else if (interval < inputLatency.framePeriod * 3 / 2)
+            inputLatency.framePeriod += (interval - inputLatency.framePeriod) / 16;
+
+        // a late start pushed the present back a whole frame, leave more room from now on
+        if (inputLatency.lateLatch && inputLatency.latched && interval >= inputLatency.framePeriod * 3 / 2) {
+            inputLatency.missedPresents++;
+            inputLatency.margin += 500000;
+            if (inputLatency.margin > inputLatency.framePeriod / 2)
+                inputLatency.margin = inputLatency.framePeriod / 2;
+        }
+        else {
+            inputLatency.margin -= inputLatency.margin / 256;
+        }
+    }
+
+    if (inputLatency.latched) {
+        inputLatency.costSamples[inputLatency.sampleID]    = inputLatency.submitTime - inputLatency.latchTime;
+        inputLatency.latencySamples[inputLatency.sampleID] = now - inputLatency.latchTime;
+
+        inputLatency.sampleID = (inputLatency.sampleID + 1) % INPUTLATENCY_SAMPLE_COUNT;
+        if (inputLatency.sampleCount < INPUTLATENCY_SAMPLE_COUNT)
+            inputLatency.sampleCount++;
+    }
+
+    inputLatency.presentTime = now;
+    inputLatency.latched     = false;
+}
+
+void RSDK::DrawInputLatencyOverlay()
+{
+    int32 count = inputLatency.sampleCount;
+    if (!count)
+        return;
+
+    int64 latency = 0;
+    int64 worst   = 0;
+    int64 cost    = 0;
+    int64 wait    = 0;
+    for (int32 i = 0; i < count; ++i) {
+        latency += inputLatency.latencySamples[i];
+        cost += inputLatency.costSamples[i];
+        wait += inputLatency.waitSamples[i];
+
+        if (inputLatency.latencySamples[i] > worst)
+            worst = inputLatency.latencySamples[i];
+    }
+
+    int32 x = currentScreen->size.x - 8;
+    int32 y = 8;
+    DrawRectangle(x - 160, y - 4, 164, 40, 0x000000, 0x80, INK_ALPHA, true);
+
+    char buffer[0x40];
+    sprintf_s(buffer, sizeof(buffer), "latency: %.2fms", latency / (count * 1000000.0f));
+    DrawDevString(buffer, x, y, ALIGN_RIGHT, 0xF0F0F0);
+    y += 8;
+
+    sprintf_s(buffer, sizeof(buffer), "worst: %.2fms", worst / 1000000.0f);
+    DrawDevString(buffer, x, y, ALIGN_RIGHT, 0xF0F0F0);
+    y += 8;
+
+    sprintf_s(buffer, sizeof(buffer), "cost: %.2fms wait: %.2fms", cost / (count * 1000000.0f), wait / (count * 1000000.0f));
+    DrawDevString(buffer, x, y, ALIGN_RIGHT, 0xF0F0F0);
+    y += 8;
+
+    sprintf_s(buffer, sizeof(buffer), "%s, missed: %d", inputLatency.lateLatch ? "late latch" : "early latch", inputLatency.missedPresents);
+    DrawDevString(buffer, x, y, ALIGN_RIGHT, inputLatency.lateLatch ? 0x00F000 : 0xF0F0F0);
 }
+#endif
 
 void RSDK::ProcessInputDevices()
 {
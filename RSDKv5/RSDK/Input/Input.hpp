@@ -504,6 +504,10 @@ extern int32 gamePadCount;
 #include "Paddleboat/PDBInputDevice.hpp"
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include "Replay/ReplayInputDevice.hpp"
+#endif
+
 // Initializes the input devices & the backend APIs powering em
 void InitInputDevices();
 // clears the input states, used by ProcessInput()
@@ -517,6 +521,43 @@ void ReleaseInputDevices();
 
 void RemoveInputDevice(InputDevice *targetDevice);
 
+#if !RETRO_USE_ORIGINAL_CODE
+#define INPUTLATENCY_SAMPLE_COUNT (0x20)
+
+// Late latching: rather than sampling input as soon as the frame starts (& then sitting on it until the present), ProcessInput waits
+// until there's just enough time left to run the frame before the next present, then pumps events & samples the devices
+// The frame cost is predicted from the most expensive of the last few frames, with some extra headroom that grows whenever a present is missed
+// Latency is measured either way (from the input being sampled to the present returning), so both modes can be compared
+struct InputLatency {
+    // exposed as viewable variables
+    bool32 lateLatch   = false;
+    bool32 showOverlay = false;
+
+    bool32 latched    = false;
+    int64 latchTime   = 0; // all times are in nanoseconds
+    int64 submitTime  = 0;
+    int64 presentTime = 0;
+    int64 framePeriod = 0;
+    int64 margin      = 0;
+
+    int64 costSamples[INPUTLATENCY_SAMPLE_COUNT];
+    int64 latencySamples[INPUTLATENCY_SAMPLE_COUNT];
+    int64 waitSamples[INPUTLATENCY_SAMPLE_COUNT];
+    int32 sampleID        = 0;
+    int32 sampleCount     = 0;
+    uint32 missedPresents = 0;
+};
+
+extern InputLatency inputLatency;
+
+// waits for the late latch point (if enabled) & marks when input was sampled, called by ProcessInput()
+void LatchInput();
+// called around RenderDevice::FlipScreen()
+void BeginInputPresent();
+void EndInputPresent();
+void DrawInputLatencyOverlay();
+#endif
+
 inline InputDevice *InputDeviceFromID(uint32 deviceID)
 {
     for (int32 i = 0; i < inputDeviceCount; ++i) {
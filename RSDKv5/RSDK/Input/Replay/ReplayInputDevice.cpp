@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <chrono>
+
+RSDK::InputReplay RSDK::inputReplay;
+
+template <typename T> static inline void SyncReplayValue(uint8 *&buffer, T *value, bool32 apply)
+{
+    if (apply)
+        memcpy(value, buffer, sizeof(T));
+    else
+        memcpy(buffer, value, sizeof(T));
+
+    buffer += sizeof(T);
+}
+
+static inline void SyncReplayStates(uint8 *&buffer, InputState *states, int32 count, bool32 apply)
+{
+    // keyMap is left alone, it's part of the settings rather than the frame
+    for (int32 i = 0; i < count; ++i) {
+        SyncReplayValue(buffer, &states[i].down, apply);
+        SyncReplayValue(buffer, &states[i].press, apply);
+    }
+}
+
+// Copies the input state into frame (or back out of it when applying), returns the frame size
+static int32 SyncReplayFrame(uint8 *frame, bool32 apply, uint8 *anyPress)
+{
+    uint8 *buffer = frame;
+
+    SyncReplayValue(buffer, &randSeed, apply);
+    SyncReplayValue(buffer, anyPress, apply);
+
+    for (int32 c = 0; c <= PLAYER_COUNT; ++c) {
+        SyncReplayStates(buffer, (InputState *)&controller[c], sizeof(ControllerState) / sizeof(InputState), apply);
+
+#if RETRO_REV02
+        AnalogState *sticks[] = { &stickL[c], &stickR[c] };
+        for (int32 s = 0; s < 2; ++s) {
+            SyncReplayStates(buffer, &sticks[s]->keyUp, 5, apply);
+            SyncReplayValue(buffer, &sticks[s]->deadzone, apply);
+            SyncReplayValue(buffer, &sticks[s]->hDelta, apply);
+            SyncReplayValue(buffer, &sticks[s]->vDelta, apply);
+        }
+
+        TriggerState *triggers[] = { &triggerL[c], &triggerR[c] };
+        for (int32 t = 0; t < 2; ++t) {
+            SyncReplayStates(buffer, &triggers[t]->keyBumper, 2, apply);
+            SyncReplayValue(buffer, &triggers[t]->bumperDelta, apply);
+            SyncReplayValue(buffer, &triggers[t]->triggerDelta, apply);
+        }
+#else
+        SyncReplayStates(buffer, &stickL[c].keyUp, 4, apply);
+        SyncReplayValue(buffer, &stickL[c].deadzone, apply);
+        SyncReplayValue(buffer, &stickL[c].triggerDeltaL, apply);
+        SyncReplayValue(buffer, &stickL[c].triggerDeltaR, apply);
+        SyncReplayValue(buffer, &stickL[c].hDeltaL, apply);
+        SyncReplayValue(buffer, &stickL[c].vDeltaL, apply);
+        SyncReplayValue(buffer, &stickL[c].hDeltaR, apply);
+        SyncReplayValue(buffer, &stickL[c].vDeltaR, apply);
+#endif
+    }
+
+    SyncReplayValue(buffer, &touchInfo.x, apply);
+    SyncReplayValue(buffer, &touchInfo.y, apply);
+    SyncReplayValue(buffer, &touchInfo.down, apply);
+    SyncReplayValue(buffer, &touchInfo.count, apply);
+#if !RETRO_REV02
+    SyncReplayValue(buffer, &touchInfo.pauseHold, apply);
+    SyncReplayValue(buffer, &touchInfo.pausePress, apply);
+    SyncReplayValue(buffer, &touchInfo.unknown1, apply);
+    SyncReplayValue(buffer, &touchInfo.anyKeyHold, apply);
+    SyncReplayValue(buffer, &touchInfo.anyKeyPress, apply);
+    SyncReplayValue(buffer, &touchInfo.unknown2, apply);
+#endif
+
+    return (int32)(buffer - frame);
+}
+
+// Stores frame as (skip, count) runs followed by the bytes that changed since prevFrame
+// anything past the last run is unchanged, so a frame identical to the previous one encodes to nothing
+static int32 EncodeReplayFrame(uint8 *dst, const uint8 *frame, const uint8 *prevFrame, int32 size)
+{
+    int32 end = size;
+    while (end > 0 && frame[end - 1] == prevFrame[end - 1]) --end;
+
+    int32 pos = 0;
+    int32 len = 0;
+    while (pos < end) {
+        int32 skip = 0;
+        while (pos + skip < end && skip < 0xFF && frame[pos + skip] == prevFrame[pos + skip]) ++skip;
+        pos += skip;
+
+        int32 count = 0;
+        while (pos + count < end && count < 0xFF && frame[pos + count] != prevFrame[pos + count]) ++count;
+
+        dst[len++] = skip;
+        dst[len++] = count;
+        memcpy(&dst[len], &frame[pos], count);
+        len += count;
+        pos += count;
+    }
+
+    return len;
+}
+
+static bool32 DecodeReplayFrame(uint8 *frame, const uint8 *src, int32 len, int32 size)
+{
+    int32 pos = 0;
+    int32 i   = 0;
+    while (i + 2 <= len) {
+        pos += src[i++];
+        int32 count = src[i++];
+        if (pos + count > size || i + count > len)
+            return false;
+
+        memcpy(&frame[pos], &src[i], count);
+        i += count;
+        pos += count;
+    }
+
+    return i == len;
+}
+
+void RSDK::InputDeviceReplay::UpdateInput()
+{
+    this->anyPress = false;
+    if (inputReplay.state != INPUTREPLAY_PLAYING || inputReplay.finished)
+        return;
+
+    if (inputReplay.frameID >= inputReplay.frameCount) {
+        inputReplay.finished = true;
+        return;
+    }
+
+    // keep devices connected mid-playback from grabbing any slots
+    for (int32 i = 0; i < inputDeviceCount; ++i) {
+        if (inputDeviceList[i] && inputDeviceList[i] != this)
+            inputDeviceList[i]->disabled = true;
+    }
+
+    uint16 len = 0;
+    uint8 data[INPUTREPLAY_FRAME_SIZE * 2];
+    if (fRead(&len, sizeof(len), 1, inputReplay.file) != 1 || len > sizeof(data) || (len && fRead(data, 1, len, inputReplay.file) != len)
+        || !DecodeReplayFrame(inputReplay.frame, data, len, inputReplay.frameSize)) {
+        PrintLog(PRINT_NORMAL, "[Replay] %s is truncated or corrupt at frame %d", inputReplay.filePath, inputReplay.frameID);
+        inputReplay.finished = true;
+        return;
+    }
+
+    // byte 4 is the anyPress flag, right after the seed
+    this->anyPress = inputReplay.frame[sizeof(randSeed)];
+    inputReplay.frameID++;
+}
+
+void RSDK::SetupInputReplay(const char *path, uint8 state, bool32 benchmark)
+{
+    int32 c = 0;
+    while (path[c] && path[c] != ';' && c < (int32)sizeof(inputReplay.filePath) - 1) {
+        inputReplay.filePath[c] = path[c];
+        ++c;
+    }
+    inputReplay.filePath[c] = 0;
+
+    inputReplay.state     = state;
+    inputReplay.benchmark = benchmark;
+}
+
+void RSDK::StartInputReplay()
+{
+    // already started (or nothing to do)
+    if (inputReplay.state == INPUTREPLAY_NONE || inputReplay.file)
+        return;
+
+    uint8 anyPress        = false;
+    inputReplay.frameSize = SyncReplayFrame(inputReplay.prevFrame, false, &anyPress);
+    inputReplay.frameID   = 0;
+    inputReplay.finished  = false;
+
+    InputReplayHeader header;
+    if (inputReplay.state == INPUTREPLAY_RECORDING) {
+        inputReplay.file = fOpen(inputReplay.filePath, "wb");
+        if (!inputReplay.file) {
+            PrintLog(PRINT_NORMAL, "[Replay] Unable to open %s for recording", inputReplay.filePath);
+            inputReplay.state = INPUTREPLAY_NONE;
+            return;
+        }
+
+        // frameCount gets filled in by StopInputReplay
+        header.signature  = INPUTREPLAY_SIGNATURE;
+        header.version    = INPUTREPLAY_VERSION;
+        header.frameSize  = inputReplay.frameSize;
+        header.frameCount = 0;
+        fWrite(&header, sizeof(header), 1, inputReplay.file);
+
+        PrintLog(PRINT_NORMAL, "[Replay] Recording input to %s", inputReplay.filePath);
+        return;
+    }
+
+    inputReplay.file = fOpen(inputReplay.filePath, "rb");
+    if (!inputReplay.file) {
+        PrintLog(PRINT_NORMAL, "[Replay] Unable to open %s", inputReplay.filePath);
+        inputReplay.state = INPUTREPLAY_NONE;
+        return;
+    }
+
+    if (fRead(&header, sizeof(header), 1, inputReplay.file) != 1 || header.signature != INPUTREPLAY_SIGNATURE
+        || header.version != INPUTREPLAY_VERSION || header.frameSize != inputReplay.frameSize) {
+        // a different frame size means it was recorded with a different engine revision
+        PrintLog(PRINT_NORMAL, "[Replay] %s isn't a valid replay for this build", inputReplay.filePath);
+        fClose(inputReplay.file);
+        inputReplay.file  = NULL;
+        inputReplay.state = INPUTREPLAY_NONE;
+        return;
+    }
+    inputReplay.frameCount = header.frameCount;
+
+    if (inputDeviceCount == INPUTDEVICE_COUNT) {
+        PrintLog(PRINT_NORMAL, "[Replay] No room for the replay input device");
+        fClose(inputReplay.file);
+        inputReplay.file  = NULL;
+        inputReplay.state = INPUTREPLAY_NONE;
+        return;
+    }
+
+    if (inputDeviceList[inputDeviceCount])
+        delete inputDeviceList[inputDeviceCount];
+
+    InputDeviceReplay *device = new InputDeviceReplay();
+    device->gamepadType       = (DEVICE_API_NONE << 16) | (DEVICE_TYPE_CONTROLLER << 8) | (DEVICE_XBOX << 0);
+    device->disabled          = false;
+    device->active            = true;
+    GenerateHashCRC(&device->id, (char *)"ReplayDevice");
+
+    inputDeviceList[inputDeviceCount++] = device;
+    inputReplay.device                  = device;
+
+    PrintLog(PRINT_NORMAL, "[Replay] Playing back %d frames from %s%s", inputReplay.frameCount, inputReplay.filePath,
+             inputReplay.benchmark ? " (benchmark)" : "");
+}
+
+void RSDK::UpdateInputReplay(bool32 anyPress)
+{
+    switch (inputReplay.state) {
+        default: break;
+
+        case INPUTREPLAY_RECORDING: {
+            uint8 press = anyPress ? true : false;
+            SyncReplayFrame(inputReplay.frame, false, &press);
+
+            uint8 data[INPUTREPLAY_FRAME_SIZE * 2];
+            uint16 len = EncodeReplayFrame(data, inputReplay.frame, inputReplay.prevFrame, inputReplay.frameSize);
+            fWrite(&len, sizeof(len), 1, inputReplay.file);
+            if (len)
+                fWrite(data, 1, len, inputReplay.file);
+
+            memcpy(inputReplay.prevFrame, inputReplay.frame, inputReplay.frameSize);
+            inputReplay.frameCount++;
+            break;
+        }
+
+        case INPUTREPLAY_PLAYING: {
+            if (inputReplay.finished) {
+                StopInputReplay();
+                break;
+            }
+
+            uint8 press = false;
+            SyncReplayFrame(inputReplay.frame, true, &press);
+            break;
+        }
+    }
+}
+
+void RSDK::UpdateInputReplayTiming()
+{
+    if (!inputReplay.benchmark || inputReplay.state != INPUTREPLAY_PLAYING)
+        return;
+
+    int64 time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (inputReplay.lastFrameTime && inputReplay.frameID) {
+        if (inputReplay.frameTimeCount >= inputReplay.frameTimeStorage) {
+            int32 storage = inputReplay.frameTimeStorage ? inputReplay.frameTimeStorage * 2 : (int32)inputReplay.frameCount + 0x100;
+            uint32 *times = (uint32 *)realloc(inputReplay.frameTimes, storage * sizeof(uint32));
+            if (times) {
+                inputReplay.frameTimes       = times;
+                inputReplay.frameTimeStorage = storage;
+            }
+        }
+
+        if (inputReplay.frameTimeCount < inputReplay.frameTimeStorage)
+            inputReplay.frameTimes[inputReplay.frameTimeCount++] = (uint32)(time - inputReplay.lastFrameTime);
+    }
+    inputReplay.lastFrameTime = time;
+}
+
+// Prints the frame time percentiles for a benchmark run
+static void ReportReplayBenchmark()
+{
+    int32 count = inputReplay.frameTimeCount;
+    if (!count) {
+        PrintLog(PRINT_NORMAL, "[Replay] No frames were timed");
+        return;
+    }
+
+    uint32 *times = inputReplay.frameTimes;
+    std::sort(times, times + count);
+
+    uint64 total = 0;
+    for (int32 f = 0; f < count; ++f) total += times[f];
+
+    float percentiles[] = { 50.0f, 90.0f, 95.0f, 99.0f, 99.9f };
+    char buffer[0x200];
+    int32 len = sprintf_s(buffer, sizeof(buffer), "[Replay] %d frames in %.3fs (%.1f fps), avg %.3fms", count, total / 1000000.0,
+                          count * 1000000.0 / (total ? total : 1), total / 1000.0 / count);
+    for (int32 p = 0; p < (int32)(sizeof(percentiles) / sizeof(percentiles[0])); ++p) {
+        int32 id = (int32)(percentiles[p] / 100.0f * (count - 1) + 0.5f);
+        len += sprintf_s(&buffer[len], sizeof(buffer) - len, ", p%g %.3fms", percentiles[p], times[id] / 1000.0);
+    }
+    sprintf_s(&buffer[len], sizeof(buffer) - len, ", max %.3fms", times[count - 1] / 1000.0);
+
+    PrintLog(PRINT_NORMAL, "%s", buffer);
+}
+
+void RSDK::StopInputReplay()
+{
+    if (inputReplay.state == INPUTREPLAY_NONE)
+        return;
+
+    if (inputReplay.state == INPUTREPLAY_RECORDING) {
+        if (inputReplay.file) {
+            InputReplayHeader header;
+            header.signature  = INPUTREPLAY_SIGNATURE;
+            header.version    = INPUTREPLAY_VERSION;
+            header.frameSize  = inputReplay.frameSize;
+            header.frameCount = inputReplay.frameCount;
+
+            fSeek(inputReplay.file, 0, SEEK_SET);
+            fWrite(&header, sizeof(header), 1, inputReplay.file);
+        }
+
+        PrintLog(PRINT_NORMAL, "[Replay] Recorded %d frames to %s", inputReplay.frameCount, inputReplay.filePath);
+    }
+    else {
+        PrintLog(PRINT_NORMAL, "[Replay] Finished playing back %d/%d frames", inputReplay.frameID, inputReplay.frameCount);
+
+        if (inputReplay.device)
+            RemoveInputDevice(inputReplay.device);
+        inputReplay.device = NULL;
+
+        // hand everything back to the real devices
+        for (int32 i = 0; i < inputDeviceCount; ++i) {
+            if (inputDeviceList[i])
+                inputDeviceList[i]->disabled = false;
+        }
+
+        if (inputReplay.benchmark) {
+            ReportReplayBenchmark();
+            RenderDevice::isRunning = false;
+        }
+    }
+
+    if (inputReplay.file)
+        fClose(inputReplay.file);
+    inputReplay.file = NULL;
+
+    if (inputReplay.frameTimes)
+        free(inputReplay.frameTimes);
+    inputReplay.frameTimes       = NULL;
+    inputReplay.frameTimeCount   = 0;
+    inputReplay.frameTimeStorage = 0;
+    inputReplay.lastFrameTime    = 0;
+
+    inputReplay.state = INPUTREPLAY_NONE;
+}
@@ -0,0 +1,62 @@
+
+// Deterministic input recording & playback, mostly used for repeatable benchmarks
+// Recording stores the final input state of every ProcessInput() call (after the press/down handling) along with the rng seed, so
+// playback reproduces exactly what the game saw, no matter which devices were used to make the recording
+// Frames are stored as the bytes that changed since the previous frame, so a recording of mostly held inputs is only a few bytes per frame
+
+#define INPUTREPLAY_SIGNATURE  (0x35504C52) // "RLP5"
+#define INPUTREPLAY_VERSION    (1)
+#define INPUTREPLAY_FRAME_SIZE (0x800)
+
+enum InputReplayStates {
+    INPUTREPLAY_NONE,
+    INPUTREPLAY_RECORDING,
+    INPUTREPLAY_PLAYING,
+};
+
+struct InputReplayHeader {
+    uint32 signature;
+    uint16 version;
+    uint16 frameSize;
+    uint32 frameCount;
+};
+
+// the virtual device that's handed the input slots during playback, the real devices are disabled until it's done
+struct InputDeviceReplay : InputDevice {
+    void UpdateInput();
+    void ProcessInput(int32 controllerID) {}
+};
+
+struct InputReplay {
+    uint8 state     = INPUTREPLAY_NONE;
+    bool32 finished = false;
+    // plays back as fast as possible & reports the frame times when it's done, then quits
+    bool32 benchmark = false;
+    char filePath[0x100];
+
+    FileIO *file      = NULL;
+    uint32 frameID    = 0;
+    uint32 frameCount = 0;
+    int32 frameSize   = 0;
+    uint8 frame[INPUTREPLAY_FRAME_SIZE];
+    uint8 prevFrame[INPUTREPLAY_FRAME_SIZE];
+
+    InputDeviceReplay *device = NULL;
+
+    // benchmark frame times, in microseconds
+    uint32 *frameTimes     = NULL;
+    int32 frameTimeCount   = 0;
+    int32 frameTimeStorage = 0;
+    int64 lastFrameTime    = 0;
+};
+
+extern InputReplay inputReplay;
+
+// called by ParseArguments, the file is opened once the input devices are set up
+void SetupInputReplay(const char *path, uint8 state, bool32 benchmark);
+void StartInputReplay();
+// records or applies the current frame, called at the end of ProcessInput()
+void UpdateInputReplay(bool32 anyPress);
+// called once per engine loop, tracks the frame times when benchmarking
+void UpdateInputReplayTiming();
+void StopInputReplay();
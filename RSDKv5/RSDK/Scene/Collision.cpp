@@ -1,5 +1,7 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#include <chrono>
+
 using namespace RSDK;
 
 #if RETRO_REV0U
@@ -17,20 +19,22 @@ using namespace RSDK;
 #define COLLISION_OFFSET (TO_FIXED(4))
 #endif
 
-int32 RSDK::collisionTolerance = 0;
+CollisionContext RSDK::defaultCollisionContext;
+
+int32 &RSDK::collisionTolerance = defaultCollisionContext.collisionTolerance;
 #if RETRO_REV0U
-bool32 RSDK::useCollisionOffset = false;
+bool32 &RSDK::useCollisionOffset = defaultCollisionContext.useCollisionOffset;
 #else
-int32 RSDK::collisionOffset = 0;
+int32 &RSDK::collisionOffset = defaultCollisionContext.collisionOffset;
 #endif
-int32 RSDK::collisionMaskAir = 0;
+int32 &RSDK::collisionMaskAir = defaultCollisionContext.collisionMaskAir;
 
-Hitbox RSDK::collisionOuter = { 0, 0, 0, 0 };
-Hitbox RSDK::collisionInner = { 0, 0, 0, 0 };
+Hitbox &RSDK::collisionOuter = defaultCollisionContext.collisionOuter;
+Hitbox &RSDK::collisionInner = defaultCollisionContext.collisionInner;
 
-Entity *RSDK::collisionEntity = NULL;
+Entity *&RSDK::collisionEntity = defaultCollisionContext.collisionEntity;
 
-CollisionSensor RSDK::sensors[6];
+CollisionSensor (&RSDK::sensors)[6] = defaultCollisionContext.sensors;
 
 #if RETRO_REV0U
 #if RETRO_USE_ORIGINAL_CODE
@@ -104,6 +108,243 @@ int32 RSDK::AddDebugHitbox(uint8 type, uint8 dir, Entity *entity, Hitbox *hitbox
 
     return -1;
 }
+
+bool32 RSDK::useCollisionField = false;
+CollisionField RSDK::collisionField;
+CollisionBench RSDK::collisionBench;
+
+// a tile counts as solid if either of the plane's solidity bits are set, which covers every sensor direction
+static inline uint8 GetCollisionFieldSolidity(uint16 tile, uint8 cPlane)
+{
+    return tile < 0xFFFF && (tile & (cPlane ? ((1 << 14) | (1 << 15)) : ((1 << 12) | (1 << 13))));
+}
+
+static void BuildCollisionFieldTile(int32 tileX, int32 tileY)
+{
+    int32 index  = tileX + (tileY << collisionField.widthShift);
+    uint8 solidA = 0;
+    uint8 solidB = 0;
+
+    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
+        if ((collisionField.layers & layerID) && tileLayers[l].layout && tileLayers[l].xsize && tileLayers[l].ysize) {
+            uint16 tile = tileLayers[l].layout[index];
+            if (GetCollisionFieldSolidity(tile, 0))
+                solidA |= layerID;
+            if (GetCollisionFieldSolidity(tile, 1))
+                solidB |= layerID;
+        }
+    }
+
+    collisionField.solidLayers[0][index] = solidA;
+    collisionField.solidLayers[1][index] = solidB;
+}
+
+bool32 RSDK::BuildCollisionField(uint16 cLayers)
+{
+    cLayers |= collisionField.layers;
+
+    // every layer in the field has to share the same layout dimensions, the first usable one decides what they are
+    TileLayer *base = NULL;
+    uint16 layers   = 0;
+    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
+        if (cLayers & layerID) {
+            TileLayer *layer = &tileLayers[l];
+            if (!layer->layout || !layer->xsize || !layer->ysize) {
+                // unused layers can't be collided with anyway, so they're merged in as being empty everywhere
+                layers |= layerID;
+            }
+            else if (!base || (layer->xsize == base->xsize && layer->ysize == base->ysize && layer->widthShift == base->widthShift)) {
+                if (!base)
+                    base = layer;
+                layers |= layerID;
+            }
+            else {
+                collisionField.rejectedLayers |= layerID;
+            }
+        }
+    }
+
+    if (!base) {
+        // nothing to build it from, don't go looking again every time these layers are collided with
+        collisionField.rejectedLayers |= cLayers;
+        return false;
+    }
+
+    RemoveStorageEntry((void **)&collisionField.solidLayers[0]);
+    RemoveStorageEntry((void **)&collisionField.solidLayers[1]);
+
+    uint32 size = (uint32)base->ysize << base->widthShift;
+    AllocateStorage((void **)&collisionField.solidLayers[0], size, DATASET_STG, true);
+    AllocateStorage((void **)&collisionField.solidLayers[1], size, DATASET_STG, true);
+    if (!collisionField.solidLayers[0] || !collisionField.solidLayers[1]) {
+        RemoveStorageEntry((void **)&collisionField.solidLayers[0]);
+        RemoveStorageEntry((void **)&collisionField.solidLayers[1]);
+        collisionField.layers = 0;
+        collisionField.rejectedLayers |= cLayers;
+        return false;
+    }
+
+    collisionField.layers     = layers;
+    collisionField.xsize      = base->xsize;
+    collisionField.ysize      = base->ysize;
+    collisionField.widthShift = base->widthShift;
+
+    for (int32 y = 0; y < collisionField.ysize; ++y) {
+        for (int32 x = 0; x < collisionField.xsize; ++x) BuildCollisionFieldTile(x, y);
+    }
+
+    return (layers & cLayers) == cLayers;
+}
+
+void RSDK::ReleaseCollisionField()
+{
+    // not removed from storage here, the scene loader has already cleared out (or is about to clear out) the stage storage
+    // so it'll just get garbage collected like the old layer layouts (a snapshot restore rewinds the storage the same way)
+    collisionField.solidLayers[0] = NULL;
+    collisionField.solidLayers[1] = NULL;
+    collisionField.layers         = 0;
+    collisionField.rejectedLayers = 0;
+    collisionField.xsize          = 0;
+    collisionField.ysize          = 0;
+    collisionField.widthShift     = 0;
+}
+
+void RSDK::UpdateCollisionField(uint16 layerID, int32 tileX, int32 tileY)
+{
+    if (collisionField.layers & (1 << layerID))
+        BuildCollisionFieldTile(tileX, tileY);
+}
+
+uint16 RSDK::GetCollisionFieldLayers(uint16 cLayers, uint8 cPlane, int32 posX, int32 posY, bool32 vertical, bool32 canBuild)
+{
+    if ((collisionField.layers & cLayers) != cLayers) {
+        // only build from the main thread, the field is shared by every context
+        if (!canBuild || (collisionField.rejectedLayers & cLayers) || !BuildCollisionField(cLayers))
+            return cLayers;
+    }
+
+    // the sensors only ever step a tile or two away from where they start, but moving layers would throw that (and the shared grid) off
+    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
+        if ((cLayers & layerID) && (tileLayers[l].position.x || tileLayers[l].position.y))
+            return cLayers;
+    }
+
+    int32 tileX  = posX >> 4;
+    int32 tileY  = posY >> 4;
+    uint8 *solid = collisionField.solidLayers[cPlane ? 1 : 0];
+    uint8 layers = 0;
+
+    if (vertical) {
+        if (tileX < 0 || tileX >= collisionField.xsize)
+            return 0;
+
+        int32 startY = MAX(tileY - 2, 0);
+        int32 endY   = MIN(tileY + 2, collisionField.ysize - 1);
+        for (int32 y = startY; y <= endY; ++y) layers |= solid[tileX + (y << collisionField.widthShift)];
+    }
+    else {
+        if (tileY < 0 || tileY >= collisionField.ysize)
+            return 0;
+
+        int32 startX = MAX(tileX - 2, 0);
+        int32 endX   = MIN(tileX + 2, collisionField.xsize - 1);
+        for (int32 x = startX; x <= endX; ++x) layers |= solid[x + (tileY << collisionField.widthShift)];
+    }
+
+    return cLayers & layers;
+}
+
+void RSDK::RecordCollisionBench(Entity *entity, Hitbox *outerBox, Hitbox *innerBox)
+{
+    if (!collisionBench.entries) {
+        collisionBench.entries = (CollisionBenchEntry *)malloc(COLLISIONBENCH_ENTRY_COUNT * sizeof(CollisionBenchEntry));
+        if (!collisionBench.entries) {
+            collisionBench.recording = false;
+            return;
+        }
+    }
+
+    if (collisionBench.entryCount < COLLISIONBENCH_ENTRY_COUNT) {
+        CollisionBenchEntry *entry = &collisionBench.entries[collisionBench.entryCount++];
+        memcpy(&entry->entity, entity, sizeof(Entity));
+        entry->outerBox = *outerBox;
+        entry->innerBox = *innerBox;
+    }
+    else {
+        PrintLog(PRINT_NORMAL, "[CollisionBench] Recording buffer full (%d moves)", collisionBench.entryCount);
+        collisionBench.recording = false;
+    }
+}
+
+static int64 RunCollisionBenchPass(CollisionContext *context, Entity *results)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int32 p = 0; p < COLLISIONBENCH_PASS_COUNT; ++p) {
+        for (int32 e = 0; e < collisionBench.entryCount; ++e) {
+            CollisionBenchEntry *entry = &collisionBench.entries[e];
+            Entity *entity             = &results[e];
+            memcpy(entity, &entry->entity, sizeof(Entity));
+            context->ProcessObjectMovement(entity, &entry->outerBox, &entry->innerBox);
+        }
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RSDK::UpdateCollisionBench()
+{
+    if (!collisionBench.run)
+        return;
+    collisionBench.run = false;
+
+    if (!collisionBench.entryCount) {
+        PrintLog(PRINT_NORMAL, "[CollisionBench] Nothing recorded, enable \"Col Bench Rec\" first");
+        return;
+    }
+
+    Entity *reference = (Entity *)malloc(collisionBench.entryCount * sizeof(Entity));
+    Entity *field     = (Entity *)malloc(collisionBench.entryCount * sizeof(Entity));
+    if (!reference || !field) {
+        free(reference);
+        free(field);
+        return;
+    }
+
+    // the replay runs on its own context so the game's collision state is left alone,
+    // which also means the field has to be built here since other contexts never build it themselves
+    uint16 layers = 0;
+    for (int32 e = 0; e < collisionBench.entryCount; ++e) layers |= collisionBench.entries[e].entity.collisionLayers;
+    BuildCollisionField(layers);
+
+    CollisionContext context;
+    bool32 prevUseField = useCollisionField;
+
+    useCollisionField = false;
+    int64 referenceTime = RunCollisionBenchPass(&context, reference);
+
+    useCollisionField = true;
+    int64 fieldTime   = RunCollisionBenchPass(&context, field);
+
+    useCollisionField = prevUseField;
+
+    int32 mismatches = 0;
+    for (int32 e = 0; e < collisionBench.entryCount; ++e) {
+        if (memcmp(&reference[e], &field[e], sizeof(Entity)))
+            ++mismatches;
+    }
+
+    PrintLog(PRINT_NORMAL, "[CollisionBench] %d moves x %d passes: regular %.3fms, field %.3fms (%.2fx), %d mismatches", collisionBench.entryCount,
+             COLLISIONBENCH_PASS_COUNT, referenceTime / 1000.0, fieldTime / 1000.0, fieldTime ? (double)referenceTime / fieldTime : 0.0, mismatches);
+
+    free(reference);
+    free(field);
+}
+
+void RSDK::ClearCollisionBench()
+{
+    collisionBench.entryCount = 0;
+}
 #endif
 
 #if RETRO_REV0U || RETRO_USE_MOD_LOADER
@@ -619,6 +860,11 @@ bool32 RSDK::ObjectTileCollision(Entity *entity, uint16 cLayers, uint8 cMode, ui
     int32 posX      = FROM_FIXED(xOffset + entity->position.x);
     int32 posY      = FROM_FIXED(yOffset + entity->position.y);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, cPlane, posX, posY, cMode == CMODE_FLOOR || cMode == CMODE_ROOF, true);
+#endif
+
     int32 solid = 0;
     switch (cMode) {
         default: return false;
@@ -767,6 +1013,11 @@ bool32 RSDK::ObjectTileGrip(Entity *entity, uint16 cLayers, uint8 cMode, uint8 c
     int32 posX      = FROM_FIXED(xOffset + entity->position.x);
     int32 posY      = FROM_FIXED(yOffset + entity->position.y);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, cPlane, posX, posY, cMode == CMODE_FLOOR || cMode == CMODE_ROOF, true);
+#endif
+
     int32 solid = 0;
     switch (cMode) {
         default: return false;
@@ -921,9 +1172,14 @@ bool32 RSDK::ObjectTileGrip(Entity *entity, uint16 cLayers, uint8 cMode, uint8 c
     }
 }
 
-void RSDK::ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox)
+void RSDK::CollisionContext::ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox)
 {
     if (entity && outerBox && innerBox) {
+#if !RETRO_USE_ORIGINAL_CODE
+        if (collisionBench.recording && this == &defaultCollisionContext)
+            RecordCollisionBench(entity, outerBox, innerBox);
+#endif
+
         if (entity->tileCollisions) {
             entity->angle &= 0xFF;
 
@@ -1002,7 +1258,7 @@ void RSDK::ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *inner
     }
 }
 
-void RSDK::ProcessAirCollision_Down()
+void RSDK::CollisionContext::ProcessAirCollision_Down()
 {
     uint8 movingDown  = 0;
     uint8 movingUp    = 0;
@@ -1301,7 +1557,7 @@ void RSDK::ProcessAirCollision_Down()
     }
 }
 #if RETRO_REV0U
-void RSDK::ProcessAirCollision_Up()
+void RSDK::CollisionContext::ProcessAirCollision_Up()
 {
     uint8 movingDown  = 0;
     uint8 movingUp    = 0;
@@ -1595,7 +1851,7 @@ void RSDK::ProcessAirCollision_Up()
     }
 }
 #endif
-void RSDK::ProcessPathGrip()
+void RSDK::CollisionContext::ProcessPathGrip()
 {
     int32 xVel = 0;
     int32 yVel = 0;
@@ -2085,7 +2341,7 @@ void RSDK::ProcessPathGrip()
     }
 }
 
-void RSDK::SetPathGripSensors(CollisionSensor *sensors)
+void RSDK::CollisionContext::SetPathGripSensors(CollisionSensor *sensors)
 {
     int32 offset = 0;
 #if RETRO_REV0U
@@ -2159,7 +2415,7 @@ void RSDK::SetPathGripSensors(CollisionSensor *sensors)
     }
 }
 
-void RSDK::FindFloorPosition(CollisionSensor *sensor)
+void RSDK::CollisionContext::FindFloorPosition(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2176,8 +2432,14 @@ void RSDK::FindFloorPosition(CollisionSensor *sensor)
 
     int32 startY = posY;
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, true, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2228,7 +2490,7 @@ void RSDK::FindFloorPosition(CollisionSensor *sensor)
         }
     }
 }
-void RSDK::FindLWallPosition(CollisionSensor *sensor)
+void RSDK::CollisionContext::FindLWallPosition(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2237,8 +2499,14 @@ void RSDK::FindLWallPosition(CollisionSensor *sensor)
 
     int32 startX = posX;
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, false, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2276,7 +2544,7 @@ void RSDK::FindLWallPosition(CollisionSensor *sensor)
         }
     }
 }
-void RSDK::FindRoofPosition(CollisionSensor *sensor)
+void RSDK::CollisionContext::FindRoofPosition(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2293,8 +2561,14 @@ void RSDK::FindRoofPosition(CollisionSensor *sensor)
 
     int32 startY = posY;
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, true, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2333,7 +2607,7 @@ void RSDK::FindRoofPosition(CollisionSensor *sensor)
         }
     }
 }
-void RSDK::FindRWallPosition(CollisionSensor *sensor)
+void RSDK::CollisionContext::FindRWallPosition(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2342,8 +2616,14 @@ void RSDK::FindRWallPosition(CollisionSensor *sensor)
 
     int32 startX = posX;
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, false, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2383,7 +2663,7 @@ void RSDK::FindRWallPosition(CollisionSensor *sensor)
     }
 }
 
-void RSDK::FloorCollision(CollisionSensor *sensor)
+void RSDK::CollisionContext::FloorCollision(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2403,8 +2683,14 @@ void RSDK::FloorCollision(CollisionSensor *sensor)
     int32 collidePos   = 0x7FFFFFFF;
 #endif
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, true, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2469,15 +2755,21 @@ void RSDK::FloorCollision(CollisionSensor *sensor)
     }
 #endif
 }
-void RSDK::LWallCollision(CollisionSensor *sensor)
+void RSDK::CollisionContext::LWallCollision(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
 
     int32 solid = collisionEntity->collisionPlane ? (1 << 15) : (1 << 13);
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, false, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2509,7 +2801,7 @@ void RSDK::LWallCollision(CollisionSensor *sensor)
         }
     }
 }
-void RSDK::RoofCollision(CollisionSensor *sensor)
+void RSDK::CollisionContext::RoofCollision(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
@@ -2529,8 +2821,14 @@ void RSDK::RoofCollision(CollisionSensor *sensor)
     int32 collidePos   = -1;
 #endif
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, true, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
@@ -2595,15 +2893,21 @@ void RSDK::RoofCollision(CollisionSensor *sensor)
     }
 #endif
 }
-void RSDK::RWallCollision(CollisionSensor *sensor)
+void RSDK::CollisionContext::RWallCollision(CollisionSensor *sensor)
 {
     int32 posX = FROM_FIXED(sensor->position.x);
     int32 posY = FROM_FIXED(sensor->position.y);
 
     int32 solid = collisionEntity->collisionPlane ? (1 << 15) : (1 << 13);
 
+    uint16 cLayers = collisionEntity->collisionLayers;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (useCollisionField)
+        cLayers = GetCollisionFieldLayers(cLayers, collisionEntity->collisionPlane, posX, posY, false, this == &defaultCollisionContext);
+#endif
+
     for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
+        if (cLayers & layerID) {
             TileLayer *layer = &tileLayers[l];
             int32 colX       = posX - layer->position.x;
             int32 colY       = posY - layer->position.y;
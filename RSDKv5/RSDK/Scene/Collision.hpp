@@ -46,20 +46,111 @@ extern DebugHitboxInfo debugHitboxList[DEBUG_HITBOX_COUNT];
 int32 AddDebugHitbox(uint8 type, uint8 dir, Entity *entity, Hitbox *hitbox);
 #endif
 
-extern int32 collisionTolerance;
+// Everything the tile physics passes between ProcessObjectMovement, the path grip/air collision routines & the sensor functions
+// Contexts don't share any state, so separate entities can be moved on separate threads as long as each thread has its own context
+// (and nothing is changing the tile layers or collision config at the same time)
+struct CollisionContext {
+    Entity *collisionEntity = NULL;
+    CollisionSensor sensors[6];
+
+    Hitbox collisionOuter = { 0, 0, 0, 0 };
+    Hitbox collisionInner = { 0, 0, 0, 0 };
+
+    int32 collisionTolerance = 0;
 #if RETRO_REV0U
-extern bool32 useCollisionOffset;
+    bool32 useCollisionOffset = false;
 #else
-extern int32 collisionOffset;
+    int32 collisionOffset = 0;
+#endif
+    int32 collisionMaskAir = 0;
+
+    void ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox);
+
+    void ProcessPathGrip();
+    void ProcessAirCollision_Down();
+#if RETRO_REV0U
+    void ProcessAirCollision_Up();
 #endif
-extern int32 collisionMaskAir;
 
-extern Hitbox collisionOuter;
-extern Hitbox collisionInner;
+    void SetPathGripSensors(CollisionSensor *cSensors);
 
-extern Entity *collisionEntity;
+    void FindFloorPosition(CollisionSensor *sensor);
+    void FindLWallPosition(CollisionSensor *sensor);
+    void FindRoofPosition(CollisionSensor *sensor);
+    void FindRWallPosition(CollisionSensor *sensor);
+
+    void FloorCollision(CollisionSensor *sensor);
+    void LWallCollision(CollisionSensor *sensor);
+    void RoofCollision(CollisionSensor *sensor);
+    void RWallCollision(CollisionSensor *sensor);
+};
 
-extern CollisionSensor sensors[6];
+// used by the engine's own API (and so the game & mods)
+extern CollisionContext defaultCollisionContext;
+
+// kept around as aliases of the default context's state
+extern int32 &collisionTolerance;
+#if RETRO_REV0U
+extern bool32 &useCollisionOffset;
+#else
+extern int32 &collisionOffset;
+#endif
+extern int32 &collisionMaskAir;
+
+extern Hitbox &collisionOuter;
+extern Hitbox &collisionInner;
+
+extern Entity *&collisionEntity;
+
+extern CollisionSensor (&sensors)[6];
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Optional acceleration structure for tile collision against several layers at once
+// For every tile of each collision plane it stores which of the merged layers have something solid there, so the sensors only walk the
+// layers that can actually collide around them (and none at all in open air)
+// SetTile & CopyTileLayer keep it up to date, but writes straight to layer->layout don't, which is why it's opt-in
+struct CollisionField {
+    uint8 *solidLayers[2]; // one bit per layer (LAYER_COUNT is 8), per plane
+    uint16 layers;         // layers merged into the field
+    uint16 rejectedLayers; // layers that don't match the field's size, these always take the regular path
+    int32 xsize;
+    int32 ysize;
+    uint8 widthShift;
+};
+
+extern bool32 useCollisionField;
+extern CollisionField collisionField;
+
+bool32 BuildCollisionField(uint16 cLayers);
+void ReleaseCollisionField();
+// narrows cLayers down to the layers with solid tiles within 2 tiles of posX/posY (along the sensor's axis)
+uint16 GetCollisionFieldLayers(uint16 cLayers, uint8 cPlane, int32 posX, int32 posY, bool32 vertical, bool32 canBuild);
+
+// Records ProcessObjectMovement calls on the default context so they can be replayed with & without the collision field
+#define COLLISIONBENCH_ENTRY_COUNT (0x4000)
+#define COLLISIONBENCH_PASS_COUNT  (16)
+
+struct CollisionBenchEntry {
+    Entity entity;
+    Hitbox outerBox;
+    Hitbox innerBox;
+};
+
+struct CollisionBench {
+    // exposed as viewable variables
+    bool32 recording = false;
+    bool32 run       = false;
+
+    CollisionBenchEntry *entries = NULL;
+    int32 entryCount             = 0;
+};
+
+extern CollisionBench collisionBench;
+
+void RecordCollisionBench(Entity *entity, Hitbox *outerBox, Hitbox *innerBox);
+void UpdateCollisionBench();
+void ClearCollisionBench();
+#endif
 
 #if RETRO_REV0U
 extern int32 collisionMinimumDistance;
@@ -129,25 +220,28 @@ bool32 CheckObjectCollisionPlatform(Entity *thisEntity, Hitbox *thisHitbox, Enti
 bool32 ObjectTileCollision(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cPlane, int32 xOffset, int32 yOffset, bool32 setPos);
 bool32 ObjectTileGrip(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cPlane, int32 xOffset, int32 yOffset, int32 tolerance);
 
-void ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox);
+inline void ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox)
+{
+    defaultCollisionContext.ProcessObjectMovement(entity, outerBox, innerBox);
+}
 
-void ProcessPathGrip();
-void ProcessAirCollision_Down();
+inline void ProcessPathGrip() { defaultCollisionContext.ProcessPathGrip(); }
+inline void ProcessAirCollision_Down() { defaultCollisionContext.ProcessAirCollision_Down(); }
 #if RETRO_REV0U
-void ProcessAirCollision_Up();
+inline void ProcessAirCollision_Up() { defaultCollisionContext.ProcessAirCollision_Up(); }
 #endif
 
-void SetPathGripSensors(CollisionSensor *cSensors);
+inline void SetPathGripSensors(CollisionSensor *cSensors) { defaultCollisionContext.SetPathGripSensors(cSensors); }
 
-void FindFloorPosition(CollisionSensor *sensor);
-void FindLWallPosition(CollisionSensor *sensor);
-void FindRoofPosition(CollisionSensor *sensor);
-void FindRWallPosition(CollisionSensor *sensor);
+inline void FindFloorPosition(CollisionSensor *sensor) { defaultCollisionContext.FindFloorPosition(sensor); }
+inline void FindLWallPosition(CollisionSensor *sensor) { defaultCollisionContext.FindLWallPosition(sensor); }
+inline void FindRoofPosition(CollisionSensor *sensor) { defaultCollisionContext.FindRoofPosition(sensor); }
+inline void FindRWallPosition(CollisionSensor *sensor) { defaultCollisionContext.FindRWallPosition(sensor); }
 
-void FloorCollision(CollisionSensor *sensor);
-void LWallCollision(CollisionSensor *sensor);
-void RoofCollision(CollisionSensor *sensor);
-void RWallCollision(CollisionSensor *sensor);
+inline void FloorCollision(CollisionSensor *sensor) { defaultCollisionContext.FloorCollision(sensor); }
+inline void LWallCollision(CollisionSensor *sensor) { defaultCollisionContext.LWallCollision(sensor); }
+inline void RoofCollision(CollisionSensor *sensor) { defaultCollisionContext.RoofCollision(sensor); }
+inline void RWallCollision(CollisionSensor *sensor) { defaultCollisionContext.RWallCollision(sensor); }
 
 #if RETRO_REV0U
 #include "Legacy/CollisionLegacy.hpp"
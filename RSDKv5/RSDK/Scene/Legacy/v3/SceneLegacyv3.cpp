@@ -311,6 +311,11 @@ void RSDK::Legacy::v3::LoadStageFiles()
     FileInfo info;
     InitFileInfo(&info);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // the dev menu can load a stage in the middle of a video
+    ReleaseVideo();
+#endif
+
     if (!CheckCurrentStageFolder()) {
         PrintLog(PRINT_NORMAL, "Loading Scene %s - %s", sceneInfo.listCategory[sceneInfo.activeCategory].name,
                  sceneInfo.listData[sceneInfo.listPos].name);
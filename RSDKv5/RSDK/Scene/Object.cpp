@@ -1,5 +1,12 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 using namespace RSDK;
 
 #if RETRO_REV0U
@@ -22,6 +29,12 @@ TypeGroupList RSDK::typeGroups[TYPEGROUP_COUNT];
 
 bool32 RSDK::validDraw = false;
 
+#if !RETRO_USE_ORIGINAL_CODE
+NameMap RSDK::objectNameMap;
+
+TempEntityInfo RSDK::tempEntityInfo;
+#endif
+
 ForeachStackInfo RSDK::foreachStackList[FOREACH_STACK_COUNT];
 ForeachStackInfo *RSDK::foreachStackPtr = NULL;
 
@@ -306,11 +319,144 @@ void RSDK::LoadStaticVariables(uint8 *classPtr, uint32 *hash, int32 readOffset)
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::InitTempEntityPools()
+{
+    // stretch the region down into the scene slots, but never past the last one the stage loaded into
+    int32 start = ENTITY_COUNT - CLAMP(engine.tempEntityCount, TEMPENTITY_COUNT, TEMPENTITY_COUNT_MAX);
+    for (int32 s = TEMPENTITY_START - 1; s >= start; --s) {
+        if (objectEntityList[s].classID) {
+            start = s + 1;
+            break;
+        }
+    }
+
+    memset(&tempEntityInfo, 0, sizeof(tempEntityInfo));
+    tempEntityInfo.start = start;
+
+    TempEntityPool *shared = &tempEntityInfo.pools[0];
+    shared->classID        = TYPE_DEFAULTOBJECT;
+    shared->start          = start;
+    shared->count          = ENTITY_COUNT - start;
+
+    tempEntityInfo.poolCount = 1;
+    tempEntityInfo.stale     = true;
+}
+
+static inline int32 FindFirstBit(uint64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#elif defined(_MSC_VER)
+    unsigned long id = 0;
+    if (_BitScanForward(&id, (uint32)bits))
+        return id;
+    _BitScanForward(&id, (uint32)(bits >> 32));
+    return id + 32;
+#else
+    int32 id = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++id;
+    }
+    return id;
+#endif
+}
+
+// Returns the first free bit in [first, last) (relative to the start of the temp region), -1 if there isn't one
+static int32 FindFreeTempEntityBit(int32 first, int32 last)
+{
+    if (first >= last)
+        return -1;
+
+    int32 lastWord = (last - 1) >> 6;
+    for (int32 w = first >> 6; w <= lastWord; ++w) {
+        uint64 bits = tempEntityInfo.freeSlots[w];
+        if (w == first >> 6)
+            bits &= ~0ull << (first & 63);
+        if (w == lastWord && (last & 63))
+            bits &= (1ull << (last & 63)) - 1;
+
+        if (bits)
+            return (w << 6) + FindFirstBit(bits);
+    }
+
+    return -1;
+}
+
+// Rebuilds the free bits from the entities themselves
+static void RefreshTempEntitySlots()
+{
+    memset(tempEntityInfo.freeSlots, 0, sizeof(tempEntityInfo.freeSlots));
+
+    for (int32 s = tempEntityInfo.start; s < ENTITY_COUNT; ++s) {
+        if (!objectEntityList[s].classID) {
+            int32 bit = s - tempEntityInfo.start;
+            tempEntityInfo.freeSlots[bit >> 6] |= 1ull << (bit & 63);
+        }
+    }
+
+    tempEntityInfo.stale = false;
+}
+
+// Takes the first free slot in the pool at or after cursor, wrapping around to the start of the pool, -1 if it's full
+static int32 TakeTempEntitySlot(TempEntityPool *pool, int32 cursor)
+{
+    // the first 16 slots are probed just like the original did, which keeps the order slots get handed out in the same
+    int32 slot = cursor;
+    for (int32 i = 0; i < 16 && i < pool->count; ++i) {
+        if (!objectEntityList[slot].classID) {
+            int32 bit = slot - tempEntityInfo.start;
+            tempEntityInfo.freeSlots[bit >> 6] &= ~(1ull << (bit & 63));
+            return slot;
+        }
+
+        if (++slot == pool->start + pool->count)
+            slot = pool->start;
+    }
+
+    // this is where the original would've started overwriting entities, the bits find the next free slot instead
+    if (tempEntityInfo.stale)
+        RefreshTempEntitySlots();
+
+    int32 first = pool->start - tempEntityInfo.start;
+    int32 last  = first + pool->count;
+    int32 from  = slot - tempEntityInfo.start;
+
+    while (true) {
+        int32 bit = FindFreeTempEntityBit(from, last);
+        if (bit < 0)
+            bit = FindFreeTempEntityBit(first, from);
+        if (bit < 0)
+            return -1;
+
+        tempEntityInfo.freeSlots[bit >> 6] &= ~(1ull << (bit & 63));
+
+        // it may have been reused without going through CreateEntity since it was freed
+        int32 slot = tempEntityInfo.start + bit;
+        if (!objectEntityList[slot].classID)
+            return slot;
+    }
+}
+
+// Marks a temp slot that was just cleared as free
+static void ReleaseTempEntitySlot(int32 slot)
+{
+    if (slot >= tempEntityInfo.start && slot < ENTITY_COUNT) {
+        int32 bit = slot - tempEntityInfo.start;
+        tempEntityInfo.freeSlots[bit >> 6] |= 1ull << (bit & 63);
+    }
+}
+#endif
+
 void RSDK::InitObjects()
 {
     sceneInfo.entitySlot = 0;
     sceneInfo.createSlot = ENTITY_COUNT - 0x100;
     cameraCount          = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+    InitTempEntityPools();
+#endif
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
 #if RETRO_USE_MOD_LOADER
@@ -332,6 +478,8 @@ void RSDK::InitObjects()
         if (sceneInfo.entity->classID) {
             if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].create) {
                 sceneInfo.entity->interaction = true;
+
+                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_CREATE);
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].create(NULL);
             }
         }
@@ -344,6 +492,12 @@ void RSDK::InitObjects()
 }
 void RSDK::ProcessObjects()
 {
+    PROFILE_ZONE(PROFILE_OBJECTS);
+
+#if !RETRO_USE_ORIGINAL_CODE
+    tempEntityInfo.stale = true;
+#endif
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -353,8 +507,10 @@ void RSDK::ProcessObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_NORMAL) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILE_CB_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -448,8 +604,10 @@ void RSDK::ProcessObjects()
             }
 
             if (sceneInfo.entity->inRange) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_UPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
                     drawGroups[sceneInfo.entity->drawGroup].entries[drawGroups[sceneInfo.entity->drawGroup].entityCount++] = sceneInfo.entitySlot;
@@ -489,8 +647,10 @@ void RSDK::ProcessObjects()
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange) {
-            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_LATEUPDATE);
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+            }
         }
 
         sceneInfo.entity->onScreen = 0;
@@ -503,6 +663,12 @@ void RSDK::ProcessObjects()
 }
 void RSDK::ProcessPausedObjects()
 {
+    PROFILE_ZONE(PROFILE_OBJECTS);
+
+#if !RETRO_USE_ORIGINAL_CODE
+    tempEntityInfo.stale = true;
+#endif
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -512,8 +678,10 @@ void RSDK::ProcessPausedObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_PAUSED) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILE_CB_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -527,8 +695,10 @@ void RSDK::ProcessPausedObjects()
 
         if (sceneInfo.entity->classID) {
             if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_UPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
                     drawGroups[sceneInfo.entity->drawGroup].entries[drawGroups[sceneInfo.entity->drawGroup].entityCount++] = sceneInfo.entitySlot;
@@ -550,8 +720,10 @@ void RSDK::ProcessPausedObjects()
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_LATEUPDATE);
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+            }
         }
 
         sceneInfo.entity->onScreen = 0;
@@ -564,6 +736,12 @@ void RSDK::ProcessPausedObjects()
 }
 void RSDK::ProcessFrozenObjects()
 {
+    PROFILE_ZONE(PROFILE_OBJECTS);
+
+#if !RETRO_USE_ORIGINAL_CODE
+    tempEntityInfo.stale = true;
+#endif
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -573,8 +751,10 @@ void RSDK::ProcessFrozenObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_PAUSED) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILE_CB_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -670,8 +850,10 @@ void RSDK::ProcessFrozenObjects()
 
             if (sceneInfo.entity->inRange) {
                 if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                    if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+                    if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+                        PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_UPDATE);
                         objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                    }
                 }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
@@ -697,8 +879,10 @@ void RSDK::ProcessFrozenObjects()
 
         if (sceneInfo.entity->inRange) {
             if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_LATEUPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+                }
             }
 
             if (sceneInfo.entity->interaction) {
@@ -719,13 +903,77 @@ void RSDK::ProcessFrozenObjects()
     RunModCallbacks(MODCB_ONLATEUPDATE, INT_TO_VOID(ENGINESTATE_FROZEN));
 #endif
 }
+#if !RETRO_USE_ORIGINAL_CODE
+// any more out of order entries than this & a merge sort wins over shuffling entries around one at a time
+#define DRAWLIST_INSERTION_SORT_LIMIT (0x10)
+
+struct DrawListSortEntry {
+    int32 zdepth;
+    uint16 slot;
+};
+
+// Sorts the list by zdepth (highest first), leaving entities with matching depths in the order they were added, exactly like the
+// original bubble sort did
+// The list is still sorted from the previous frame (or the previous screen) more often than not, so most calls are a single read-only pass
+static void SortDrawList(DrawList *list)
+{
+    static int32 depths[ENTITY_COUNT];
+    static DrawListSortEntry sortEntries[ENTITY_COUNT];
+
+    int32 count         = list->entityCount;
+    int32 unsortedCount = 0;
+    for (int32 i = 0; i < count; ++i) {
+        depths[i] = objectEntityList[list->entries[i]].zdepth;
+        if (i && depths[i] > depths[i - 1])
+            ++unsortedCount;
+    }
+
+    if (!unsortedCount)
+        return;
+
+    if (unsortedCount <= DRAWLIST_INSERTION_SORT_LIMIT) {
+        for (int32 i = 1; i < count; ++i) {
+            int32 zdepth = depths[i];
+            if (zdepth <= depths[i - 1])
+                continue;
+
+            uint16 slot = list->entries[i];
+            int32 e     = i;
+            for (; e > 0 && depths[e - 1] < zdepth; --e) {
+                depths[e]        = depths[e - 1];
+                list->entries[e] = list->entries[e - 1];
+            }
+            depths[e]        = zdepth;
+            list->entries[e] = slot;
+        }
+    }
+    else {
+        for (int32 i = 0; i < count; ++i) {
+            sortEntries[i].zdepth = depths[i];
+            sortEntries[i].slot   = list->entries[i];
+        }
+
+        std::stable_sort(sortEntries, sortEntries + count,
+                         [](const DrawListSortEntry &a, const DrawListSortEntry &b) { return a.zdepth > b.zdepth; });
+
+        for (int32 i = 0; i < count; ++i) list->entries[i] = sortEntries[i].slot;
+    }
+}
+#endif
+
 void RSDK::ProcessObjectDrawLists()
 {
+    PROFILE_ZONE(PROFILE_DRAWLISTS);
+
     if (sceneInfo.state != ENGINESTATE_LOAD && sceneInfo.state != (ENGINESTATE_LOAD | ENGINESTATE_STEPOVER)) {
         for (int32 s = 0; s < videoSettings.screenCount; ++s) {
             currentScreen             = &screens[s];
             sceneInfo.currentScreenID = s;
 
+#if !RETRO_USE_ORIGINAL_CODE
+            BeginDeferredDrawing();
+#endif
+
             for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) drawGroups[l].layerCount = 0;
 
             for (int32 t = 0; t < LAYER_COUNT; ++t) {
@@ -738,12 +986,14 @@ void RSDK::ProcessObjectDrawLists()
             sceneInfo.currentDrawGroup = 0;
             for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
                 if (engine.drawGroupVisible[l]) {
+                    PROFILE_DRAWGROUP(l);
                     DrawList *list = &drawGroups[l];
 
                     if (list->hookCB)
                         list->hookCB();
 
                     if (list->sorted) {
+#if RETRO_USE_ORIGINAL_CODE
                         for (int32 e = 0; e < list->entityCount; ++e) {
                             for (int32 i = list->entityCount - 1; i > e; --i) {
                                 int32 slot1 = list->entries[i - 1];
@@ -754,6 +1004,9 @@ void RSDK::ProcessObjectDrawLists()
                                 }
                             }
                         }
+#else
+                        SortDrawList(list);
+#endif
                     }
 
                     for (int32 i = 0; i < list->entityCount; ++i) {
@@ -761,8 +1014,10 @@ void RSDK::ProcessObjectDrawLists()
                         validDraw            = false;
                         sceneInfo.entity     = &objectEntityList[list->entries[i]];
                         if (sceneInfo.entity->visible) {
-                            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw)
+                            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw) {
+                                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILE_CB_DRAW);
                                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw();
+                            }
 
 #if RETRO_VER_EGS || RETRO_USE_DUMMY_ACHIEVEMENTS
                             if (i == list->entityCount - 1)
@@ -824,6 +1079,8 @@ void RSDK::ProcessObjectDrawLists()
             }
 
 #if !RETRO_USE_ORIGINAL_CODE
+            EndDeferredDrawing();
+
             if (engine.showUpdateRanges) {
                 for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
                     if (engine.drawGroupVisible[l]) {
@@ -995,6 +1252,14 @@ void RSDK::ProcessObjectDrawLists()
                 }
             }
 
+            if (inputLatency.showOverlay && s == 0)
+                DrawInputLatencyOverlay();
+
+#if RETRO_USE_PROFILER
+            if (s == 0)
+                DrawProfilerOverlay();
+#endif
+
 #endif
 
             currentScreen++;
@@ -1008,9 +1273,19 @@ uint16 RSDK::FindObject(const char *name)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(name, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 slot = FindNameMapSlot(&objectNameMap, hash);
+    if (slot >= 0 && slot < sceneInfo.classCount && HASH_MATCH_MD5(hash, objectClassList[stageObjectIDs[slot]].hash))
+        return slot;
+#endif
+
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
-        if (HASH_MATCH_MD5(hash, objectClassList[stageObjectIDs[o]].hash))
+        if (HASH_MATCH_MD5(hash, objectClassList[stageObjectIDs[o]].hash)) {
+#if !RETRO_USE_ORIGINAL_CODE
+            SetNameMapSlot(&objectNameMap, hash, o);
+#endif
             return o;
+        }
     }
 
     return TYPE_DEFAULTOBJECT;
@@ -1036,6 +1311,10 @@ void RSDK::ResetEntity(Entity *entity, uint16 classID, void *data)
 {
     if (entity) {
         ObjectClass *info = &objectClassList[stageObjectIDs[classID]];
+#if !RETRO_USE_ORIGINAL_CODE
+        if (classID == TYPE_DEFAULTOBJECT)
+            ReleaseTempEntity(entity);
+#endif
         memset(entity, 0, info->entityClassSize);
 
         if (info->create) {
@@ -1047,7 +1326,10 @@ void RSDK::ResetEntity(Entity *entity, uint16 classID, void *data)
             int32 superStore          = superLevels[inheritLevel];
             superLevels[inheritLevel] = 0;
 #endif
-            info->create(data);
+            {
+                PROFILE_CLASS(stageObjectIDs[classID], PROFILE_CB_CREATE);
+                info->create(data);
+            }
 #if RETRO_USE_MOD_LOADER
             superLevels[inheritLevel] = superStore;
 #endif
@@ -1066,6 +1348,10 @@ void RSDK::ResetEntitySlot(uint16 slot, uint16 classID, void *data)
     slot                = slot < ENTITY_COUNT ? slot : (ENTITY_COUNT - 1);
 
     Entity *entity = &objectEntityList[slot];
+#if !RETRO_USE_ORIGINAL_CODE
+    if (classID == TYPE_DEFAULTOBJECT)
+        ReleaseTempEntitySlot(slot);
+#endif
     memset(&objectEntityList[slot], 0, object->entityClassSize);
 
     if (object->create) {
@@ -1077,7 +1363,10 @@ void RSDK::ResetEntitySlot(uint16 slot, uint16 classID, void *data)
         int32 superStore          = superLevels[inheritLevel];
         superLevels[inheritLevel] = 0;
 #endif
-        object->create(data);
+        {
+            PROFILE_CLASS(stageObjectIDs[classID], PROFILE_CB_CREATE);
+            object->create(data);
+        }
 #if RETRO_USE_MOD_LOADER
         superLevels[inheritLevel] = superStore;
 #endif
@@ -1090,10 +1379,56 @@ void RSDK::ResetEntitySlot(uint16 slot, uint16 classID, void *data)
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+int32 RSDK::AllocateTempEntitySlot(uint16 classID)
+{
+    TempEntityPool *shared = &tempEntityInfo.pools[0];
+    TempEntityPool *pool   = &tempEntityInfo.pools[tempEntityInfo.classPools[classID]];
+    tempEntityInfo.createCount++;
+
+    // the shared pool's cursor is createSlot, same as the original
+    if (sceneInfo.createSlot < shared->start || sceneInfo.createSlot >= ENTITY_COUNT)
+        sceneInfo.createSlot = shared->start;
+
+    int32 slot = -1;
+    if (pool != shared) {
+        slot = TakeTempEntitySlot(pool, pool->cursor);
+        if (slot >= 0)
+            pool->cursor = slot;
+    }
+
+    if (slot < 0) {
+        slot = TakeTempEntitySlot(shared, sceneInfo.createSlot);
+
+        if (slot < 0) {
+            // every slot's taken, pick one to overwrite the same way the original did: the first non-permanent entity after 16 slots
+            slot = sceneInfo.createSlot;
+            for (int32 i = 0; objectEntityList[slot].classID; ++i) {
+                if ((!objectEntityList[slot].isPermanent && i >= 16) || i >= shared->count)
+                    break;
+
+                if (++slot == ENTITY_COUNT)
+                    slot = shared->start;
+            }
+
+            if (objectEntityList[slot].classID)
+                tempEntityInfo.overwriteCount++;
+        }
+
+        sceneInfo.createSlot = slot;
+    }
+
+    return slot;
+}
+#endif
+
 Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
 {
     ObjectClass *object = &objectClassList[stageObjectIDs[classID]];
-    Entity *entity      = &objectEntityList[sceneInfo.createSlot];
+#if !RETRO_USE_ORIGINAL_CODE
+    Entity *entity = &objectEntityList[AllocateTempEntitySlot(classID)];
+#else
+    Entity *entity = &objectEntityList[sceneInfo.createSlot];
 
     int32 permCnt = 0, loopCnt = 0;
     while (entity->classID) {
@@ -1118,6 +1453,7 @@ Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
 
         ++loopCnt;
     }
+#endif
 
     memset(entity, 0, object->entityClassSize);
     entity->position.x  = x;
@@ -1132,7 +1468,10 @@ Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
         int32 superStore          = superLevels[inheritLevel];
         superLevels[inheritLevel] = 0;
 #endif
-        object->create(data);
+        {
+            PROFILE_CLASS(stageObjectIDs[classID], PROFILE_CB_CREATE);
+            object->create(data);
+        }
 #if RETRO_USE_MOD_LOADER
         superLevels[inheritLevel] = superStore;
 #endif
@@ -1149,6 +1488,56 @@ Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
     return entity;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::SetTempEntityPool(uint16 classID, int32 count)
+{
+    TempEntityPool *shared = &tempEntityInfo.pools[0];
+
+    if (classID == TYPE_DEFAULTOBJECT || classID >= sceneInfo.classCount || count <= 0)
+        return;
+
+    if (tempEntityInfo.classPools[classID]) {
+        PrintLog(PRINT_NORMAL, "SetTempEntityPool: class %d already has a temp pool", classID);
+        return;
+    }
+
+    if (tempEntityInfo.poolCount >= TEMPENTITY_POOL_COUNT || shared->count - count < TEMPENTITY_SHARED_MIN) {
+        PrintLog(PRINT_NORMAL, "SetTempEntityPool: no room for %d more temp slots for class %d", count, classID);
+        return;
+    }
+
+    // carved from the bottom of the shared slots
+    TempEntityPool *pool = &tempEntityInfo.pools[tempEntityInfo.poolCount];
+    pool->classID        = classID;
+    pool->start          = shared->start;
+    pool->count          = count;
+    pool->cursor         = pool->start;
+
+    shared->start += count;
+    shared->count -= count;
+
+    tempEntityInfo.classPools[classID] = tempEntityInfo.poolCount++;
+}
+
+int32 RSDK::GetTempEntityUsage()
+{
+    int32 count = 0;
+    for (int32 s = tempEntityInfo.start; s < ENTITY_COUNT; ++s) {
+        if (objectEntityList[s].classID)
+            count++;
+    }
+
+    return count;
+}
+
+void RSDK::ReleaseTempEntity(void *entity)
+{
+    EntityBase *e = (EntityBase *)entity;
+    if (e >= &objectEntityList[tempEntityInfo.start] && e < &objectEntityList[ENTITY_COUNT])
+        ReleaseTempEntitySlot((int32)(e - objectEntityList));
+}
+#endif
+
 bool32 RSDK::GetActiveEntities(uint16 group, Entity **entity)
 {
     if (group >= TYPEGROUP_COUNT)
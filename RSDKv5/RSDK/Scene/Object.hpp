@@ -19,6 +19,14 @@ namespace RSDK
 #define ENTITY_COUNT         (RESERVE_ENTITY_COUNT + SCENEENTITY_COUNT + TEMPENTITY_COUNT)
 #define TEMPENTITY_START     (ENTITY_COUNT - TEMPENTITY_COUNT)
 
+#if !RETRO_USE_ORIGINAL_CODE
+// CreateEntity takes its slots from free lists instead of probing for an empty one (see TempEntityInfo)
+// the temp region can be stretched down into scene slots the stage doesn't use with engine.tempEntityCount, up to TEMPENTITY_COUNT_MAX
+#define TEMPENTITY_COUNT_MAX  (TEMPENTITY_COUNT * 4)
+#define TEMPENTITY_POOL_COUNT (0x10) // the shared pool + up to 15 per-class ones
+#define TEMPENTITY_SHARED_MIN (TEMPENTITY_COUNT / 4) // per-class pools can't shrink the shared one past this
+#endif
+
 #define TYPE_COUNT        (0x100)
 #define EDITABLEVAR_COUNT (0x100)
 #define TYPEGROUP_COUNT   (0x104)
@@ -223,6 +231,40 @@ extern TypeGroupList typeGroups[TYPEGROUP_COUNT];
 
 extern bool32 validDraw;
 
+#if !RETRO_USE_ORIGINAL_CODE
+struct TempEntityPool {
+    uint16 classID; // TYPE_DEFAULTOBJECT for the shared pool
+    uint16 start;   // first slot
+    uint16 count;
+    uint16 cursor;  // the last slot handed out, the next search starts here (the shared pool uses sceneInfo.createSlot instead)
+};
+
+// CreateEntity probes up to 16 slots from its pool's cursor the same way the original did, so it picks the same slot whenever the original
+// would've found a free one. Past that point the original started overwriting live entities, instead the next free slot is found with a bit
+// per slot
+// ResetEntity, ResetEntitySlot & CopyEntity mark a slot free as soon as they clear it, anything cleared by writing to classID directly is
+// picked up when the bits are rebuilt from the entities, the first time they're needed each frame
+struct TempEntityInfo {
+    uint16 start;                                // first slot of the temp region
+    uint64 freeSlots[TEMPENTITY_COUNT_MAX / 64]; // one bit per slot from start onwards, set if it's free
+    TempEntityPool pools[TEMPENTITY_POOL_COUNT]; // pools[0] is the shared one
+    uint8 poolCount;
+    uint8 classPools[TYPE_COUNT]; // stage class ID -> pool, 0 for classes without their own
+    bool32 stale;                 // set every frame, the bits may be missing slots cleared since they were built
+
+    // stats, since the stage was loaded
+    uint32 createCount;
+    uint32 overwriteCount; // live entities CreateEntity had to overwrite because every slot was taken
+};
+
+extern TempEntityInfo tempEntityInfo;
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// stage class slots by name for FindObject, cleared whenever the stage class list is rebuilt
+extern NameMap objectNameMap;
+#endif
+
 #if RETRO_REV0U
 void RegisterObject(Object **staticVars, const char *name, uint32 entityClassSize, uint32 staticClassSize, void (*update)(), void (*lateUpdate)(),
                     void (*staticUpdate)(), void (*draw)(), void (*create)(void *), void (*stageLoad)(), void (*editorLoad)(), void (*editorDraw)(),
@@ -297,14 +339,31 @@ int32 GetEntityCount(uint16 classID, bool32 isActive);
 void ResetEntity(Entity *entity, uint16 classID, void *data);
 void ResetEntitySlot(uint16 slot, uint16 classID, void *data);
 Entity *CreateEntity(uint16 classID, void *data, int32 x, int32 y);
+#if !RETRO_USE_ORIGINAL_CODE
+// lays the temp region out for a new stage (see engine.tempEntityCount), everything starts in the shared pool
+void InitTempEntityPools();
+// picks the slot CreateEntity will use, overwriting a live entity if they're all taken
+int32 AllocateTempEntitySlot(uint16 classID);
+// gives classID count temp slots of its own, taken from the shared pool, meant to be called from StageLoad
+// CreateEntity uses them first & only falls back to the shared pool once they're all taken
+void SetTempEntityPool(uint16 classID, int32 count);
+// the number of temp slots in use
+int32 GetTempEntityUsage();
+// marks the entity's slot as free if it's a temp one, for anything that clears an entity without going through ResetEntity
+void ReleaseTempEntity(void *entity);
+#endif
 
 inline void CopyEntity(void *destEntity, void *srcEntity, bool32 clearSrcEntity)
 {
     if (destEntity && srcEntity) {
         memcpy(destEntity, srcEntity, sizeof(EntityBase));
 
-        if (clearSrcEntity)
+        if (clearSrcEntity) {
             memset(srcEntity, 0, sizeof(EntityBase));
+#if !RETRO_USE_ORIGINAL_CODE
+            ReleaseTempEntity(srcEntity);
+#endif
+        }
     }
 }
 
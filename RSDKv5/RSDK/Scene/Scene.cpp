@@ -1,5 +1,10 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if !RETRO_USE_ORIGINAL_CODE
+#include <thread>
+#include <atomic>
+#endif
+
 using namespace RSDK;
 
 #if RETRO_REV0U
@@ -7,6 +12,13 @@ using namespace RSDK;
 #endif
 
 uint8 RSDK::tilesetPixels[TILESET_SIZE * 4];
+#if !RETRO_USE_ORIGINAL_CODE
+// the furthest (in pixels) a rotozoom line can step per pixel before it stops being drawn in per-tile spans
+#define ROTOZOOM_SPAN_MAX_STEP (4)
+
+uint8 RSDK::tileRowOpacity[TILE_COUNT * 4][TILE_SIZE];
+uint8 RSDK::tileOpacity[TILE_COUNT * 4];
+#endif
 
 ScanlineInfo *RSDK::scanlines = NULL;
 TileLayer RSDK::tileLayers[LAYER_COUNT];
@@ -24,7 +36,7 @@ SceneInfo RSDK::sceneInfo;
 // --- Helper: stop stream channels before we touch storage/defrag during reloads ---
 static void StopStreamingChannels()
 {
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         if (channels[c].state == CHANNEL_STREAM || channels[c].state == CHANNEL_LOADING_STREAM) {
             channels[c].state   = CHANNEL_IDLE;
             channels[c].soundID = -1;
@@ -35,7 +47,7 @@ static void StopStreamingChannels()
 // --- Helper: stop SFX playback without unloading SFX assets ---
 static void StopSfxChannels()
 {
-    for (int32 c = 0; c < CHANNEL_COUNT; ++c) {
+    for (int32 c = 0; c < VOICE_COUNT; ++c) {
         if (channels[c].state == CHANNEL_SFX || channels[c].state == (CHANNEL_SFX | CHANNEL_PAUSED)) {
             channels[c].state   = CHANNEL_IDLE;
             channels[c].soundID = -1;
@@ -43,12 +55,154 @@ static void StopSfxChannels()
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Reads the files for an upcoming scene on a worker thread so ENGINESTATE_LOAD only has to parse them from memory
+static std::thread s_prefetchThread;
+static std::atomic<bool> s_prefetchCancel(false);
+static std::atomic<bool> s_prefetchDone(false);
+static int32 s_prefetchListPos = -1;
+static int32 s_loadedListPos   = -1;
+// the StageConfig that still needs its sfx queued once the first batch is in
+static char s_prefetchStageConfig[SCENE_FILEPATH_SIZE];
+
+static void PrefetchSceneWorker()
+{
+    while (!s_prefetchCancel && ReadNextPrefetchFile()) {
+    }
+
+    s_prefetchDone = true;
+}
+
+static void StartPrefetchWorker()
+{
+    s_prefetchCancel = false;
+    s_prefetchDone   = false;
+    s_prefetchThread = std::thread(PrefetchSceneWorker);
+}
+
+// Queues the stage sfx LoadSceneFolder is going to ask for, the StageConfig they're listed in has already been staged by now
+static void QueueStageSfxPrefetch()
+{
+    FileInfo info;
+    InitFileInfo(&info);
+    if (!LoadFile(&info, s_prefetchStageConfig, FMODE_RB))
+        return;
+
+    int32 queued = 0;
+    if (ReadInt32(&info, false) == RSDK_SIGNATURE_CFG) {
+        char buffer[0x100];
+
+        ReadInt8(&info); // useGlobalObjects
+        uint8 objectCount = ReadInt8(&info);
+        for (int32 o = 0; o < objectCount; ++o) ReadString(&info, buffer);
+
+        for (int32 p = 0; p < PALETTE_BANK_COUNT; ++p) {
+            uint16 activeRows = ReadInt16(&info);
+            for (int32 r = 0; r < 0x10; ++r) {
+                if (activeRows >> r & 1)
+                    Seek_Cur(&info, 0x10 * 3);
+            }
+        }
+
+        uint8 sfxCount = ReadInt8(&info);
+        for (int32 i = 0; i < sfxCount; ++i) {
+            ReadString(&info, buffer);
+            ReadInt8(&info); // maxConcurrentPlays
+
+            // sized the same as LoadSfxToSlot's path, anything that doesn't fit there wouldn't match anyway
+            char fullFilePath[0x80];
+            if (sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/SoundFX/%s", buffer) < (int32)sizeof(fullFilePath) && QueuePrefetchFile(fullFilePath))
+                ++queued;
+        }
+    }
+
+    CloseFile(&info);
+
+    if (queued)
+        StartPrefetchWorker();
+}
+
+void RSDK::PrefetchScene(uint16 listPos)
+{
+    if (!sceneInfo.listData || !sceneInfo.categoryCount)
+        return;
+
+    // categories added through mods treat sceneOffsetEnd as exclusive while the rest don't, so go off the count instead
+    SceneListInfo *lastCategory = &sceneInfo.listCategory[sceneInfo.categoryCount - 1];
+    if (listPos >= lastCategory->sceneOffsetStart + lastCategory->sceneCount)
+        return;
+
+    ReleaseScenePrefetch();
+
+    SceneListEntry *entry = &sceneInfo.listData[listPos];
+    bool32 loadFolder     = strcmp(currentSceneFolder, entry->folder) != 0;
+
+    // built exactly how LoadSceneFolder & LoadSceneAssets build them, since that's what they'll be looked up by
+    char fullFilePath[SCENE_FILEPATH_SIZE];
+    if (loadFolder) {
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/TileConfig.bin", entry->folder);
+        QueuePrefetchFile(fullFilePath);
+
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/StageConfig.bin", entry->folder);
+        if (QueuePrefetchFile(fullFilePath))
+            strcpy(s_prefetchStageConfig, fullFilePath);
+
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/16x16Tiles.gif", entry->folder);
+        QueuePrefetchFile(fullFilePath);
+    }
+
+    sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/Scene%s.bin", entry->folder, entry->id);
+    QueuePrefetchFile(fullFilePath);
+
+    PrintLog(PRINT_NORMAL, "Prefetching Scene \"%s\" (%s)", entry->name, entry->folder);
+
+    s_prefetchListPos = listPos;
+    StartPrefetchWorker();
+}
+
+void RSDK::UpdateScenePrefetch()
+{
+    // games usually set listPos to the next scene well before they call LoadScene (act results, etc)
+    // if the load has already been requested there's no time left to gain
+    if (sceneInfo.state == ENGINESTATE_REGULAR && sceneInfo.listPos != s_loadedListPos && sceneInfo.listPos != s_prefetchListPos)
+        PrefetchScene(sceneInfo.listPos);
+
+    // the sfx names come from StageConfig, so they can only be queued once the worker's read it
+    if (s_prefetchStageConfig[0] && s_prefetchDone) {
+        s_prefetchThread.join();
+
+        QueueStageSfxPrefetch();
+        s_prefetchStageConfig[0] = 0;
+    }
+}
+
+void RSDK::ReleaseScenePrefetch()
+{
+    if (s_prefetchThread.joinable()) {
+        s_prefetchCancel = true;
+        s_prefetchThread.join();
+    }
+
+    ClearPrefetchedFiles();
+    s_prefetchListPos        = -1;
+    s_prefetchStageConfig[0] = 0;
+}
+#endif
+
 // Preserve streaming BGM (e.g., GHZ2 music) across scene loads to match original game behavior.
 // Set to false if you want the previous decomp behavior.
 static bool s_preserveStreamDuringSceneLoad = true;
 
 void RSDK::LoadSceneFolder()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    // a prefetch for some other scene is just going to compete with us for IO
+    if (s_prefetchListPos != sceneInfo.listPos)
+        ReleaseScenePrefetch();
+
+    // the dev menu can load a scene in the middle of a video
+    ReleaseVideo();
+#endif
 
 #if RETRO_USE_MOD_LOADER
     // run this before the game actually unloads all the objects & scene assets
@@ -196,7 +350,7 @@ void RSDK::LoadSceneFolder()
     PrintLog(PRINT_NORMAL, "Loading Scene \"%s - %s\"", list->name, sceneEntry->name);
 #endif
 
-    char fullFilePath[0x40];
+    char fullFilePath[SCENE_FILEPATH_SIZE];
 
     // Load TileConfig
     sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/TileConfig.bin", currentSceneFolder);
@@ -244,6 +398,10 @@ void RSDK::LoadSceneFolder()
             }
         }
 
+#if !RETRO_USE_ORIGINAL_CODE
+        ClearNameMap(&objectNameMap);
+#endif
+
         for (int32 o = 0; o < sceneInfo.classCount; ++o) {
             ObjectClass *objClass = &objectClassList[stageObjectIDs[o]];
             if (objClass->staticVars && !*objClass->staticVars) {
@@ -329,7 +487,7 @@ void RSDK::LoadSceneAssets()
     memset(objectEntityList, 0, ENTITY_COUNT * sizeof(EntityBase));
 
     SceneListEntry *sceneEntry = &sceneInfo.listData[sceneInfo.listPos];
-    char fullFilePath[0x40];
+    char fullFilePath[SCENE_FILEPATH_SIZE];
     sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/Scene%s.bin", currentSceneFolder, sceneEntry->id);
 
     dataStorage[DATASET_TMP].usedStorage = 0;
@@ -339,6 +497,12 @@ void RSDK::LoadSceneAssets()
     if (screens[0].size.y > 0)
         memset(gfxLineBuffer, 0, screens[0].size.y * sizeof(uint8));
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // the layouts are about to be replaced, & any recorded movement was against the old ones
+    ReleaseCollisionField();
+    ClearCollisionBench();
+#endif
+
     memset(tileLayers, 0, LAYER_COUNT * sizeof(TileLayer));
 
     // Reload palette
@@ -352,6 +516,10 @@ void RSDK::LoadSceneAssets()
                 for (int32 c = 0; c < 0x10; ++c) fullPalette[b][(r << 4) + c] = stagePalette[b][(r << 4) + c];
             }
         }
+
+#if !RETRO_USE_ORIGINAL_CODE
+        MarkPaletteDirty(b);
+#endif
     }
 
     FileInfo info;
@@ -755,6 +923,12 @@ void RSDK::LoadSceneAssets()
 #if RETRO_USE_MOD_LOADER
     LoadGameXML(true); // override the stage palette *somewhere* idfk
 #endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    // everything that was staged has been committed by now
+    ReleaseScenePrefetch();
+    s_loadedListPos = sceneInfo.listPos;
+#endif
 }
 void RSDK::LoadTileConfig(char *filepath)
 {
@@ -1016,6 +1190,10 @@ void RSDK::LoadStageGIF(char *filepath)
             }
         }
 
+#if !RETRO_USE_ORIGINAL_CODE
+        MarkPaletteDirty(0);
+#endif
+
         // Flip X
         uint8 *srcPixels = tilesetPixels;
         uint8 *dstPixels = &tilesetPixels[(FLIP_X * TILESET_SIZE) + (TILE_SIZE - 1)];
@@ -1051,6 +1229,10 @@ void RSDK::LoadStageGIF(char *filepath)
             dstPixels += (TILE_SIZE * 2);
         }
 
+#if !RETRO_USE_ORIGINAL_CODE
+        UpdateTileOpacity(0, TILE_COUNT);
+#endif
+
 #if RETRO_USE_ORIGINAL_CODE
         tileset.palette = NULL;
         tileset.decoder = NULL;
@@ -1059,6 +1241,50 @@ void RSDK::LoadStageGIF(char *filepath)
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::UpdateTileOpacity(uint16 startTile, uint16 count)
+{
+    if (startTile >= TILE_COUNT)
+        return;
+
+    if (count > TILE_COUNT - startTile)
+        count = TILE_COUNT - startTile;
+
+    for (int32 f = 0; f < 4; ++f) {
+        for (int32 t = startTile; t < startTile + count; ++t) {
+            int32 tile    = t + (f * TILE_COUNT);
+            uint8 *pixels = &tilesetPixels[tile * TILE_DATASIZE];
+
+            int32 emptyRows  = 0;
+            int32 opaqueRows = 0;
+            for (int32 y = 0; y < TILE_SIZE; ++y) {
+                int32 opaqueCount = 0;
+                for (int32 x = 0; x < TILE_SIZE; ++x) opaqueCount += *pixels++ != 0;
+
+                if (!opaqueCount) {
+                    tileRowOpacity[tile][y] = TILEOPACITY_EMPTY;
+                    emptyRows++;
+                }
+                else if (opaqueCount == TILE_SIZE) {
+                    tileRowOpacity[tile][y] = TILEOPACITY_OPAQUE;
+                    opaqueRows++;
+                }
+                else {
+                    tileRowOpacity[tile][y] = TILEOPACITY_MIXED;
+                }
+            }
+
+            if (emptyRows == TILE_SIZE)
+                tileOpacity[tile] = TILEOPACITY_EMPTY;
+            else if (opaqueRows == TILE_SIZE)
+                tileOpacity[tile] = TILEOPACITY_OPAQUE;
+            else
+                tileOpacity[tile] = TILEOPACITY_MIXED;
+        }
+    }
+}
+#endif
+
 void RSDK::ProcessParallaxAutoScroll()
 {
     for (int32 l = 0; l < LAYER_COUNT; ++l) {
@@ -1071,6 +1297,101 @@ void RSDK::ProcessParallaxAutoScroll()
         }
     }
 }
+#if !RETRO_USE_ORIGINAL_CODE
+// HScroll & basic layers tend to produce the exact same scanlines frame after frame (any layer that isn't scrolling, or isn't moving
+// because the camera isn't), so the last lines each layer filled for each screen are kept, along with everything they were built from,
+// & just copied back if none of that changed. lineScroll & the deformation data are written to directly by objects, so the parts of
+// them the lines used are kept & compared too
+struct ParallaxLineCache {
+    bool32 valid;
+    uint64 scrollHash; // every scrollInfo's tilePos & deform
+    int32 scrollPos;
+    int32 pixelHeight;
+    int32 lineCount;
+    int32 waterDrawPos;
+    bool32 deformed;
+    uint8 *lineScroll;
+    uint8 lineScrollIDs[SCREEN_YSIZE];
+    int32 deformation[SCREEN_YSIZE];
+    ScanlineInfo scanlines[SCREEN_YSIZE];
+};
+
+static ParallaxLineCache parallaxLineCache[LAYER_COUNT][SCREEN_COUNT];
+
+// returns true if the layer's lines for currentScreen were restored from the cache,
+// otherwise sets entry to where they should be saved to once they've been filled (or NULL if they can't be cached)
+static bool32 RestoreParallaxLines(TileLayer *layer, uint64 scrollHash, int32 scrollPos, int32 pixelHeight, bool32 deformed,
+                                   ParallaxLineCache **entry)
+{
+    *entry = NULL;
+
+    int32 layerID      = (int32)(layer - tileLayers);
+    int32 screenID     = (int32)(currentScreen - screens);
+    int32 lineCount    = currentScreen->size.y;
+    int32 waterDrawPos = currentScreen->waterDrawPos;
+    if (layerID < 0 || layerID >= LAYER_COUNT || screenID < 0 || screenID >= SCREEN_COUNT)
+        return false;
+
+    // only bother with the usual case of lineScroll wrapping around once at most
+    if (lineCount > SCREEN_YSIZE || lineCount > pixelHeight || waterDrawPos < 0 || waterDrawPos > lineCount)
+        return false;
+
+    ParallaxLineCache *cache = &parallaxLineCache[layerID][screenID];
+
+    int32 firstCount = MIN(lineCount, pixelHeight - scrollPos);
+    uint8 *lineScroll = layer->lineScroll;
+
+    int32 *deformation  = NULL;
+    int32 *deformationW = NULL;
+    if (deformed) {
+        int32 waterScrollPos = scrollPos + waterDrawPos;
+        if (waterScrollPos >= pixelHeight)
+            waterScrollPos -= pixelHeight;
+
+        deformation  = &layer->deformationData[(scrollPos + (uint16)layer->deformationOffset) & 0x1FF];
+        deformationW = &layer->deformationDataW[(waterScrollPos + (uint16)layer->deformationOffsetW) & 0x1FF];
+    }
+
+    if (cache->valid && cache->scrollHash == scrollHash && cache->scrollPos == scrollPos && cache->pixelHeight == pixelHeight
+        && cache->lineCount == lineCount && cache->waterDrawPos == waterDrawPos && cache->deformed == deformed && cache->lineScroll == lineScroll
+        && !memcmp(cache->lineScrollIDs, &lineScroll[scrollPos], firstCount)
+        && !memcmp(&cache->lineScrollIDs[firstCount], lineScroll, lineCount - firstCount)) {
+        if (!deformed
+            || (!memcmp(cache->deformation, deformation, waterDrawPos * sizeof(int32))
+                && !memcmp(&cache->deformation[waterDrawPos], deformationW, (lineCount - waterDrawPos) * sizeof(int32)))) {
+            memcpy(scanlines, cache->scanlines, lineCount * sizeof(ScanlineInfo));
+            return true;
+        }
+    }
+
+    cache->valid        = false;
+    cache->scrollHash   = scrollHash;
+    cache->scrollPos    = scrollPos;
+    cache->pixelHeight  = pixelHeight;
+    cache->lineCount    = lineCount;
+    cache->waterDrawPos = waterDrawPos;
+    cache->deformed     = deformed;
+    cache->lineScroll   = lineScroll;
+    memcpy(cache->lineScrollIDs, &lineScroll[scrollPos], firstCount);
+    memcpy(&cache->lineScrollIDs[firstCount], lineScroll, lineCount - firstCount);
+    if (deformed) {
+        memcpy(cache->deformation, deformation, waterDrawPos * sizeof(int32));
+        memcpy(&cache->deformation[waterDrawPos], deformationW, (lineCount - waterDrawPos) * sizeof(int32));
+    }
+
+    *entry = cache;
+    return false;
+}
+
+static void SaveParallaxLines(ParallaxLineCache *entry)
+{
+    if (entry) {
+        memcpy(entry->scanlines, scanlines, entry->lineCount * sizeof(ScanlineInfo));
+        entry->valid = true;
+    }
+}
+#endif
+
 void RSDK::ProcessParallax(TileLayer *layer)
 {
     if (!layer->xsize || !layer->ysize)
@@ -1085,6 +1406,10 @@ void RSDK::ProcessParallax(TileLayer *layer)
         default: break;
 
         case LAYER_HSCROLL: {
+#if !RETRO_USE_ORIGINAL_CODE
+            uint64 scrollHash = HASH_INIT_FNV64;
+            bool32 deformed   = false;
+#endif
             for (int32 i = 0; i < layer->scrollInfoCount; ++i) {
                 scrollInfo->tilePos = scrollInfo->scrollPos + (currentScreen->position.x * scrollInfo->parallaxFactor << 8);
 
@@ -1093,6 +1418,11 @@ void RSDK::ProcessParallax(TileLayer *layer)
                     tilePos += pixelWidth;
                 scrollInfo->tilePos = TO_FIXED(tilePos);
 
+#if !RETRO_USE_ORIGINAL_CODE
+                scrollHash = HashStepFNV64(scrollHash, (uint32)(scrollInfo->tilePos | scrollInfo->deform));
+                deformed |= scrollInfo->deform;
+#endif
+
                 ++scrollInfo;
             }
 
@@ -1101,6 +1431,12 @@ void RSDK::ProcessParallax(TileLayer *layer)
             if (scrollPos < 0)
                 scrollPos += pixelHeight;
 
+#if !RETRO_USE_ORIGINAL_CODE
+            ParallaxLineCache *cacheEntry = NULL;
+            if (RestoreParallaxLines(layer, scrollHash, scrollPos, pixelHeight, deformed, &cacheEntry))
+                break;
+#endif
+
             uint8 *lineScrollPtr = &layer->lineScroll[scrollPos];
 
             // Above water
@@ -1142,6 +1478,10 @@ void RSDK::ProcessParallax(TileLayer *layer)
                 }
                 scanline++;
             }
+
+#if !RETRO_USE_ORIGINAL_CODE
+            SaveParallaxLines(cacheEntry);
+#endif
             break;
         }
 
@@ -1201,6 +1541,9 @@ void RSDK::ProcessParallax(TileLayer *layer)
         }
 
         case LAYER_BASIC: {
+#if !RETRO_USE_ORIGINAL_CODE
+            uint64 scrollHash = HASH_INIT_FNV64;
+#endif
             for (int32 i = 0; i < layer->scrollInfoCount; ++i) {
                 scrollInfo->tilePos = scrollInfo->scrollPos + (currentScreen->position.x * scrollInfo->parallaxFactor << 8);
 
@@ -1209,6 +1552,10 @@ void RSDK::ProcessParallax(TileLayer *layer)
                     tilePos += pixelWidth;
                 scrollInfo->tilePos = TO_FIXED(tilePos);
 
+#if !RETRO_USE_ORIGINAL_CODE
+                scrollHash = HashStepFNV64(scrollHash, (uint32)scrollInfo->tilePos);
+#endif
+
                 ++scrollInfo;
             }
 
@@ -1217,6 +1564,13 @@ void RSDK::ProcessParallax(TileLayer *layer)
             if (scrollPos < 0)
                 scrollPos += pixelHeight;
 
+#if !RETRO_USE_ORIGINAL_CODE
+            // basic layers never deform, so they can share the same checks as HScroll ones
+            ParallaxLineCache *cacheEntry = NULL;
+            if (RestoreParallaxLines(layer, scrollHash, scrollPos, pixelHeight, false, &cacheEntry))
+                break;
+#endif
+
             uint8 *lineScrollPtr = &layer->lineScroll[scrollPos];
 
             // Above water
@@ -1249,6 +1603,10 @@ void RSDK::ProcessParallax(TileLayer *layer)
 
                 scanline++;
             }
+
+#if !RETRO_USE_ORIGINAL_CODE
+            SaveParallaxLines(cacheEntry);
+#endif
             break;
         }
     }
@@ -1320,10 +1678,17 @@ void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, ui
                 if (srcStartY + countY > srcLayer->ysize)
                     countY = srcLayer->ysize - srcStartY;
 
+#if !RETRO_USE_ORIGINAL_CODE
+                FlushDrawCommands();
+#endif
+
                 for (int32 y = 0; y < countY; ++y) {
                     for (int32 x = 0; x < countX; ++x) {
                         uint16 tile = srcLayer->layout[(x + srcStartX) + ((y + srcStartY) << srcLayer->widthShift)];
                         dstLayer->layout[(x + dstStartX) + ((y + dstStartY) << dstLayer->widthShift)] = tile;
+#if !RETRO_USE_ORIGINAL_CODE
+                        UpdateCollisionField(dstLayerID, x + dstStartX, y + dstStartY);
+#endif
                     }
                 }
             }
@@ -1336,12 +1701,20 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
     if (!layer->xsize || !layer->ysize)
         return;
 
-    int32 lineTileCount    = (currentScreen->pitch >> 4) - 1;
-    uint8 *lineBuffer      = &gfxLineBuffer[currentScreen->clipBound_Y1];
-    ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_Y1];
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->pitch * currentScreen->clipBound_Y1];
+#if !RETRO_USE_ORIGINAL_CODE
+    if (DeferLayerDraw(layer))
+        return;
+#endif
+
+    DrawLayerHScrollLines(layer, &scanlines[currentScreen->clipBound_Y1], currentScreen->clipBound_Y1, currentScreen->clipBound_Y2);
+}
+void RSDK::DrawLayerHScrollLines(TileLayer *layer, ScanlineInfo *scanline, int32 startY, int32 endY)
+{
+    int32 lineTileCount = (currentScreen->pitch >> 4) - 1;
+    uint8 *lineBuffer   = &gfxLineBuffer[startY];
+    uint16 *frameBuffer = &currentScreen->frameBuffer[currentScreen->pitch * startY];
 
-    for (int32 cy = currentScreen->clipBound_Y1; cy < currentScreen->clipBound_Y2; ++cy) {
+    for (int32 cy = startY; cy < endY; ++cy) {
         int32 x               = scanline->position.x;
         int32 y               = scanline->position.y;
         int32 tileX           = FROM_FIXED(x);
@@ -1382,7 +1755,12 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
                 layout -= layer->xsize;
             }
 
+#if !RETRO_USE_ORIGINAL_CODE
+            // only empty rows are worth skipping here, drawing opaque ones without the checks below wasn't any faster (selftest=layers)
+            if (*layout < 0xFFFF && tileRowOpacity[*layout & 0xFFF][sheetY / TILE_SIZE] != TILEOPACITY_EMPTY) {
+#else
             if (*layout < 0xFFFF) {
+#endif
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
 
                 uint8 index = *pixels;
@@ -1488,6 +1866,10 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
     if (!layer->xsize || !layer->ysize)
         return;
 
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     int32 lineTileCount    = (currentScreen->size.y >> 4) - 1;
     uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->clipBound_X1];
     ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_X1];
@@ -1533,9 +1915,27 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
                 layout -= layer->ysize << layer->widthShift;
             }
 
+#if !RETRO_USE_ORIGINAL_CODE
+            // there's nothing tracking columns, so only whole tiles can be skipped or drawn without checks here
+            uint8 opacity = *layout < 0xFFFF ? tileOpacity[*layout & 0xFFF] : (uint8)TILEOPACITY_EMPTY;
+
+            if (opacity == TILEOPACITY_EMPTY) {
+                frameBuffer += TILE_SIZE * currentScreen->pitch;
+            }
+            else if (opacity == TILEOPACITY_OPAQUE) {
+                uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetX];
+                for (int32 y = 0; y < TILE_SIZE; ++y) {
+                    *frameBuffer = activePalette[*pixels];
+
+                    pixels += TILE_SIZE;
+                    frameBuffer += currentScreen->pitch;
+                }
+            }
+#else
             if (*layout >= 0xFFFF) {
                 frameBuffer += TILE_SIZE * currentScreen->pitch;
             }
+#endif
             else {
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetX];
 
@@ -1630,16 +2030,25 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
     if (!layer->xsize || !layer->ysize)
         return;
 
-    uint16 *layout         = layer->layout;
-    uint8 *lineBuffer      = &gfxLineBuffer[currentScreen->clipBound_Y1];
-    ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_Y1];
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->clipBound_X1 + currentScreen->clipBound_Y1 * currentScreen->pitch];
+#if !RETRO_USE_ORIGINAL_CODE
+    if (DeferLayerDraw(layer))
+        return;
+#endif
+
+    DrawLayerRotozoomLines(layer, &scanlines[currentScreen->clipBound_Y1], currentScreen->clipBound_Y1, currentScreen->clipBound_Y2,
+                           currentScreen->clipBound_X1, currentScreen->clipBound_X2);
+}
+void RSDK::DrawLayerRotozoomLines(TileLayer *layer, ScanlineInfo *scanline, int32 startY, int32 endY, int32 clipX1, int32 clipX2)
+{
+    uint16 *layout      = layer->layout;
+    uint8 *lineBuffer   = &gfxLineBuffer[startY];
+    uint16 *frameBuffer = &currentScreen->frameBuffer[clipX1 + startY * currentScreen->pitch];
 
     int32 width    = (TILE_SIZE << layer->widthShift) - 1;
     int32 height   = (TILE_SIZE << layer->heightShift) - 1;
-    int32 lineSize = currentScreen->clipBound_X2 - currentScreen->clipBound_X1;
+    int32 lineSize = clipX2 - clipX1;
 
-    for (int32 cy = currentScreen->clipBound_Y1; cy < currentScreen->clipBound_Y2; ++cy) {
+    for (int32 cy = startY; cy < endY; ++cy) {
         int32 posX = scanline->position.x;
         int32 posY = scanline->position.y;
 
@@ -1647,6 +2056,61 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
         ++lineBuffer;
         int32 fbOffset = currentScreen->pitch - lineSize;
 
+#if !RETRO_USE_ORIGINAL_CODE
+        // no rotation on this line, so it stays on a single row of tiles & every tile it crosses can be drawn as one span,
+        // rather than looking the tile up again for every pixel
+        // (not worth it once it's shrunk enough that spans are only a pixel or two long though)
+        if (!scanline->deform.y && abs(scanline->deform.x) < TO_FIXED(ROTOZOOM_SPAN_MAX_STEP)) {
+            int32 deformX     = scanline->deform.x;
+            int32 y           = FROM_FIXED(posY) & 0xF;
+            uint16 *layoutRow = &layout[((height >> 4) & (posY >> 20)) << layer->widthShift];
+
+            for (int32 cx = 0; cx < lineSize;) {
+                // how many pixels until the next tile, going by how far into this one it is (in 16.16 & tiles being 16 pixels)
+                int32 spanSize = lineSize - cx;
+                int32 tilePos  = posX & 0xFFFFF;
+                if (deformX > 0)
+                    spanSize = MIN(spanSize, (0x100000 - tilePos + deformX - 1) / deformX);
+                else if (deformX < 0)
+                    spanSize = MIN(spanSize, tilePos / -deformX + 1);
+
+                uint16 tile   = layoutRow[(width >> 4) & (posX >> 20)] & 0xFFF;
+                uint8 *pixels = &tilesetPixels[TILE_SIZE * (y + TILE_SIZE * tile)];
+
+                switch (tileRowOpacity[tile][y]) {
+                    case TILEOPACITY_EMPTY:
+                        posX += deformX * spanSize;
+                        frameBuffer += spanSize;
+                        break;
+
+                    case TILEOPACITY_OPAQUE:
+                        for (int32 i = 0; i < spanSize; ++i) {
+                            *frameBuffer++ = activePalette[pixels[FROM_FIXED(posX) & 0xF]];
+                            posX += deformX;
+                        }
+                        break;
+
+                    default:
+                        for (int32 i = 0; i < spanSize; ++i) {
+                            uint8 idx = pixels[FROM_FIXED(posX) & 0xF];
+                            if (idx)
+                                *frameBuffer = activePalette[idx];
+
+                            posX += deformX;
+                            ++frameBuffer;
+                        }
+                        break;
+                }
+
+                cx += spanSize;
+            }
+
+            frameBuffer += fbOffset;
+            ++scanline;
+            continue;
+        }
+#endif
+
         for (int32 cx = 0; cx < lineSize; ++cx) {
             int32 tx = posX >> 20;
             int32 ty = posY >> 20;
@@ -1673,6 +2137,10 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
     if (!layer->xsize || !layer->ysize)
         return;
 
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     if (currentScreen->clipBound_X1 >= currentScreen->clipBound_X2 || currentScreen->clipBound_Y1 >= currentScreen->clipBound_Y2)
         return;
 
@@ -1722,9 +2190,28 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
             }
 
             for (int32 x = 0; x < lineSize; ++x) {
+#if !RETRO_USE_ORIGINAL_CODE
+                uint8 opacity = *layout != 0xFFFF ? tileOpacity[*layout & 0xFFF] : (uint8)TILEOPACITY_EMPTY;
+
+                if (opacity == TILEOPACITY_EMPTY) {
+                    frameBuffer += TILE_SIZE;
+                }
+                else if (opacity == TILEOPACITY_OPAQUE) {
+                    uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + TILE_SIZE * sheetY];
+                    for (int32 y = 0; y < tileRemainY; ++y) {
+                        for (int32 px = 0; px < TILE_SIZE; ++px) frameBuffer[px] = activePalette[pixels[px]];
+
+                        frameBuffer += currentScreen->pitch;
+                        pixels += TILE_SIZE;
+                    }
+
+                    frameBuffer += TILE_SIZE - currentScreen->pitch * tileRemainY;
+                }
+#else
                 if (*layout == 0xFFFF) {
                     frameBuffer += TILE_SIZE;
                 }
+#endif
                 else {
                     uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + TILE_SIZE * sheetY];
                     for (int32 y = 0; y < tileRemainY; ++y) {
@@ -1869,9 +2356,30 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
 
             // Draw the bulk of the tiles on this line
             for (int32 x = 0; x < lineSize; ++x) {
+#if !RETRO_USE_ORIGINAL_CODE
+                uint8 opacity = *layout != 0xFFFF ? tileOpacity[*layout & 0xFFF] : (uint8)TILEOPACITY_EMPTY;
+
+                if (opacity == TILEOPACITY_EMPTY) {
+                    frameBuffer += TILE_SIZE;
+                }
+                else if (opacity == TILEOPACITY_OPAQUE) {
+                    uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF)];
+
+                    for (int32 y = 0; y < TILE_SIZE; ++y) {
+                        for (int32 px = 0; px < TILE_SIZE; ++px) frameBuffer[px] = activePalette[pixels[px]];
+
+                        pixels += TILE_SIZE;
+                        frameBuffer += currentScreen->pitch;
+                    }
+
+                    frameBuffer -= TILE_SIZE * currentScreen->pitch;
+                    frameBuffer += TILE_SIZE;
+                }
+#else
                 if (*layout == 0xFFFF) {
                     frameBuffer += TILE_SIZE;
                 }
+#endif
                 else {
                     uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF)];
 
@@ -11,6 +11,9 @@ namespace RSDK
 
 #define CPATH_COUNT (2)
 
+// the buffer scene files are built & looked up in, anything prefetching them has to build them the same way
+#define SCENE_FILEPATH_SIZE (0x40)
+
 #define RSDK_SIGNATURE_CFG (0x474643) // "CFG"
 #define RSDK_SIGNATURE_SCN (0x4E4353) // "SCN"
 #define RSDK_SIGNATURE_TIL (0x4C4954) // "TIL"
@@ -40,6 +43,14 @@ struct SceneListEntry {
 #endif
 };
 
+#if !RETRO_USE_ORIGINAL_CODE
+enum TileOpacityTypes {
+    TILEOPACITY_EMPTY,
+    TILEOPACITY_OPAQUE,
+    TILEOPACITY_MIXED,
+};
+#endif
+
 enum CollisionModes {
     CMODE_FLOOR,
     CMODE_LWALL,
@@ -165,11 +176,27 @@ extern SceneInfo sceneInfo;
 
 extern uint8 tilesetPixels[TILESET_SIZE * 4];
 
+#if !RETRO_USE_ORIGINAL_CODE
+// whether each row of each tile in tilesetPixels (flipped copies included) is empty, opaque or a mix of both, along with the tile as a whole
+// lets the layer renderers skip empty rows & draw opaque ones without checking every pixel
+extern uint8 tileRowOpacity[TILE_COUNT * 4][TILE_SIZE];
+extern uint8 tileOpacity[TILE_COUNT * 4];
+
+// has to be called whenever tiles in tilesetPixels change
+void UpdateTileOpacity(uint16 startTile, uint16 count);
+#endif
+
 void LoadSceneFolder();
 void LoadSceneAssets();
 void LoadTileConfig(char *filepath);
 void LoadStageGIF(char *filepath);
 
+#if !RETRO_USE_ORIGINAL_CODE
+void PrefetchScene(uint16 listPos);
+void UpdateScenePrefetch();
+void ReleaseScenePrefetch();
+#endif
+
 void ProcessParallaxAutoScroll();
 void ProcessParallax(TileLayer *layer);
 void ProcessSceneTimer();
@@ -240,12 +267,24 @@ inline uint16 GetTile(uint16 layerID, int32 tileX, int32 tileY)
     return (uint16)-1;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// defined in Collision.cpp
+void UpdateCollisionField(uint16 layerID, int32 tileX, int32 tileY);
+#endif
+
 inline void SetTile(uint16 layerID, int32 tileX, int32 tileY, uint16 tile)
 {
     if (layerID < LAYER_COUNT) {
         TileLayer *layer = &tileLayers[layerID];
-        if (tileX >= 0 && tileX < layer->xsize && tileY >= 0 && tileY < layer->ysize)
+        if (tileX >= 0 && tileX < layer->xsize && tileY >= 0 && tileY < layer->ysize) {
+#if !RETRO_USE_ORIGINAL_CODE
+            FlushDrawCommands();
+#endif
             layer->layout[tileX + (tileY << layer->widthShift)] = tile;
+#if !RETRO_USE_ORIGINAL_CODE
+            UpdateCollisionField(layerID, tileX, tileY);
+#endif
+        }
     }
 }
 
@@ -287,6 +326,10 @@ inline void CopyTile(uint16 dest, uint16 src, uint16 count)
     if (count > TILE_COUNT)
         count = TILE_COUNT - 1;
 
+#if !RETRO_USE_ORIGINAL_CODE
+    FlushDrawCommands();
+#endif
+
     uint8 *destPixels = &tilesetPixels[TILE_DATASIZE * dest];
     uint8 *srcPixels  = &tilesetPixels[TILE_DATASIZE * src];
 
@@ -307,6 +350,10 @@ inline void CopyTile(uint16 dest, uint16 src, uint16 count)
             *destPixelsXY++ = *srcPixelsXY++;
         }
     }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    UpdateTileOpacity(dest, count);
+#endif
 }
 
 inline ScanlineInfo *GetScanlines() { return scanlines; }
@@ -320,6 +367,11 @@ void DrawLayerRotozoom(TileLayer *layer);
 // Draw a "basic" layer, no special capabilities, but it's the fastest to draw
 void DrawLayerBasic(TileLayer *layer);
 
+// the parts of DrawLayerHScroll & DrawLayerRotozoom that draw each line, for rows startY to endY of currentScreen
+// scanline is the entry for startY, so deferred draws can pass in their own copy of the scanlines
+void DrawLayerHScrollLines(TileLayer *layer, ScanlineInfo *scanline, int32 startY, int32 endY);
+void DrawLayerRotozoomLines(TileLayer *layer, ScanlineInfo *scanline, int32 startY, int32 endY, int32 clipX1, int32 clipX2);
+
 #if RETRO_REV0U
 #include "Legacy/SceneLegacy.hpp"
 #endif
@@ -0,0 +1,371 @@
+#include "RSDK/Core/RetroEngine.hpp"
+
+#include <chrono>
+
+using namespace RSDK;
+
+#if !RETRO_USE_ORIGINAL_CODE
+SnapshotInfo RSDK::snapshots;
+
+static uint8 snapshotZeroBlock[SNAPSHOT_BLOCK_SIZE];
+
+// kept around between restores so they don't have to live on the stack
+static uint32 **keptDataEntries[STORAGE_ENTRY_COUNT];
+static uint32 *keptStorageEntries[STORAGE_ENTRY_COUNT];
+
+static inline uint32 GetSnapshotTimestamp()
+{
+    return (uint32)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void AddSnapshotRegion(void *data, uint32 size)
+{
+    SnapshotRegion *region = &snapshots.regions[snapshots.regionCount++];
+    region->data           = (uint8 *)data;
+    region->size           = size;
+    region->offset         = snapshots.fixedSize;
+
+    snapshots.fixedSize += (size + SNAPSHOT_BLOCK_SIZE - 1) & -SNAPSHOT_BLOCK_SIZE;
+}
+
+static void SetupSnapshotRegions()
+{
+    if (snapshots.regionCount)
+        return;
+
+    AddSnapshotRegion(objectEntityList, sizeof(objectEntityList));
+    AddSnapshotRegion(typeGroups, sizeof(typeGroups));
+    AddSnapshotRegion(drawGroups, sizeof(drawGroups));
+    AddSnapshotRegion(&sceneInfo, sizeof(sceneInfo));
+    AddSnapshotRegion(&tempEntityInfo, sizeof(tempEntityInfo)); // so CreateEntity hands out the same slots after a rollback
+    AddSnapshotRegion(tileLayers, sizeof(tileLayers));
+    AddSnapshotRegion(cameras, sizeof(cameras));
+    AddSnapshotRegion(&cameraCount, sizeof(cameraCount));
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) AddSnapshotRegion(&screens[s].position, sizeof(screens[s].position));
+
+    AddSnapshotRegion(globalPalette, sizeof(globalPalette));
+    AddSnapshotRegion(activeGlobalRows, sizeof(activeGlobalRows));
+    AddSnapshotRegion(activeStageRows, sizeof(activeStageRows));
+    AddSnapshotRegion(stagePalette, sizeof(stagePalette));
+    AddSnapshotRegion(fullPalette, sizeof(fullPalette));
+    AddSnapshotRegion(gfxLineBuffer, sizeof(gfxLineBuffer));
+    AddSnapshotRegion(&maskColor, sizeof(maskColor));
+
+    AddSnapshotRegion(&randSeed, sizeof(randSeed));
+
+    // the bookkeeping for STG, the pool itself goes at the end of the image since its size changes
+    AddSnapshotRegion(&dataStorage[DATASET_STG], sizeof(DataStorage));
+}
+
+static bool32 ReserveSnapshotImage(uint32 stgSize)
+{
+    uint32 size = snapshots.fixedSize + stgSize;
+    if (size <= snapshots.imageSize)
+        return true;
+
+    // grow in 1MB steps, STG tends to grow a little at a time
+    size         = (size + 0xFFFFF) & ~0xFFFFF;
+    uint8 *image = (uint8 *)realloc(snapshots.image, size);
+    if (!image)
+        return false;
+
+    // anything past the end of the STG pool is kept zeroed, so shrinking & growing it diffs like any other change
+    memset(image + snapshots.imageSize, 0, size - snapshots.imageSize);
+    snapshots.image     = image;
+    snapshots.imageSize = size;
+    return true;
+}
+
+// Drops the oldest snapshots (but never the latest, since that's what the image holds)
+static void DropOldestSnapshots(int32 dropCount)
+{
+    if (dropCount > snapshots.count - 1)
+        dropCount = snapshots.count - 1;
+
+    if (dropCount <= 0)
+        return;
+
+    // records are stored oldest first, so everything before the first kept record goes
+    uint32 dropSize = snapshots.records[dropCount].offset;
+    memmove(snapshots.arena, snapshots.arena + dropSize, snapshots.arenaUsed - dropSize);
+    snapshots.arenaUsed -= dropSize;
+
+    snapshots.count -= dropCount;
+    for (int32 i = 0; i < snapshots.count; ++i) {
+        snapshots.ids[i]     = snapshots.ids[i + dropCount];
+        snapshots.records[i] = snapshots.records[i + dropCount];
+        snapshots.records[i].offset -= dropSize;
+    }
+}
+
+// Copies any blocks that changed into the image, storing what they held before into the previous snapshot's record
+static void CaptureSnapshotBlocks(uint8 *live, uint32 liveSize, uint32 imageOffset, uint32 size, bool32 *recording)
+{
+    uint8 block[SNAPSHOT_BLOCK_SIZE];
+
+    for (uint32 pos = 0; pos < size; pos += SNAPSHOT_BLOCK_SIZE) {
+        uint32 len = MIN(SNAPSHOT_BLOCK_SIZE, size - pos);
+
+        const uint8 *src = live + pos;
+        if (pos >= liveSize) {
+            src = snapshotZeroBlock;
+        }
+        else if (pos + len > liveSize) {
+            memcpy(block, live + pos, liveSize - pos);
+            memset(block + liveSize - pos, 0, len - (liveSize - pos));
+            src = block;
+        }
+
+        uint8 *dst = snapshots.image + imageOffset + pos;
+        if (!memcmp(dst, src, len))
+            continue;
+
+        if (*recording) {
+            uint32 entrySize = 2 * sizeof(uint32) + len;
+
+            while (snapshots.arenaUsed + entrySize > SNAPSHOT_ARENA_SIZE) {
+                int32 olderCount = snapshots.count - 1;
+                if (olderCount <= 0) {
+                    // this capture changed more than the arena can hold on its own, so nothing older can be kept
+                    *recording = false;
+                    break;
+                }
+
+                // drop a bunch at once so a full arena doesn't end up shuffling memory on every capture
+                DropOldestSnapshots(olderCount > 4 ? olderCount / 4 : 1);
+            }
+
+            if (*recording) {
+                uint32 *header = (uint32 *)(snapshots.arena + snapshots.arenaUsed);
+                header[0]      = imageOffset + pos;
+                header[1]      = len;
+                memcpy(&header[2], dst, len);
+                snapshots.arenaUsed += entrySize;
+            }
+        }
+
+        memcpy(dst, src, len);
+    }
+}
+
+// Copies the image back over the live state
+static void WriteSnapshotImage()
+{
+    DataStorage *storage = &dataStorage[DATASET_STG];
+
+    // anything allocated after the snapshot stays allocated, there's no telling what might still be using it
+    uint32 liveUsed    = storage->usedStorage;
+    uint32 *snapEnd    = storage->memoryTable + snapshots.stgSize / sizeof(uint32);
+    uint32 keptEntries = 0;
+    for (uint32 e = 0; e < storage->entryCount; ++e) {
+        if (storage->dataEntries[e] && storage->storageEntries[e] >= snapEnd) {
+            keptDataEntries[keptEntries]    = storage->dataEntries[e];
+            keptStorageEntries[keptEntries] = storage->storageEntries[e];
+            ++keptEntries;
+        }
+    }
+
+    for (int32 r = 0; r < snapshots.regionCount; ++r) {
+        SnapshotRegion *region = &snapshots.regions[r];
+        memcpy(region->data, snapshots.image + region->offset, region->size);
+    }
+    memcpy(storage->memoryTable, snapshots.image + snapshots.fixedSize, snapshots.stgSize);
+
+    if (liveUsed > storage->usedStorage)
+        storage->usedStorage = liveUsed;
+
+    for (uint32 e = 0; e < keptEntries && storage->entryCount < STORAGE_ENTRY_COUNT; ++e) {
+        storage->dataEntries[storage->entryCount]    = keptDataEntries[e];
+        storage->storageEntries[storage->entryCount] = keptStorageEntries[e];
+        ++storage->entryCount;
+    }
+
+    // the layouts it was built from have just been rewound, it gets rebuilt from them the next time it's needed
+    ReleaseCollisionField();
+
+    // same goes for anything that was keeping track of what's in the palettes
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) MarkPaletteDirty(b);
+}
+
+int32 RSDK::CaptureSnapshot()
+{
+    DataStorage *storage = &dataStorage[DATASET_STG];
+    if (!storage->memoryTable)
+        return -1;
+
+    uint32 start = GetSnapshotTimestamp();
+
+    SetupSnapshotRegions();
+
+    if (snapshots.count && storage->clearCount != snapshots.clearCount)
+        ClearSnapshots();
+
+    if (!snapshots.arena) {
+        snapshots.arena = (uint8 *)malloc(SNAPSHOT_ARENA_SIZE);
+        if (!snapshots.arena)
+            return -1;
+    }
+
+    uint32 stgSize = storage->usedStorage * sizeof(uint32);
+    if (!ReserveSnapshotImage(stgSize))
+        return -1;
+
+    if (snapshots.count == SNAPSHOT_COUNT)
+        DropOldestSnapshots(SNAPSHOT_COUNT / 4);
+
+    // the current latest snapshot gets a record of everything that's about to change in the image
+    bool32 recording = snapshots.count > 0;
+    if (recording) {
+        SnapshotRecord *record = &snapshots.records[snapshots.count - 1];
+        record->offset         = snapshots.arenaUsed;
+        record->size           = 0;
+        record->stgSize        = snapshots.stgSize;
+    }
+
+    for (int32 r = 0; r < snapshots.regionCount; ++r) {
+        SnapshotRegion *region = &snapshots.regions[r];
+        CaptureSnapshotBlocks(region->data, region->size, region->offset, region->size, &recording);
+    }
+    CaptureSnapshotBlocks((uint8 *)storage->memoryTable, stgSize, snapshots.fixedSize, MAX(stgSize, snapshots.stgSize), &recording);
+
+    snapshots.lastDeltaSize = 0;
+    if (recording) {
+        SnapshotRecord *record  = &snapshots.records[snapshots.count - 1];
+        record->size            = snapshots.arenaUsed - record->offset;
+        snapshots.lastDeltaSize = record->size;
+    }
+    else {
+        snapshots.count     = 0;
+        snapshots.arenaUsed = 0;
+    }
+
+    int32 id                         = snapshots.nextID++;
+    snapshots.ids[snapshots.count++] = id;
+    snapshots.stgSize                = stgSize;
+    snapshots.clearCount             = storage->clearCount;
+
+    // the latest snapshot's record starts out empty, it only gets filled in by the next capture
+    snapshots.records[snapshots.count - 1].offset = snapshots.arenaUsed;
+    snapshots.records[snapshots.count - 1].size   = 0;
+
+    snapshots.captureTime = GetSnapshotTimestamp() - start;
+    return id;
+}
+
+bool32 RSDK::RestoreSnapshot(int32 id)
+{
+    int32 index = -1;
+    for (int32 i = 0; i < snapshots.count; ++i) {
+        if (snapshots.ids[i] == id) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index < 0)
+        return false;
+
+    if (dataStorage[DATASET_STG].clearCount != snapshots.clearCount) {
+        ClearSnapshots();
+        return false;
+    }
+
+    uint32 start = GetSnapshotTimestamp();
+
+    // rewind the image one snapshot at a time
+    for (int32 i = snapshots.count - 2; i >= index; --i) {
+        SnapshotRecord *record = &snapshots.records[i];
+
+        uint8 *entry = snapshots.arena + record->offset;
+        uint8 *end   = entry + record->size;
+        while (entry < end) {
+            uint32 *header = (uint32 *)entry;
+            memcpy(snapshots.image + header[0], &header[2], header[1]);
+            entry += 2 * sizeof(uint32) + header[1];
+        }
+
+        snapshots.stgSize = record->stgSize;
+    }
+
+    snapshots.arenaUsed           = snapshots.records[index].offset;
+    snapshots.records[index].size = 0;
+    snapshots.count               = index + 1;
+
+    WriteSnapshotImage();
+
+    snapshots.restoreTime = GetSnapshotTimestamp() - start;
+    return true;
+}
+
+int32 RSDK::GetSnapshotID(int32 age)
+{
+    if (age < 0 || age >= snapshots.count)
+        return -1;
+
+    return snapshots.ids[snapshots.count - 1 - age];
+}
+
+void RSDK::ClearSnapshots()
+{
+    snapshots.count     = 0;
+    snapshots.arenaUsed = 0;
+    snapshots.stgSize   = 0;
+
+    if (snapshots.image)
+        memset(snapshots.image, 0, snapshots.imageSize);
+}
+
+void RSDK::UpdateSnapshots()
+{
+    if (snapshots.everyFrame)
+        CaptureSnapshot();
+
+    if (snapshots.capture) {
+        snapshots.capture = false;
+
+        int32 id = CaptureSnapshot();
+        if (id >= 0)
+            PrintLog(PRINT_NORMAL, "[Snapshot] Captured #%d in %.3fms (%d bytes changed)", id, snapshots.captureTime / 1000.0f,
+                     snapshots.lastDeltaSize);
+    }
+
+    if (snapshots.restore) {
+        snapshots.restore = false;
+
+        int32 id = GetSnapshotID(0);
+        if (RestoreSnapshot(id))
+            PrintLog(PRINT_NORMAL, "[Snapshot] Restored #%d in %.3fms", id, snapshots.restoreTime / 1000.0f);
+        else
+            PrintLog(PRINT_NORMAL, "[Snapshot] Nothing to restore");
+    }
+
+    if (snapshots.rewind) {
+        snapshots.rewind = false;
+
+        // a second back, or as far as the snapshots go
+        int32 age = MIN(videoSettings.refreshRate ? videoSettings.refreshRate : 60, snapshots.count - 1);
+        int32 id  = GetSnapshotID(age);
+        if (RestoreSnapshot(id))
+            PrintLog(PRINT_NORMAL, "[Snapshot] Rewound %d snapshots to #%d in %.3fms (%d still stored, %dKB of deltas)", age, id,
+                     snapshots.restoreTime / 1000.0f, snapshots.count, snapshots.arenaUsed / 1024);
+        else
+            PrintLog(PRINT_NORMAL, "[Snapshot] Nothing to rewind to");
+    }
+}
+
+void RSDK::ReleaseSnapshots()
+{
+    if (snapshots.image)
+        free(snapshots.image);
+    snapshots.image     = NULL;
+    snapshots.imageSize = 0;
+
+    if (snapshots.arena)
+        free(snapshots.arena);
+    snapshots.arena = NULL;
+
+    snapshots.count     = 0;
+    snapshots.arenaUsed = 0;
+    snapshots.stgSize   = 0;
+}
+#endif
@@ -0,0 +1,82 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+namespace RSDK
+{
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Captures the scene's mutable simulation state so it can be rolled back to without reloading anything:
+// the entity list, type & draw groups, sceneInfo, the tile layers, cameras & screen positions, the palettes, the rng seed & the whole STG
+// storage pool (which holds the class static vars, the global vars, tile layouts & anything else the objects allocated)
+//
+// Only the latest snapshot is kept as a full image, every older one is stored as the blocks that changed between it & the next one,
+// so capturing every frame only costs as much as what actually changed that frame
+// Restoring rewinds the image through those blocks & drops any snapshot newer than the one restored, much like a rollback would
+//
+// Anything allocated in STG after a snapshot is left alone when restoring it, since whatever points to it may not be part of the snapshot
+// (sprite animations loaded mid-stage for instance), but a defragment would move memory out from under those pointers,
+// so snapshots are dropped whenever STG gets defragmented (which also covers every scene load)
+
+#define SNAPSHOT_COUNT        (0x100)
+#define SNAPSHOT_BLOCK_SIZE   (0x100)
+#define SNAPSHOT_ARENA_SIZE   (0x1000000) // 16MB
+#define SNAPSHOT_REGION_COUNT (0x20)
+
+struct SnapshotRegion {
+    uint8 *data;
+    uint32 size;
+    uint32 offset; // in the image, always block aligned
+};
+
+// the blocks that changed between a snapshot & the one after it, holding the older snapshot's contents
+struct SnapshotRecord {
+    uint32 offset; // into the arena
+    uint32 size;
+    uint32 stgSize; // in bytes
+};
+
+struct SnapshotInfo {
+    // exposed as viewable variables
+    bool32 capture    = false;
+    bool32 restore    = false;
+    bool32 everyFrame = false;
+    bool32 rewind     = false;
+
+    SnapshotRegion regions[SNAPSHOT_REGION_COUNT];
+    int32 regionCount = 0;
+    uint32 fixedSize  = 0; // everything but STG
+
+    uint8 *image      = NULL;
+    uint32 imageSize  = 0;
+    uint8 *arena      = NULL;
+    uint32 arenaUsed  = 0;
+    uint32 stgSize    = 0;
+    uint32 clearCount = 0;
+
+    int32 ids[SNAPSHOT_COUNT];
+    SnapshotRecord records[SNAPSHOT_COUNT]; // records[i] rewinds snapshot i + 1 back to snapshot i
+    int32 count  = 0;
+    int32 nextID = 0;
+
+    // stats from the last capture & restore
+    uint32 lastDeltaSize = 0;
+    uint32 captureTime   = 0; // in microseconds
+    uint32 restoreTime   = 0;
+};
+
+extern SnapshotInfo snapshots;
+
+// returns the new snapshot's id, or -1 if there's nothing to capture
+int32 CaptureSnapshot();
+// rolls the scene back to the snapshot with the given id, dropping any that were captured after it
+bool32 RestoreSnapshot(int32 id);
+// returns the id of the snapshot captured `age` captures ago (0 being the latest), or -1 if it's gone
+int32 GetSnapshotID(int32 age);
+void ClearSnapshots();
+void UpdateSnapshots();
+void ReleaseSnapshots();
+#endif
+
+} // namespace RSDK
+
+#endif // !SNAPSHOT_H
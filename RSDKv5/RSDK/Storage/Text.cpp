@@ -74,6 +74,7 @@ unsigned *md5(unsigned *h, const char *msg, int32 mlen)
         unsigned w[16];
         char b[64];
     } mm;
+#if RETRO_USE_ORIGINAL_CODE
     int32 os = 0;
     int32 grp, grps, q, p;
     unsigned char *msg2;
@@ -100,23 +101,14 @@ unsigned *md5(unsigned *h, const char *msg, int32 mlen)
             //            t = u.b[0]; u.b[0] = u.b[3]; u.b[3] = t;
             //            t = u.b[1]; u.b[1] = u.b[2]; u.b[2] = t;
             q -= 8;
-#if !RETRO_USE_ORIGINAL_CODE
-            for (p = 0; p < 4; ++p) msg2[q + p] = (u.w >> (8 * p)) & 0xFF;
-#else
             // This only works as intended on little-endian CPUs.
             memcpy(msg2 + q, &u.w, 4);
-#endif
         }
     }
 
     for (grp = 0; grp < grps; grp++) {
-#if !RETRO_USE_ORIGINAL_CODE
-        memset(&mm, 0, sizeof(mm));
-        for (p = 0; p < 64; ++p) mm.w[p / 4] |= msg2[os + p] << (8 * (p % 4));
-#else
         // This only works as intended on little-endian CPUs.
         memcpy(mm.b, msg2 + os, 64);
-#endif
         for (q = 0; q < 4; q++) abcd[q] = h[q];
         for (p = 0; p < 4; p++) {
             fctn = ff[p];
@@ -139,6 +131,53 @@ unsigned *md5(unsigned *h, const char *msg, int32 mlen)
 
     if (msg2)
         free(msg2);
+#else
+    int32 grp, grps, q, p;
+
+    if (k == NULL)
+        k = calcKs(kspace);
+
+    for (q = 0; q < 4; q++) h[q] = h0[q]; // initialize
+
+    // whole groups are read straight out of msg, only the padded tail gets copied (onto the stack, rather than mallocing the whole message)
+    int32 fullGrps = mlen / 64;
+    int32 tailLen  = mlen - (fullGrps * 64);
+    int32 tailSize = tailLen + 1 + 8 <= 64 ? 64 : 128;
+    unsigned char tail[128];
+
+    memcpy(tail, msg + (fullGrps * 64), tailLen);
+    tail[tailLen] = (unsigned char)0x80;
+    memset(&tail[tailLen + 1], 0, tailSize - (tailLen + 1));
+
+    uint32 bitCount = 8 * mlen;
+    for (p = 0; p < 4; ++p) tail[tailSize - 8 + p] = (bitCount >> (8 * p)) & 0xFF;
+
+    grps = fullGrps + (tailSize / 64);
+    for (grp = 0; grp < grps; grp++) {
+        const unsigned char *group = grp < fullGrps ? (const unsigned char *)&msg[grp * 64] : &tail[(grp - fullGrps) * 64];
+
+        memset(&mm, 0, sizeof(mm));
+        for (p = 0; p < 64; ++p) mm.w[p / 4] |= group[p] << (8 * (p % 4));
+
+        for (q = 0; q < 4; q++) abcd[q] = h[q];
+        for (p = 0; p < 4; p++) {
+            fctn = ff[p];
+            rotn = rots[p];
+            m    = M[p];
+            o    = O[p];
+            for (q = 0; q < 16; q++) {
+                g = (m * q + o) % 16;
+                f = abcd[1] + rol(abcd[0] + fctn(abcd) + k[q + 16 * p] + mm.w[g], rotn[q % 4]);
+
+                abcd[0] = abcd[3];
+                abcd[3] = abcd[2];
+                abcd[2] = abcd[1];
+                abcd[1] = f;
+            }
+        }
+        for (p = 0; p < 4; p++) h[p] += abcd[p];
+    }
+#endif
 
     return h;
 }
@@ -158,6 +197,84 @@ void RSDK::GenerateHashMD5(uint32 *buffer, char *textBuffer, int32 textBufferLen
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+static NameCacheEntry nameCache[NAMECACHE_SIZE];
+static int32 nameCacheCount = 0;
+static char nameCacheText[NAMECACHE_TEXT_SIZE];
+static uint32 nameCacheTextPos = 0;
+
+void RSDK::GetInternedHashMD5(const char *name, uint32 *hash)
+{
+    // FNV-1a, just to pick a bucket
+    uint32 nameHash = 0x811C9DC5;
+    int32 length    = 0;
+    for (; name[length]; ++length) nameHash = (nameHash ^ (uint8)name[length]) * 0x01000193;
+
+    uint32 id = nameHash & (NAMECACHE_SIZE - 1);
+    for (; nameCache[id].used; id = (id + 1) & (NAMECACHE_SIZE - 1)) {
+        NameCacheEntry *entry = &nameCache[id];
+        if (entry->nameHash == nameHash && entry->length == length && !memcmp(&nameCacheText[entry->textPos], name, length)) {
+            HASH_COPY_MD5(hash, entry->hash);
+            return;
+        }
+    }
+
+    GenerateHashMD5(hash, (char *)name, length);
+
+    // it's only a cache, so once it fills up it just starts over
+    if (nameCacheCount >= NAMECACHE_SIZE * 3 / 4 || nameCacheTextPos + length > NAMECACHE_TEXT_SIZE) {
+        memset(nameCache, 0, sizeof(nameCache));
+        nameCacheCount   = 0;
+        nameCacheTextPos = 0;
+
+        id = nameHash & (NAMECACHE_SIZE - 1);
+    }
+
+    NameCacheEntry *entry = &nameCache[id];
+    entry->nameHash       = nameHash;
+    entry->textPos        = nameCacheTextPos;
+    entry->length         = length;
+    entry->used           = true;
+    HASH_COPY_MD5(entry->hash, hash);
+
+    memcpy(&nameCacheText[nameCacheTextPos], name, length);
+    nameCacheTextPos += length;
+    nameCacheCount++;
+}
+
+int32 RSDK::FindNameMapSlot(NameMap *map, uint32 *hash)
+{
+    for (uint32 id = hash[0] & (NAMEMAP_SIZE - 1); map->entries[id].used; id = (id + 1) & (NAMEMAP_SIZE - 1)) {
+        if (HASH_MATCH_MD5(map->entries[id].hash, hash))
+            return map->entries[id].slot;
+    }
+
+    return -1;
+}
+
+void RSDK::SetNameMapSlot(NameMap *map, uint32 *hash, int32 slot)
+{
+    uint32 id = hash[0] & (NAMEMAP_SIZE - 1);
+    for (; map->entries[id].used; id = (id + 1) & (NAMEMAP_SIZE - 1)) {
+        if (HASH_MATCH_MD5(map->entries[id].hash, hash)) {
+            map->entries[id].slot = slot;
+            return;
+        }
+    }
+
+    // entries are never removed (stale ones just fail the slot check), so start over once it's getting full
+    if (map->count >= NAMEMAP_SIZE * 3 / 4) {
+        ClearNameMap(map);
+        id = hash[0] & (NAMEMAP_SIZE - 1);
+    }
+
+    HASH_COPY_MD5(map->entries[id].hash, hash);
+    map->entries[id].slot = slot;
+    map->entries[id].used = true;
+    map->count++;
+}
+#endif
+
 uint32 crc32_t[256] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
     0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
@@ -200,6 +317,21 @@ void RSDK::GenerateHashCRC(uint32 *id, char *inputString)
     *id = ~*id;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+uint64 RSDK::HashWordsFNV64(uint64 hash, const uint16 *words, int32 count)
+{
+    int32 w = 0;
+    for (; w + 4 <= count; w += 4) {
+        uint64 block;
+        memcpy(&block, &words[w], sizeof(block));
+        hash = HashStepFNV64(hash, block);
+    }
+    for (; w < count; ++w) hash = HashStepFNV64(hash, words[w]);
+
+    return hash;
+}
+#endif
+
 uint8 utf8CharSizes[] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
                           1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
                           1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
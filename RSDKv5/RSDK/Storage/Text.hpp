@@ -139,14 +139,70 @@ void GenerateHashCRC(uint32 *id, char *inputString);
 #define HASH_SIZE_MD5        (4 * sizeof(uint32))
 #define HASH_MATCH_MD5(a, b) (memcmp(a, b, HASH_SIZE_MD5) == 0)
 // this is NOT thread-safe!
+#if RETRO_USE_ORIGINAL_CODE
 #define GEN_HASH_MD5(text, hash)                                                                                                                     \
     strcpy(textBuffer, text);                                                                                                                        \
     GenerateHashMD5(hash, textBuffer, (int32)strlen(textBuffer))
+#else
+#define GEN_HASH_MD5(text, hash)                                                                                                                     \
+    strcpy(textBuffer, text);                                                                                                                        \
+    GetInternedHashMD5(textBuffer, hash)
+#endif
 // this one is but assumes buffer has already been setup
 #define GEN_HASH_MD5_BUFFER(buffer, hash) GenerateHashMD5(hash, buffer, (int32)strlen(buffer))
 #define HASH_COPY_MD5(dst, src) memcpy(dst, src, HASH_SIZE_MD5)
 #define HASH_CLEAR_MD5(hash)    MEM_ZERO(hash)
 
+#if !RETRO_USE_ORIGINAL_CODE
+// FNV-1a (64-bit)
+// Fed a whole value per step instead of a byte, so it's only good for spotting changes in engine-side data (frame buffer rows, parallax
+// scroll positions, captured screens) & won't match anyone else's FNV-1a. Every step is reversible, so two inputs that only differ by a
+// single value can never end up with the same hash
+#define HASH_INIT_FNV64 (0xCBF29CE484222325ULL)
+
+inline uint64 HashStepFNV64(uint64 hash, uint64 value) { return (hash ^ value) * 0x100000001B3ULL; }
+// 4 words per step, with any leftover words going in one at a time
+uint64 HashWordsFNV64(uint64 hash, const uint16 *words, int32 count);
+
+// Interned names
+// Every name that goes through GEN_HASH_MD5 is kept along with its MD5, so asking for the same name again (which objects do constantly
+// in their StageLoads) is a single table lookup instead of another MD5. Like GEN_HASH_MD5 itself, this is main thread only
+#define NAMECACHE_SIZE      (0x1000) // must be a power of 2
+#define NAMECACHE_TEXT_SIZE (0x20000)
+
+struct NameCacheEntry {
+    uint32 nameHash;
+    uint32 textPos;
+    uint16 length;
+    bool32 used;
+    RETRO_HASH_MD5(hash);
+};
+
+void GetInternedHashMD5(const char *name, uint32 *hash);
+
+// Name maps
+// Remember which slot of a resource table a name hash was last found in, so finding something that's already loaded doesn't mean
+// scanning the whole table. Those tables get cleared & reused all over the place though, so a slot has to be checked against the table
+// before it's trusted, & a miss just means falling back to the usual scan
+#define NAMEMAP_SIZE (0x800) // must be a power of 2 & at least twice the size of any table using it
+
+struct NameMapEntry {
+    RETRO_HASH_MD5(hash);
+    int32 slot;
+    bool32 used;
+};
+
+struct NameMap {
+    NameMapEntry entries[NAMEMAP_SIZE];
+    int32 count;
+};
+
+// returns the slot the hash was last seen in, or -1 if it hasn't been seen
+int32 FindNameMapSlot(NameMap *map, uint32 *hash);
+void SetNameMapSlot(NameMap *map, uint32 *hash, int32 slot);
+inline void ClearNameMap(NameMap *map) { memset(map, 0, sizeof(NameMap)); }
+#endif
+
 inline void InitString(String *string, const char *text, uint32 textLength)
 {
     string->length = 0;
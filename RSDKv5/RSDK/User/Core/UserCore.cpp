@@ -332,6 +332,9 @@ void RSDK::LoadSettingsINI()
         customSettings.enableControllerDebugging = iniparser_getboolean(ini, "Game:enableControllerDebugging", false);
         customSettings.disableFocusPause         = iniparser_getboolean(ini, "Game:disableFocusPause", false);
         engine.fastForwardSpeed                  = iniparser_getint(ini, "Game:fastForwardSpeed", 8);
+        inputLatency.lateLatch                   = iniparser_getboolean(ini, "Game:lateInputLatch", false);
+        engine.tempEntityCount =
+            CLAMP(iniparser_getint(ini, "Game:tempEntities", TEMPENTITY_COUNT), TEMPENTITY_COUNT, TEMPENTITY_COUNT_MAX);
 
 #if RETRO_REV0U
         customSettings.forceScripts = iniparser_getboolean(ini, "Game:txtScripts", false);
@@ -378,6 +381,10 @@ void RSDK::LoadSettingsINI()
         engine.streamsEnabled = iniparser_getboolean(ini, "Audio:streamsEnabled", true);
         engine.streamVolume   = (float)iniparser_getdouble(ini, "Audio:streamVolume", 0.8);
         engine.soundFXVolume  = (float)iniparser_getdouble(ini, "Audio:sfxVolume", 1.0);
+#if !RETRO_USE_ORIGINAL_CODE
+        engine.mixedVoiceLimit = CLAMP(iniparser_getint(ini, "Audio:mixedVoices", MIXED_VOICE_DEFAULT), 1, VOICE_COUNT);
+        engine.audioPeriod     = CLAMP(iniparser_getint(ini, "Audio:period", AUDIO_PERIOD_DEFAULT), AUDIO_PERIOD_MIN, AUDIO_PERIOD_MAX);
+#endif
 
         for (int32 i = CONT_P1; i <= PLAYER_COUNT; ++i) {
             char buffer[0x30];
@@ -516,6 +523,10 @@ void RSDK::LoadSettingsINI()
         engine.streamVolume   = 1.0f;
         engine.soundFXVolume  = 1.0f;
         engine.devMenu        = false;
+#if !RETRO_USE_ORIGINAL_CODE
+        engine.mixedVoiceLimit = MIXED_VOICE_DEFAULT;
+        engine.audioPeriod     = AUDIO_PERIOD_DEFAULT;
+#endif
 
 #if !RETRO_USE_ORIGINAL_CODE
         customSettings.region                    = -1;
@@ -523,6 +534,8 @@ void RSDK::LoadSettingsINI()
         customSettings.xyButtonFlip              = false;
         customSettings.enableControllerDebugging = false;
         customSettings.disableFocusPause         = false;
+        inputLatency.lateLatch                   = false;
+        engine.tempEntityCount                   = TEMPENTITY_COUNT;
 
 #if RETRO_REV0U
         customSettings.forceScripts = false;
@@ -620,6 +633,13 @@ void RSDK::SaveSettingsINI(bool32 writeToFile)
             WriteText(file, "; The speed to run the game at while holding backspace. Defaults to x8 speed\n");
             WriteText(file, "fastForwardSpeed=%d\n", engine.fastForwardSpeed);
 
+            WriteText(file, "; Waits until just before each frame is due to read input, cutting down on input latency\n");
+            WriteText(file, "lateInputLatch=%s\n", (inputLatency.lateLatch ? "y" : "n"));
+
+            WriteText(file, "; The number of entity slots CreateEntity can use (%d-%d), anything above %d comes out of unused scene slots\n",
+                      TEMPENTITY_COUNT, TEMPENTITY_COUNT_MAX, TEMPENTITY_COUNT);
+            WriteText(file, "tempEntities=%d\n", engine.tempEntityCount);
+
             if (strcmp(iniparser_getstring(ini, "Game:username", ";unknown;"), ";unknown;") != 0)
                 WriteText(file, "username=%s\n", iniparser_getstring(ini, "Game:username", ""));
 
@@ -681,6 +701,10 @@ void RSDK::SaveSettingsINI(bool32 writeToFile)
         WriteText(file, "streamsEnabled=%s\n", (engine.streamsEnabled ? "y" : "n"));
         WriteText(file, "streamVolume=%f\n", engine.streamVolume);
         WriteText(file, "sfxVolume=%f\n", engine.soundFXVolume);
+#if !RETRO_USE_ORIGINAL_CODE
+        WriteText(file, "mixedVoices=%d\n", engine.mixedVoiceLimit);
+        WriteText(file, "period=%d\n", engine.audioPeriod);
+#endif
 
         // ==========================
         // OPTIONS (decomp only)